@@ -0,0 +1,230 @@
+// Olympe Asset Tool: command line asset pipeline for the Olympe Engine
+//
+//   OlympeAssetTool pack <archive.opak> <file|directory>... [--no-compress] [--align N]
+//       packs the files (directories recursively) into an asset archive. Archive paths are the
+//       paths given on the command line, run the tool from the game folder so that they match
+//       the paths used by the game ("Resources/olympe_logo.png").
+//   OlympeAssetTool list <archive.opak>
+//       lists the entries of an archive
+//   OlympeAssetTool cook <image|directory>... [--force]
+//       decodes the images once and writes "<image>.otex" next to them (CookedTexture.h),
+//       images older than their cooked file are skipped unless --force is given. "pack"
+//       leaves out the source images whose cooked file is packed.
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_set>
+#include <fstream>
+#include "AssetArchive.h"
+#include "CookedTexture.h"
+#include "sdl3_image/sdl_image.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+namespace
+{
+    bool IsDirectory(const std::string& path)
+    {
+#ifdef _WIN32
+        const DWORD attr = GetFileAttributesA(path.c_str());
+        return attr != INVALID_FILE_ATTRIBUTES && (attr & FILE_ATTRIBUTE_DIRECTORY);
+#else
+        struct stat st;
+        return stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+#endif
+    }
+
+    // last write time, 0 if the file doesn't exist
+    uint64_t FileTime(const std::string& path)
+    {
+#ifdef _WIN32
+        WIN32_FILE_ATTRIBUTE_DATA data;
+        if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &data)) return 0;
+        return (static_cast<uint64_t>(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime;
+#else
+        struct stat st;
+        return (stat(path.c_str(), &st) == 0) ? static_cast<uint64_t>(st.st_mtime) : 0;
+#endif
+    }
+
+    bool IsImage(const std::string& path)
+    {
+        static const char* const extensions[] = { ".png", ".jpg", ".jpeg", ".bmp", ".tga", ".gif", ".webp" };
+        for (const char* ext : extensions)
+        {
+            const size_t n = std::strlen(ext);
+            if (path.size() > n && AssetArchive::NormalizePath(path.substr(path.size() - n)) == ext) return true;
+        }
+        return false;
+    }
+
+    // appends the files of 'dir' and its sub directories
+    void ListFiles(const std::string& dir, std::vector<std::string>& out)
+    {
+#ifdef _WIN32
+        WIN32_FIND_DATAA fd;
+        HANDLE h = FindFirstFileA((dir + "/*").c_str(), &fd);
+        if (h == INVALID_HANDLE_VALUE) return;
+        do
+        {
+            const std::string name = fd.cFileName;
+            if (name == "." || name == "..") continue;
+            const std::string path = dir + "/" + name;
+            if (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) ListFiles(path, out);
+            else out.push_back(path);
+        } while (FindNextFileA(h, &fd));
+        FindClose(h);
+#else
+        DIR* d = opendir(dir.c_str());
+        if (!d) return;
+        while (dirent* e = readdir(d))
+        {
+            const std::string name = e->d_name;
+            if (name == "." || name == "..") continue;
+            const std::string path = dir + "/" + name;
+            if (IsDirectory(path)) ListFiles(path, out);
+            else out.push_back(path);
+        }
+        closedir(d);
+#endif
+    }
+
+    int Usage()
+    {
+        std::cout << "usage:\n"
+            << "  OlympeAssetTool pack <archive.opak> <file|directory>... [--no-compress] [--align N]\n"
+            << "  OlympeAssetTool list <archive.opak>\n"
+            << "  OlympeAssetTool cook <image|directory>... [--force]\n";
+        return 1;
+    }
+
+    int Pack(int argc, char** argv)
+    {
+        if (argc < 4) return Usage();
+        const std::string output = argv[2];
+
+        AssetArchiveWriter writer;
+        std::vector<std::string> files;
+        for (int i = 3; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--no-compress") writer.SetCompression(false);
+            else if (arg == "--align" && i + 1 < argc) writer.SetAlignment(static_cast<uint32_t>(std::atoi(argv[++i])));
+            else if (IsDirectory(arg)) ListFiles(arg.back() == '/' || arg.back() == '\\' ? arg.substr(0, arg.size() - 1) : arg, files);
+            else files.push_back(arg);
+        }
+
+        // the engine loads the cooked version of an image when there is one: the source is not needed
+        std::unordered_set<std::string> cooked;
+        for (const std::string& f : files)
+        {
+            if (CookedTexture::IsCookedPath(f)) cooked.insert(AssetArchive::NormalizePath(f));
+        }
+        size_t skippedSources = 0;
+        for (const std::string& f : files)
+        {
+            if (cooked.count(AssetArchive::NormalizePath(CookedTexture::GetCookedPath(f))))
+            {
+                ++skippedSources;
+                continue;
+            }
+            if (!writer.AddFile(f, f)) std::cout << "skipped duplicate '" << f << "'\n";
+        }
+        if (skippedSources > 0) std::cout << "left out " << skippedSources << " source images (cooked)\n";
+        if (!writer.Write(output))
+        {
+            std::cerr << "error: " << writer.GetLastError() << "\n";
+            return 2;
+        }
+        std::cout << "packed " << writer.GetEntryCount() << " files into '" << output << "': "
+            << writer.GetTotalSize() << " -> " << writer.GetStoredSize() << " bytes ("
+            << writer.GetCompressedCount() << " LZ4 compressed)\n";
+        return 0;
+    }
+
+    int Cook(int argc, char** argv)
+    {
+        if (argc < 3) return Usage();
+        bool force = false;
+        std::vector<std::string> files;
+        for (int i = 2; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--force") force = true;
+            else if (IsDirectory(arg)) ListFiles(arg.back() == '/' || arg.back() == '\\' ? arg.substr(0, arg.size() - 1) : arg, files);
+            else files.push_back(arg);
+        }
+
+        size_t cookedCount = 0, upToDate = 0, failed = 0;
+        std::vector<uint8_t> blob;
+        for (const std::string& f : files)
+        {
+            if (!IsImage(f)) continue;
+            const std::string output = CookedTexture::GetCookedPath(f);
+            if (!force && FileTime(output) > FileTime(f))
+            {
+                ++upToDate;
+                continue;
+            }
+
+            SDL_Surface* surf = IMG_Load(f.c_str());
+            if (!surf || !CookedTexture::Cook(surf, blob))
+            {
+                std::cerr << "error: '" << f << "': " << SDL_GetError() << "\n";
+                if (surf) SDL_DestroySurface(surf);
+                ++failed;
+                continue;
+            }
+            SDL_DestroySurface(surf);
+
+            std::ofstream out(output.c_str(), std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+            if (!out.good())
+            {
+                std::cerr << "error: cannot write '" << output << "'\n";
+                ++failed;
+                continue;
+            }
+            ++cookedCount;
+        }
+        std::cout << "cooked " << cookedCount << " images (" << upToDate << " up to date, " << failed << " failed)\n";
+        return failed ? 2 : 0;
+    }
+
+    int List(int argc, char** argv)
+    {
+        if (argc < 3) return Usage();
+        AssetArchive archive;
+        if (!archive.Open(argv[2]))
+        {
+            std::cerr << "error: '" << argv[2] << "': " << archive.GetLastError() << "\n";
+            return 2;
+        }
+        for (size_t i = 0; i < archive.GetEntryCount(); ++i)
+        {
+            const ArchiveEntry* e = archive.GetEntry(i);
+            std::cout << archive.GetEntryName(*e) << "  " << e->size << " bytes"
+                << ((e->flags & ArchiveEntry_LZ4) ? " (lz4 " + std::to_string(e->storedSize) + ")" : std::string()) << "\n";
+        }
+        std::cout << archive.GetEntryCount() << " entries\n";
+        return 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) return Usage();
+    const std::string command = argv[1];
+    if (command == "pack") return Pack(argc, argv);
+    if (command == "list") return List(argc, argv);
+    if (command == "cook") return Cook(argc, argv);
+    return Usage();
+}
@@ -4,6 +4,9 @@
 #include "AI_Npc.h"
 #include "GameObject.h"
 #include "ObjectFactory.h"
+#include "FlowField.h"
+#include "World.h"
+#include <SDL3/SDL_stdinc.h>
 
 
 bool AI_Npc::FactoryRegistered = ObjectFactory::Get().Register("AI_Npc", AI_Npc::Create);
@@ -20,6 +23,7 @@ AI_Npc::AI_Npc()
 
 AI_Npc::~AI_Npc()
 {
+	Stop();
 }
 
 void AI_Npc::SetOwner(Object* _owner)
@@ -29,8 +33,171 @@ void AI_Npc::SetOwner(Object* _owner)
 		SYSTEM_LOG << "Error AI_Npc::SetOwner called with null owner!\n";
 		return;
 	}
-	owner = _owner;
+	AIComponent::SetOwner(_owner);
+}
+
+void AI_Npc::MoveTo(const Vector& target)
+{
+	if (!gao) return;
+	Stop();
+	m_pathRequest = PathfindingManager::Get().RequestPath(gao->GetPosition(), target);
+}
+
+void AI_Npc::Chase(GameObject* target)
+{
+	Stop();
+	m_chaseTargetUid = target ? target->GetUID() : 0;
+	if (target) m_lastTargetPos = target->GetPosition();
+	m_currentState = target ? State::Chasing : State::Idle;
+}
 
+void AI_Npc::UpdatePatrol()
+{
+	if (!m_hasHome)
+	{
+		m_home = gao->GetPosition();
+		m_hasHome = true;
+	}
+	if (IsMoving()) return;
+	if (m_patrolWait > 0.0f)
+	{
+		m_patrolWait -= fDt;
+		return;
+	}
+	// next patrol point around home; unreachable points (walls, no map) just wait for the next one
+	const float angle = SDL_randf() * 2.0f * SDL_PI_F;
+	const float dist = SDL_randf() * m_patrolRadius;
+	MoveTo(Vector(m_home.x + SDL_cosf(angle) * dist, m_home.y + SDL_sinf(angle) * dist, 0.0f));
+	m_currentState = State::Patrolling;
+	m_patrolWait = 1.0f + SDL_randf() * 2.0f;
+}
+
+void AI_Npc::UpdateDetection()
+{
+	// a few scans per second are enough
+	m_detectionTimer -= fDt;
+	if (m_detectionTimer > 0.0f) return;
+	m_detectionTimer = 0.25f;
+
+	GameObject* closest = nullptr;
+	float closestDist = m_detectionRadius;
+	const Vector pos = gao->GetPosition();
+	for (GameObject* go : World::Get().GetPlayers())
+	{
+		const Vector p = go->GetPosition();
+		const float dist = Vector(p.x - pos.x, p.y - pos.y, 0.0f).Norm();
+		if (dist < closestDist)
+		{
+			closest = go;
+			closestDist = dist;
+		}
+	}
+	if (closest && closest->GetUID() != m_chaseTargetUid) Chase(closest);
+}
+
+void AI_Npc::Stop()
+{
+	m_chaseTargetUid = 0;
+	if (m_pathRequest != INVALID_PATH_REQUEST)
+	{
+		PathfindingManager::Get().ReleaseRequest(m_pathRequest);
+		m_pathRequest = INVALID_PATH_REQUEST;
+	}
+	m_path.reset();
+	m_waypoint = 0;
+}
+
+void AI_Npc::Process()
+{
+	if (!gao) return;
+	if (m_currentState == State::Idle || m_currentState == State::Patrolling)
+	{
+		UpdateDetection();
+		if (m_currentState != State::Chasing) UpdatePatrol();
+	}
+
+	// chasing: one flow field per target shared by all the chasers, one cell sampled per frame
+	if (m_chaseTargetUid != 0)
+	{
+		GameObject* target = dynamic_cast<GameObject*>(World::Get().GetObjectByUID(m_chaseTargetUid));
+		if (!target)
+		{
+			// target destroyed: nobody chases it anymore, go and look where it was last seen
+			FlowFieldManager::Get().ReleaseGoal(m_chaseTargetUid);
+			MoveTo(m_lastTargetPos);
+			m_currentState = State::Idle;
+			return;
+		}
+		m_lastTargetPos = target->GetPosition();
+		Vector pos = gao->GetPosition();
+		Vector toTarget(m_lastTargetPos.x - pos.x, m_lastTargetPos.y - pos.y, 0.0f);
+		const float dist = toTarget.Norm();
+		if (dist > m_loseRadius)
+		{
+			// out of range: the field is released by FlowFieldManager once nobody samples it
+			Stop();
+			m_currentState = State::Idle;
+			return;
+		}
+		// a closer player takes over
+		UpdateDetection();
+		if (m_chaseTargetUid != target->GetUID()) return;
+
+		FlowFieldManager::Get().SetGoal(m_chaseTargetUid, m_lastTargetPos);
+		Vector dir;
+		if (!FlowFieldManager::Get().SampleDirection(m_chaseTargetUid, pos, dir))
+		{
+			// no field yet (first build, no map) or unreachable cell: straight at the target
+			dir = (dist > m_arrivalRadius) ? toTarget * (1.0f / dist) : Vector(0.0f, 0.0f, 0.0f);
+		}
+		pos += dir * (m_speed * fDt);
+		gao->SetPosition(pos);
+		return;
+	}
+
+	// poll the pending path request (completed asynchronously by PathfindingManager)
+	if (m_pathRequest != INVALID_PATH_REQUEST)
+	{
+		PathPtr path;
+		PathStatus status = PathfindingManager::Get().GetPathResult(m_pathRequest, path);
+		if (status == PathStatus::Pending) return;
+
+		PathfindingManager::Get().ReleaseRequest(m_pathRequest);
+		m_pathRequest = INVALID_PATH_REQUEST;
+		m_path = (status == PathStatus::Found) ? path : nullptr;
+		m_waypoint = (m_path && m_path->size() > 1) ? 1 : 0; // waypoint 0 is the start cell
+		if (!m_path && m_currentState != State::Patrolling) m_currentState = State::Idle;
+	}
+
+	if (!m_path) return;
+
+	// follow the waypoints
+	Vector pos = gao->GetPosition();
+	float step = m_speed * fDt;
+	while (m_waypoint < m_path->size())
+	{
+		const SDL_FPoint& wp = (*m_path)[m_waypoint];
+		Vector toTarget(wp.x - pos.x, wp.y - pos.y, 0.0f);
+		float dist = toTarget.Norm();
+		if (dist <= m_arrivalRadius || dist <= step)
+		{
+			pos.x = wp.x;
+			pos.y = wp.y;
+			step = (step > dist) ? step - dist : 0.0f;
+			++m_waypoint;
+			continue;
+		}
+		if (step > 0.0f) pos += toTarget * (step / dist);
+		break;
+	}
+	gao->SetPosition(pos);
+
+	if (m_waypoint >= m_path->size())
+	{
+		m_path.reset();
+		m_waypoint = 0;
+		if (m_currentState != State::Patrolling) m_currentState = State::Idle;
+	}
 }
 
 void AI_Npc::OnEvent(const Message& msg)
@@ -1,6 +1,9 @@
 #pragma once
 #include "ObjectComponent.h"
 #include "system/EventManager.h"
+#include "Pathfinding.h"
+
+class GameObject;
 #include <SDL3/SDL.h>
 #include <mutex>
 // AI_Npc: component that implements basic NPC behavior (e.g., patrolling)
@@ -13,8 +16,15 @@ class AI_Npc : public AIComponent
 	virtual ~AI_Npc() override;
 	virtual void SetOwner(Object* _owner) override;
 	// AI properties participate in the AI stage (AIComponent already does this)
-	virtual void Process() override {}
+	virtual void Process() override;
 	virtual void OnEvent(const Message& msg) override;
+
+	// Navigation: request a path to a world position (async, see PathfindingManager)
+	void MoveTo(const Vector& target);
+	// Chase a moving target using the flow field shared by every NPC chasing it (see FlowFieldManager)
+	void Chase(GameObject* target);
+	void Stop();
+	bool IsMoving() const { return m_pathRequest != INVALID_PATH_REQUEST || m_path != nullptr || m_chaseTargetUid != 0; }
 private:
 	// NPC behavior state
 	enum class State
@@ -26,4 +36,26 @@ private:
 	};
 	State m_currentState = State::Idle;
 	std::mutex m_mutex;
+
+	// patrol: wander around the spawn position, waiting between two moves
+	void UpdatePatrol();
+	// players closer than the detection radius are chased (the closest one, also while chasing)
+	void UpdateDetection();
+	bool m_hasHome = false;
+	Vector m_home;
+	float m_patrolRadius = 160.0f;
+	float m_patrolWait = 0.0f;
+	float m_detectionRadius = 256.0f;
+	float m_loseRadius = 384.0f; // a chased target further than this is lost: back to the patrol
+	float m_detectionTimer = 0.0f;
+
+	// navigation state
+	PathRequestID m_pathRequest = INVALID_PATH_REQUEST;
+	PathPtr m_path;
+	size_t m_waypoint = 0;
+	// chased object, looked up by UID each frame: the target can be destroyed while chased
+	uint64_t m_chaseTargetUid = 0;
+	Vector m_lastTargetPos;
+	float m_speed = 120.0f;
+	float m_arrivalRadius = 4.0f;
 };
@@ -8,7 +8,7 @@
 #include "InputsManager.h"
 #include "VideoGame.h"
 #include "Player.h"
-#include "drawing.h"
+#include "DebugDraw.h"
 
 using namespace std;
 using EM = EventManager;
@@ -22,18 +22,7 @@ ObjectComponent* AI_Player::Create()
 
 AI_Player::AI_Player()
 {
-    // Register to input-related events
-    EM::Get().Register(this, EventType::Olympe_EventType_Joystick_AxisMotion);
-    EM::Get().Register(this, EventType::Olympe_EventType_Joystick_ButtonDown);
-    EM::Get().Register(this, EventType::Olympe_EventType_Joystick_ButtonUp);
-    EM::Get().Register(this, EventType::Olympe_EventType_Joystick_Disconnected);
-    EM::Get().Register(this, EventType::Olympe_EventType_Joystick_Connected);
-
-    EM::Get().Register(this, EventType::Olympe_EventType_Keyboard_KeyDown);
-    EM::Get().Register(this, EventType::Olympe_EventType_Keyboard_KeyUp);	
-	EM::Get().Register(this, EventType::Olympe_EventType_Keyboard_Disconnected);
-	EM::Get().Register(this, EventType::Olympe_EventType_Keyboard_Connected);
-
+    // input events are registered by UpdateInputRoutes() once the controller is bound
 }
 void AI_Player::Initialize()
 {
@@ -51,12 +40,33 @@ void AI_Player::Initialize()
     {
 		SYSTEM_LOG << "Error: AI_Player creation failed to bind any inputs for PlayerID=" << ((Player*)gao)->m_PlayerID << endl;
     }
+    UpdateInputRoutes();
+}
+
+void AI_Player::UpdateInputRoutes()
+{
+    const int controllerID = ((Player*)gao)->m_ControllerID;
+    if (m_inputsRouted && controllerID == m_routedControllerID) return;
+    m_inputsRouted = true;
+    m_routedControllerID = controllerID;
+
+    // Register to input-related events of our controller only (routed by device): the inputs
+    // of the other players never reach this instance. Typed channels for the hot ones.
+    EM::Get().UnregisterAll(this);
+    const uint64_t device = GetDeviceRouteKey(controllerID);
+    EventChannel<JoystickAxisEvent>::Get().SubscribeRouted<AI_Player, &AI_Player::OnJoystickAxisEvent>(this, &JoystickAxisEvent::RouteByDevice, device);
+    EventChannel<KeyboardEvent>::Get().SubscribeRouted<AI_Player, &AI_Player::OnKeyboardEvent>(this, &KeyboardEvent::RouteByDevice, device);
+
+    EM::Get().RegisterForDevice(this, EventType::Olympe_EventType_Joystick_Disconnected, controllerID);
+    EM::Get().RegisterForDevice(this, EventType::Olympe_EventType_Joystick_Connected, controllerID);
+    EM::Get().RegisterForDevice(this, EventType::Olympe_EventType_Keyboard_Disconnected, controllerID);
+    EM::Get().RegisterForDevice(this, EventType::Olympe_EventType_Keyboard_Connected, controllerID);
 }
 
 AI_Player::~AI_Player()
 {
 	VideoGame::m_playerIdCounter--;
-    // Unregister all callbacks associated with this instance
+    // Unregister all callbacks associated with this instance (typed channels included)
     EventManager::Get().UnregisterAll(this);
 }
 
@@ -67,19 +77,23 @@ void AI_Player::SetOwner ( Object *_owner)
 
 void AI_Player::RenderDebug()
 {
-
-    SDL_SetRenderDrawColor(GameEngine::renderer, m_debugcolor.r, m_debugcolor.g, m_debugcolor.b, SDL_ALPHA_OPAQUE);
-    Vector vRenderPos = gao->GetPosition() - CameraManager::Get().GetCameraPositionForActivePlayer();
-	Draw_FilledCircle(GameEngine::renderer, (int)vRenderPos.x, (int)vRenderPos.y, 5);
-    //gao->boundingBox = { gao->position.x, gao->position.y, gao->width, gao->height };
-	SDL_FRect box = gao->GetBoundingBox();
-    SDL_RenderRect(GameEngine::renderer, &box);/**/
-
+    DebugDraw& dd = DebugDraw::Get();
+    if (!dd.IsEnabled()) return;
+
+    const SDL_Color color = { m_debugcolor.r, m_debugcolor.g, m_debugcolor.b, SDL_ALPHA_OPAQUE };
+    const Vector vPos = gao->GetPosition();
+    const Vector vRenderPos = CameraManager::Get().WorldToRender(vPos);
+    dd.FilledCircle(vRenderPos.x, vRenderPos.y, 5.0f, color);
+	float _w, _h;
+	gao->GetSize(_w, _h);
+    dd.Rect(CameraManager::Get().WorldToRender(SDL_FRect{ vPos.x, vPos.y, _w, _h }), color);
 }
 
 
 void AI_Player::Process()
 {
+    UpdateInputRoutes(); // follows the InputsManager rebinding
+
     std::lock_guard<std::mutex> lock(m_mutex);
 
     float vx = 0.0f;
@@ -135,70 +149,6 @@ void AI_Player::OnEvent(const Message& msg)
 
             switch (msg.msg_type)
             {
-
-            case EventType::Olympe_EventType_Joystick_AxisMotion:
-            {
-                // controlId = axis index, value = normalized [-1..1]
-                if (msg.controlId == 0)
-                    m_axisX = msg.param1;
-                else if (msg.controlId == 1)
-                    m_axisY = msg.param1;
-                break;
-            }
-
-            case EventType::Olympe_EventType_Joystick_ButtonDown:
-            case EventType::Olympe_EventType_Joystick_ButtonUp:
-            {
-                // optionally map buttons to movement (e.g. dpad) if desired
-                // msg.controlId is button index, msg.state 1=down 0=up
-                // Not implemented here.
-                break;
-            }
-
-            case EventType::Olympe_EventType_Keyboard_KeyDown:
-            {
-                // msg.controlId contains SDL_Scancode
-                switch (static_cast<SDL_Scancode>(msg.controlId))
-                {
-                case SDL_SCANCODE_Z:
-                case SDL_SCANCODE_UP:
-                    m_keyUp = true; break;
-                case SDL_SCANCODE_S:
-                case SDL_SCANCODE_DOWN:
-                    m_keyDown = true; break;
-                case SDL_SCANCODE_Q:
-                case SDL_SCANCODE_LEFT:
-                    m_keyLeft = true; break;
-                case SDL_SCANCODE_D:
-                case SDL_SCANCODE_RIGHT:
-                    m_keyRight = true; break;
-                default:
-                    break;
-                }
-                break;
-            }
-
-            case EventType::Olympe_EventType_Keyboard_KeyUp:
-            {
-                switch (static_cast<SDL_Scancode>(msg.controlId))
-                {
-                case SDL_SCANCODE_W:
-                case SDL_SCANCODE_UP:
-                    m_keyUp = false; break;
-                case SDL_SCANCODE_S:
-                case SDL_SCANCODE_DOWN:
-                    m_keyDown = false; break;
-                case SDL_SCANCODE_A:
-                case SDL_SCANCODE_LEFT:
-                    m_keyLeft = false; break;
-                case SDL_SCANCODE_D:
-                case SDL_SCANCODE_RIGHT:
-                    m_keyRight = false; break;
-                default:
-                    break;
-                }
-                break;
-            }
             case EventType::Olympe_EventType_Joystick_Disconnected:
             {
 				SYSTEM_LOG << "AI_Player: Controller disconnected for GameObject: " << name << endl;
@@ -232,3 +182,57 @@ void AI_Player::OnEvent(const Message& msg)
         }
     }
 }
+
+// routed: events of our controller only
+void AI_Player::OnJoystickAxisEvent(const JoystickAxisEvent& ev)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (ev.axis == 0)
+        m_axisX = ev.value;
+    else if (ev.axis == 1)
+        m_axisY = ev.value;
+}
+
+void AI_Player::OnKeyboardEvent(const KeyboardEvent& ev)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (ev.down)
+    {
+        switch (ev.scancode)
+        {
+        case SDL_SCANCODE_Z:
+        case SDL_SCANCODE_UP:
+            m_keyUp = true; break;
+        case SDL_SCANCODE_S:
+        case SDL_SCANCODE_DOWN:
+            m_keyDown = true; break;
+        case SDL_SCANCODE_Q:
+        case SDL_SCANCODE_LEFT:
+            m_keyLeft = true; break;
+        case SDL_SCANCODE_D:
+        case SDL_SCANCODE_RIGHT:
+            m_keyRight = true; break;
+        default:
+            break;
+        }
+        return;
+    }
+
+    switch (ev.scancode)
+    {
+    case SDL_SCANCODE_W:
+    case SDL_SCANCODE_UP:
+        m_keyUp = false; break;
+    case SDL_SCANCODE_S:
+    case SDL_SCANCODE_DOWN:
+        m_keyDown = false; break;
+    case SDL_SCANCODE_A:
+    case SDL_SCANCODE_LEFT:
+        m_keyLeft = false; break;
+    case SDL_SCANCODE_D:
+    case SDL_SCANCODE_RIGHT:
+        m_keyRight = false; break;
+    default:
+        break;
+    }
+}
@@ -23,9 +23,18 @@ public:
 
     // AI properties participate in the AI stage (AIProperty already does this)
     virtual void Process() override;
-    virtual void OnEvent(const Message& msg) override;
+    virtual void OnEvent(const Message& msg) override; // controllers connection
+
+    // typed input channels (EventChannel<T>), called by EventManager::Process()
+    void OnKeyboardEvent(const KeyboardEvent& ev);
+    void OnJoystickAxisEvent(const JoystickAxisEvent& ev);
 
 private:
+    // input subscriptions routed to the bound controller, redone when the binding changes
+    void UpdateInputRoutes();
+    bool m_inputsRouted = false;
+    int m_routedControllerID = -1;
+
 	SDL_Color m_debugcolor = { 0, 255, 0, 255 };
 
     float m_speed = 250.0f; // for tests to be removed
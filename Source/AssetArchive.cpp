@@ -0,0 +1,319 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- Implementation of AssetArchive (memory mapped reader) and
+  AssetArchiveWriter.
+*/
+
+#include "AssetArchive.h"
+#include "system/Symbol.h"
+#include "system/Lz4.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    bool EntryLess(const ArchiveEntry& a, uint32_t hash, const char* names, const std::string& name)
+    {
+        if (a.hash != hash) return a.hash < hash;
+        return std::strcmp(names + a.nameOffset, name.c_str()) < 0;
+    }
+}
+
+//-------------------------------------------------------------
+AssetArchive::~AssetArchive()
+{
+    Close();
+}
+//-------------------------------------------------------------
+std::string AssetArchive::NormalizePath(const std::string& path)
+{
+    std::string p = path;
+    for (char& c : p)
+    {
+        if (c == '\\') c = '/';
+        else if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+    }
+    while (p.size() > 2 && p[0] == '.' && p[1] == '/') p.erase(0, 2);
+    return p;
+}
+//-------------------------------------------------------------
+uint32_t AssetArchive::HashPath(const std::string& normalizedPath)
+{
+    return OlympeHashFNV1a(normalizedPath.data(), normalizedPath.size());
+}
+//-------------------------------------------------------------
+bool AssetArchive::Fail(const std::string& error)
+{
+    m_lastError = error;
+    Close();
+    return false;
+}
+//-------------------------------------------------------------
+bool AssetArchive::Open(const std::string& path)
+{
+    Close();
+    m_path = path;
+    m_lastError.clear();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return Fail("cannot open file");
+    m_file = file;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) return Fail("cannot read file size");
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) return Fail("cannot map file");
+    m_mapping = mapping;
+    m_data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!m_data) return Fail("cannot map file");
+    m_size = static_cast<size_t>(size.QuadPart);
+#else
+    m_fd = open(path.c_str(), O_RDONLY);
+    if (m_fd < 0) return Fail("cannot open file");
+    struct stat st;
+    if (fstat(m_fd, &st) != 0 || st.st_size == 0) return Fail("cannot read file size");
+    void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (p == MAP_FAILED) return Fail("cannot map file");
+    m_data = static_cast<const uint8_t*>(p);
+    m_size = static_cast<size_t>(st.st_size);
+#endif
+
+    // validate the header and the tables, entries are checked when read
+    if (m_size < sizeof(ArchiveHeader)) return Fail("file too small");
+    ArchiveHeader header;
+    std::memcpy(&header, m_data, sizeof(header));
+    if (std::memcmp(header.magic, k_ASSET_ARCHIVE_MAGIC, 4) != 0) return Fail("not an asset archive");
+    if (header.version != k_ASSET_ARCHIVE_VERSION) return Fail("unsupported archive version");
+    if (header.indexOffset % alignof(ArchiveEntry) != 0 || header.indexOffset > m_size
+        || static_cast<uint64_t>(header.entryCount) * sizeof(ArchiveEntry) > m_size - header.indexOffset
+        || header.namesOffset > m_size || header.namesOffset < header.indexOffset + static_cast<uint64_t>(header.entryCount) * sizeof(ArchiveEntry))
+        return Fail("corrupted index");
+    if (header.entryCount > 0 && m_data[m_size - 1] != '\0') return Fail("corrupted names");
+
+    m_entries = reinterpret_cast<const ArchiveEntry*>(m_data + header.indexOffset);
+    m_entryCount = header.entryCount;
+    m_names = reinterpret_cast<const char*>(m_data + header.namesOffset);
+    const size_t namesSize = m_size - static_cast<size_t>(header.namesOffset);
+    for (size_t i = 0; i < m_entryCount; ++i)
+    {
+        if (m_entries[i].nameOffset >= namesSize) return Fail("corrupted names");
+    }
+    return true;
+}
+//-------------------------------------------------------------
+void AssetArchive::Close()
+{
+#ifdef _WIN32
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle(static_cast<HANDLE>(m_mapping));
+    if (m_file) CloseHandle(static_cast<HANDLE>(m_file));
+    m_mapping = nullptr;
+    m_file = nullptr;
+#else
+    if (m_data) munmap(const_cast<uint8_t*>(m_data), m_size);
+    if (m_fd >= 0) close(m_fd);
+    m_fd = -1;
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_entries = nullptr;
+    m_entryCount = 0;
+    m_names = nullptr;
+}
+//-------------------------------------------------------------
+const ArchiveEntry* AssetArchive::Find(const std::string& path) const
+{
+    if (!m_entries) return nullptr;
+    const std::string name = NormalizePath(path);
+    const uint32_t hash = HashPath(name);
+
+    // binary search in place: entries are sorted by (hash, name)
+    size_t lo = 0, hi = m_entryCount;
+    while (lo < hi)
+    {
+        const size_t mid = (lo + hi) / 2;
+        if (EntryLess(m_entries[mid], hash, m_names, name)) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo < m_entryCount && m_entries[lo].hash == hash && name == GetEntryName(m_entries[lo])) return &m_entries[lo];
+    return nullptr;
+}
+//-------------------------------------------------------------
+bool AssetArchive::Read(const ArchiveEntry& e, const uint8_t*& outData, size_t& outSize, std::vector<uint8_t>& buffer) const
+{
+    if (!m_data || e.offset > m_size || e.storedSize > m_size - e.offset) return false;
+    const uint8_t* stored = m_data + e.offset;
+
+    if (!(e.flags & ArchiveEntry_LZ4))
+    {
+        if (e.storedSize != e.size) return false;
+        outData = stored;
+        outSize = e.size;
+        return true;
+    }
+
+    buffer.resize(e.size);
+    if (!Lz4::Decompress(stored, e.storedSize, buffer.data(), e.size)) return false;
+    outData = buffer.data();
+    outSize = e.size;
+    return true;
+}
+
+//=============================================================
+// AssetArchiveWriter
+//=============================================================
+bool AssetArchiveWriter::AddFile(const std::string& archivePath, const std::string& diskPath)
+{
+    Pending p;
+    p.name = AssetArchive::NormalizePath(archivePath);
+    if (!m_names.insert(p.name).second) return false;
+    p.diskPath = diskPath;
+    m_pending.push_back(std::move(p));
+    return true;
+}
+//-------------------------------------------------------------
+bool AssetArchiveWriter::AddData(const std::string& archivePath, const void* data, size_t size)
+{
+    Pending p;
+    p.name = AssetArchive::NormalizePath(archivePath);
+    if (!m_names.insert(p.name).second) return false;
+    p.data.assign(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+    m_pending.push_back(std::move(p));
+    return true;
+}
+//-------------------------------------------------------------
+bool AssetArchiveWriter::Write(const std::string& outPath)
+{
+    m_lastError.clear();
+    m_totalSize = m_storedSize = 0;
+    m_compressedCount = 0;
+
+    std::ofstream out(outPath.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        m_lastError = "cannot create '" + outPath + "'";
+        return false;
+    }
+
+    ArchiveHeader header;
+    std::memcpy(header.magic, k_ASSET_ARCHIVE_MAGIC, 4);
+    header.version = k_ASSET_ARCHIVE_VERSION;
+    header.entryCount = static_cast<uint32_t>(m_pending.size());
+    header.alignment = m_alignment;
+    header.indexOffset = header.namesOffset = 0;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header)); // patched at the end
+
+    std::vector<ArchiveEntry> entries;
+    entries.reserve(m_pending.size());
+    std::string names;
+    std::vector<uint8_t> fileData, packed;
+    uint64_t pos = sizeof(header);
+    const char zeros[64] = {};
+
+    auto pad = [&](uint64_t alignment)
+    {
+        uint64_t n = (alignment - (pos % alignment)) % alignment;
+        while (n > 0)
+        {
+            const uint64_t chunk = std::min<uint64_t>(n, sizeof(zeros));
+            out.write(zeros, static_cast<std::streamsize>(chunk));
+            pos += chunk;
+            n -= chunk;
+        }
+    };
+
+    for (Pending& p : m_pending)
+    {
+        const std::vector<uint8_t>* content = &p.data;
+        if (!p.diskPath.empty())
+        {
+            std::ifstream in(p.diskPath.c_str(), std::ios::binary);
+            if (!in)
+            {
+                m_lastError = "cannot read '" + p.diskPath + "'";
+                return false;
+            }
+            fileData.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            content = &fileData;
+        }
+        if (content->size() > 0xFFFFFFFFu)
+        {
+            m_lastError = "file too big '" + p.name + "'";
+            return false;
+        }
+
+        ArchiveEntry e;
+        e.hash = AssetArchive::HashPath(p.name);
+        e.nameOffset = static_cast<uint32_t>(names.size());
+        e.size = static_cast<uint32_t>(content->size());
+        e.flags = ArchiveEntry_None;
+        e.reserved = 0;
+        names.append(p.name);
+        names.push_back('\0');
+
+        const uint8_t* stored = content->data();
+        size_t storedSize = content->size();
+        if (m_compress && storedSize > 64)
+        {
+            packed.resize(Lz4::CompressBound(storedSize));
+            const size_t n = Lz4::Compress(content->data(), content->size(), packed.data(), packed.size());
+            if (n > 0 && static_cast<float>(n) <= static_cast<float>(storedSize) * m_maxRatio)
+            {
+                stored = packed.data();
+                storedSize = n;
+                e.flags |= ArchiveEntry_LZ4;
+                ++m_compressedCount;
+            }
+        }
+
+        pad(m_alignment);
+        e.offset = pos;
+        e.storedSize = static_cast<uint32_t>(storedSize);
+        out.write(reinterpret_cast<const char*>(stored), static_cast<std::streamsize>(storedSize));
+        pos += storedSize;
+        m_totalSize += e.size;
+        m_storedSize += storedSize;
+        entries.push_back(e);
+
+        if (!p.diskPath.empty()) std::vector<uint8_t>().swap(fileData);
+    }
+
+    // index sorted for the binary search of AssetArchive::Find
+    std::sort(entries.begin(), entries.end(), [&names](const ArchiveEntry& a, const ArchiveEntry& b)
+    {
+        if (a.hash != b.hash) return a.hash < b.hash;
+        return std::strcmp(names.c_str() + a.nameOffset, names.c_str() + b.nameOffset) < 0;
+    });
+
+    pad(alignof(ArchiveEntry));
+    header.indexOffset = pos;
+    if (!entries.empty()) out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(ArchiveEntry)));
+    pos += entries.size() * sizeof(ArchiveEntry);
+    header.namesOffset = pos;
+    out.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!out.good())
+    {
+        m_lastError = "write error on '" + outPath + "'";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,151 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- AssetArchive: read-only pack of asset files (images, JSON, ...) mapped in
+  memory. Replaces thousands of open/stat/read calls on loose files by one
+  mapping: DataManager mounts archives and serves PreloadTexture /
+  LoadTextFile from them, falling back to loose files.
+- AssetArchiveWriter builds an archive (used by the OlympeAssetTool
+  "pack" command).
+
+Notes:
+- Layout (little endian):
+    ArchiveHeader
+    entry data, each entry aligned (16 bytes by default)
+    ArchiveEntry[entryCount] sorted by (hash, name)  <- indexOffset
+    '\0' terminated entry names                        <- namesOffset
+  Lookups hash the normalized path (FNV-1a) and binary search the index
+  in place in the mapping: no allocation, no parsing at mount time.
+- Entries are stored raw or LZ4 compressed (the writer keeps the
+  compressed version only when it saves enough: PNG / JPG are usually
+  stored raw). Raw entries are read in place, without any copy.
+- Paths are normalized: '\' -> '/', leading "./" removed, ASCII lower case
+  (the game data is authored on case insensitive file systems).
+- No engine dependencies (SDL, logging) so that the tools can link it.
+*/
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <cstdint>
+#include <cstddef>
+
+static const char k_ASSET_ARCHIVE_MAGIC[4] = { 'O', 'P', 'A', 'K' };
+static const uint32_t k_ASSET_ARCHIVE_VERSION = 1;
+
+struct ArchiveHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t alignment;   // of the entry data
+    uint64_t indexOffset; // ArchiveEntry table
+    uint64_t namesOffset; // names block
+};
+
+enum ArchiveEntryFlags : uint32_t
+{
+    ArchiveEntry_None = 0,
+    ArchiveEntry_LZ4 = 1 << 0
+};
+
+struct ArchiveEntry
+{
+    uint32_t hash;       // FNV-1a of the normalized path
+    uint32_t nameOffset; // in the names block
+    uint64_t offset;     // data offset from the start of the archive
+    uint32_t storedSize; // bytes in the archive
+    uint32_t size;       // original size
+    uint32_t flags;      // ArchiveEntryFlags
+    uint32_t reserved;
+};
+
+class AssetArchive
+{
+public:
+    AssetArchive() = default;
+    ~AssetArchive();
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+
+    bool Open(const std::string& path); // maps the whole file
+    void Close();
+    bool IsOpen() const { return m_data != nullptr; }
+    const std::string& GetPath() const { return m_path; }
+    const std::string& GetLastError() const { return m_lastError; }
+
+    size_t GetEntryCount() const { return m_entryCount; }
+    const ArchiveEntry* GetEntry(size_t i) const { return (i < m_entryCount) ? &m_entries[i] : nullptr; }
+    const char* GetEntryName(const ArchiveEntry& e) const { return m_names + e.nameOffset; }
+
+    const ArchiveEntry* Find(const std::string& path) const;
+    bool Contains(const std::string& path) const { return Find(path) != nullptr; }
+
+    // Raw entries point into the mapping, compressed ones are decompressed into 'buffer'.
+    // Thread-safe (the mapping is read-only).
+    bool Read(const ArchiveEntry& e, const uint8_t*& outData, size_t& outSize, std::vector<uint8_t>& buffer) const;
+
+    static std::string NormalizePath(const std::string& path);
+    static uint32_t HashPath(const std::string& normalizedPath);
+
+private:
+    bool Fail(const std::string& error);
+
+    std::string m_path;
+    std::string m_lastError;
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    const ArchiveEntry* m_entries = nullptr;
+    size_t m_entryCount = 0;
+    const char* m_names = nullptr;
+
+    // platform mapping handles
+#ifdef _WIN32
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#else
+    int m_fd = -1;
+#endif
+};
+
+class AssetArchiveWriter
+{
+public:
+    void SetAlignment(uint32_t alignment) { m_alignment = (alignment && !(alignment & (alignment - 1))) ? alignment : 16; }
+    // Compressed entries are kept only when they are at most 'maxRatio' of the original size
+    void SetCompression(bool enable, float maxRatio = 0.9f) { m_compress = enable; m_maxRatio = maxRatio; }
+
+    // The file is read when Write() is called. Returns false if the path is already in the archive.
+    bool AddFile(const std::string& archivePath, const std::string& diskPath);
+    bool AddData(const std::string& archivePath, const void* data, size_t size);
+    size_t GetEntryCount() const { return m_pending.size(); }
+
+    bool Write(const std::string& outPath);
+    const std::string& GetLastError() const { return m_lastError; }
+
+    // statistics of the last Write()
+    uint64_t GetTotalSize() const { return m_totalSize; }
+    uint64_t GetStoredSize() const { return m_storedSize; }
+    size_t GetCompressedCount() const { return m_compressedCount; }
+
+private:
+    struct Pending
+    {
+        std::string name;     // normalized
+        std::string diskPath; // empty: 'data' holds the content
+        std::vector<uint8_t> data;
+    };
+    std::vector<Pending> m_pending;
+    std::unordered_set<std::string> m_names;
+    std::string m_lastError;
+    uint32_t m_alignment = 16;
+    bool m_compress = true;
+    float m_maxRatio = 0.9f;
+    uint64_t m_totalSize = 0;
+    uint64_t m_storedSize = 0;
+    size_t m_compressedCount = 0;
+};
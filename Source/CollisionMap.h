@@ -1,10 +1,16 @@
 /* CollisionMap.h
  Simple class holding collision/navigation data for a sector.
+ The map is a uniform grid of cells (row-major). A cell value of 0 is walkable,
+ any other value is blocked. Every modification bumps the version so that
+ navigation caches (PathfindingManager) can detect stale data.
 */
 #pragma once
 
 #include <vector>
+#include <utility>
 #include <iostream>
+#include <cstdint>
+#include <cmath>
 #include "system/system_utils.h"
 
 class CollisionMap
@@ -13,8 +19,63 @@ public:
  CollisionMap() { SYSTEM_LOG << "CollisionMap created\n"; }
  ~CollisionMap() { SYSTEM_LOG << "CollisionMap destroyed\n"; }
 
- // Simple placeholder for collision data
- std::vector<int> data;
+ // Grid layout (cells) and cell size in world units
+ int width = 0;
+ int height = 0;
+ float cellSize = 32.0f;
+
+ void Clear() { data.clear(); width = 0; height = 0; ++version; }
+
+ // (Re)allocate the grid, all cells walkable
+ void Resize(int w, int h, float _cellSize = 32.0f)
+ {
+ width = (w > 0) ? w : 0;
+ height = (h > 0) ? h : 0;
+ cellSize = (_cellSize > 0.0f) ? _cellSize : 32.0f;
+ data.assign(static_cast<size_t>(width) * static_cast<size_t>(height), 0);
+ ++version;
+ }
+
+ // Collision data: one entry per cell, 0 = walkable, other = blocked
+ const std::vector<int>& GetData() const { return data; }
+ // Replace the whole grid content; the size must match the layout (missing cells are walkable)
+ void SetData(std::vector<int> _data)
+ {
+ const size_t count = static_cast<size_t>(width) * static_cast<size_t>(height);
+ if (_data.size() != count)
+ {
+ SYSTEM_LOG << "CollisionMap: " << _data.size() << " cells given for a " << width << "x" << height << " grid\n";
+ _data.resize(count, 0);
+ }
+ data = std::move(_data);
+ ++version;
+ }
+
+ inline bool InBounds(int x, int y) const { return x >= 0 && y >= 0 && x < width && y < height; }
+ // out of bounds cells are considered blocked
+ inline bool IsBlocked(int x, int y) const { return !InBounds(x, y) || data[static_cast<size_t>(y) * width + x] != 0; }
+ inline bool IsWalkable(int x, int y) const { return !IsBlocked(x, y); }
 
- void Clear() { data.clear(); }
+ void SetBlocked(int x, int y, bool blocked)
+ {
+ if (!InBounds(x, y)) return;
+ int& cell = data[static_cast<size_t>(y) * width + x];
+ const int v = blocked ? 1 : 0;
+ if (cell == v) return;
+ cell = v;
+ ++version;
+ }
+
+ // World <-> cell conversions (cell centers)
+ inline int WorldToCellX(float wx) const { return static_cast<int>(std::floor(wx / cellSize)); }
+ inline int WorldToCellY(float wy) const { return static_cast<int>(std::floor(wy / cellSize)); }
+ inline float CellToWorldX(int cx) const { return (cx + 0.5f) * cellSize; }
+ inline float CellToWorldY(int cy) const { return (cy + 0.5f) * cellSize; }
+
+ // Incremented on every change of the grid content or layout
+ inline uint32_t GetVersion() const { return version; }
+
+private:
+ std::vector<int> data;
+ uint32_t version = 1;
 };
@@ -0,0 +1,97 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- Implementation of the cooked texture format (see CookedTexture.h).
+*/
+
+#include "CookedTexture.h"
+#include <cstring>
+
+namespace CookedTexture
+{
+    //-------------------------------------------------------------
+    std::string GetCookedPath(const std::string& sourcePath)
+    {
+        return sourcePath + ".otex";
+    }
+    //-------------------------------------------------------------
+    bool IsCookedPath(const std::string& path)
+    {
+        return path.size() > 5 && SDL_strcasecmp(path.c_str() + path.size() - 5, ".otex") == 0;
+    }
+    //-------------------------------------------------------------
+    bool Cook(SDL_Surface* source, std::vector<uint8_t>& out)
+    {
+        if (!source || source->w <= 0 || source->h <= 0) return false;
+
+        // any source format (palette, RGB, ...) to the upload format, then premultiply in place
+        SDL_Surface* surf = SDL_ConvertSurface(source, k_COOKED_TEXTURE_FORMAT);
+        if (!surf) return false;
+        if (!SDL_PremultiplySurfaceAlpha(surf, false))
+        {
+            SDL_DestroySurface(surf);
+            return false;
+        }
+
+        CookedTextureHeader header;
+        std::memcpy(header.magic, k_COOKED_TEXTURE_MAGIC, 4);
+        header.version = k_COOKED_TEXTURE_VERSION;
+        header.width = static_cast<uint32_t>(surf->w);
+        header.height = static_cast<uint32_t>(surf->h);
+        header.pitch = static_cast<uint32_t>(surf->w) * SDL_BYTESPERPIXEL(k_COOKED_TEXTURE_FORMAT); // rows tightly packed
+        header.format = static_cast<uint32_t>(k_COOKED_TEXTURE_FORMAT);
+        header.flags = CookedTexture_Premultiplied;
+        header.reserved = 0;
+
+        out.resize(sizeof(header) + static_cast<size_t>(header.pitch) * header.height);
+        std::memcpy(out.data(), &header, sizeof(header));
+        uint8_t* dst = out.data() + sizeof(header);
+        const uint8_t* src = static_cast<const uint8_t*>(surf->pixels);
+        for (uint32_t y = 0; y < header.height; ++y)
+        {
+            std::memcpy(dst + static_cast<size_t>(y) * header.pitch, src + static_cast<size_t>(y) * surf->pitch, header.pitch);
+        }
+        SDL_DestroySurface(surf);
+        return true;
+    }
+    //-------------------------------------------------------------
+    SDL_Surface* Load(const uint8_t* data, size_t size)
+    {
+        if (!data || size < sizeof(CookedTextureHeader))
+        {
+            SDL_SetError("cooked texture: truncated header");
+            return nullptr;
+        }
+        CookedTextureHeader header;
+        std::memcpy(&header, data, sizeof(header));
+        if (std::memcmp(header.magic, k_COOKED_TEXTURE_MAGIC, 4) != 0 || header.version != k_COOKED_TEXTURE_VERSION)
+        {
+            SDL_SetError("cooked texture: bad magic or version");
+            return nullptr;
+        }
+        const SDL_PixelFormat format = static_cast<SDL_PixelFormat>(header.format);
+        const uint64_t rowBytes = static_cast<uint64_t>(header.width) * SDL_BYTESPERPIXEL(format);
+        if (header.width == 0 || header.height == 0 || header.width > 32768 || header.height > 32768
+            || SDL_ISPIXELFORMAT_FOURCC(format) || header.pitch < rowBytes
+            || static_cast<uint64_t>(header.pitch) * header.height > size - sizeof(header))
+        {
+            SDL_SetError("cooked texture: corrupted header");
+            return nullptr;
+        }
+
+        SDL_Surface* surf = SDL_CreateSurface(static_cast<int>(header.width), static_cast<int>(header.height), format);
+        if (!surf) return nullptr;
+        const uint8_t* src = data + sizeof(header);
+        uint8_t* dst = static_cast<uint8_t*>(surf->pixels);
+        for (uint32_t y = 0; y < header.height; ++y)
+        {
+            std::memcpy(dst + static_cast<size_t>(y) * surf->pitch, src + static_cast<size_t>(y) * header.pitch, static_cast<size_t>(rowBytes));
+        }
+        // propagated to the texture by SDL_CreateTextureFromSurface
+        SDL_SetSurfaceBlendMode(surf, (header.flags & CookedTexture_Premultiplied) ? SDL_BLENDMODE_BLEND_PREMULTIPLIED : SDL_BLENDMODE_BLEND);
+        return surf;
+    }
+}
@@ -0,0 +1,64 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- Cooked textures (.otex): images decoded once offline ("OlympeAssetTool
+  cook") and stored in the renderer upload format with premultiplied alpha.
+  Loading one is a header check and a copy of the pixels: no PNG/JPEG
+  decode, and SDL_CreateTextureFromSurface uploads it without conversion.
+
+Notes:
+- Layout: CookedTextureHeader then 'height' rows of 'pitch' bytes.
+- The cooked file of "Resources/hero.png" is "Resources/hero.png.otex"
+  (GetCookedPath): DataManager::LoadSurface() uses it when it exists, in
+  an archive or on disk, so calling code keeps the source paths.
+- Pixels are ARGB8888 (the first texture format of the SDL renderers),
+  a renderer without it converts at upload as for any surface.
+- Premultiplied alpha: the surfaces and the textures created from them use
+  SDL_BLENDMODE_BLEND_PREMULTIPLIED (correct filtering at the edges of the
+  sprites, one multiply less per pixel when blending).
+*/
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+static const char k_COOKED_TEXTURE_MAGIC[4] = { 'O', 'T', 'E', 'X' };
+static const uint32_t k_COOKED_TEXTURE_VERSION = 1;
+static const SDL_PixelFormat k_COOKED_TEXTURE_FORMAT = SDL_PIXELFORMAT_ARGB8888;
+
+enum CookedTextureFlags : uint32_t
+{
+    CookedTexture_None = 0,
+    CookedTexture_Premultiplied = 1 << 0
+};
+
+struct CookedTextureHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t pitch;  // bytes per row
+    uint32_t format; // SDL_PixelFormat
+    uint32_t flags;  // CookedTextureFlags
+    uint32_t reserved;
+};
+
+namespace CookedTexture
+{
+    // "path.png" -> "path.png.otex"
+    std::string GetCookedPath(const std::string& sourcePath);
+    bool IsCookedPath(const std::string& path);
+
+    // Convert a decoded image to the cooked format (premultiplied ARGB8888) and serialize it
+    bool Cook(SDL_Surface* source, std::vector<uint8_t>& out);
+
+    // Surface from cooked data (the pixels are copied), nullptr if the data is invalid
+    SDL_Surface* Load(const uint8_t* data, size_t size);
+}
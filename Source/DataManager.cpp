@@ -22,12 +22,20 @@ Notes:
 #include "DataManager.h"
 #include "GameEngine.h"
 #include "system/system_utils.h"
+#include "system/EventManager.h"
+#include "CookedTexture.h"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
 #include <cerrno>
+#include <cstring>
 #include "sdl3_image/sdl_image.h"
 
+namespace
+{
+    const char* const k_DEFAULT_ARCHIVE = "Resources.opak";
+}
+
 #ifdef _WIN32
 #include <direct.h>
 #else
@@ -38,6 +46,13 @@ Notes:
 DataManager::DataManager()
 {
     name = "DataManager";
+    m_slots_.reset(new ResourceSlot[k_MAX_RESOURCE_SLOTS]);
+    // default budgets, overridden by "memory_budgets_mb" in the system resources config
+    m_memoryBudget_[static_cast<size_t>(ResourceCategory::System)] = 0;
+    m_memoryBudget_[static_cast<size_t>(ResourceCategory::GameObject)] = static_cast<size_t>(256) * 1024 * 1024;
+    m_memoryBudget_[static_cast<size_t>(ResourceCategory::Level)] = static_cast<size_t>(512) * 1024 * 1024;
+    m_residentBytes_.fill(0);
+    m_budgetWarned_.fill(false);
     SYSTEM_LOG << "DataManager created\n";
 }
 //-------------------------------------------------------------
@@ -57,6 +72,11 @@ DataManager& DataManager::GetInstance()
 void DataManager::Initialize()
 {
     // Placeholder for initialization logic (e.g. preload system icons)
+    // packed resources: one mapping instead of a file open per asset
+    if (std::ifstream(k_DEFAULT_ARCHIVE)) MountArchive(k_DEFAULT_ARCHIVE);
+#if defined(_DEBUG)
+    SetHotReloadEnabled(true); // art iteration without restarting
+#endif
     SYSTEM_LOG << "DataManager Initialized\n";
 }
 //-------------------------------------------------------------
@@ -64,27 +84,42 @@ void DataManager::Shutdown()
 {
     SYSTEM_LOG << "DataManager Shutdown - unloading all resources\n";
     UnloadAll();
+    SetHotReloadEnabled(false);
+    UnmountArchives();
+    if (m_placeholderTexture_)
+    {
+        SDL_DestroyTexture(m_placeholderTexture_);
+        m_placeholderTexture_ = nullptr;
+    }
 }
 //-------------------------------------------------------------
-bool DataManager::PreloadTexture(const std::string& id, const std::string& path, ResourceCategory category)
+bool DataManager::PreloadTexture(const std::string& id, const std::string& path, ResourceCategory category, ResourceHandle* outHandle)
 {
-    std::lock_guard<std::mutex> lock(m_mutex_);
     if (id.empty() || path.empty()) return false;
-    if (m_resources_.find(id) != m_resources_.end())
     {
-        // already loaded
-        return true;
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        auto it = m_resources_.find(Symbol::Find(id));
+        if (it != m_resources_.end())
+        {
+            // already loaded (or being loaded asynchronously)
+            if (outHandle) *outHandle = it->second->handle;
+            return true;
+        }
     }
 
-    // try to load BMP surface first (no external deps required)
-    SDL_Surface* surf = IMG_Load(path.c_str()); //SDL_LoadBMP(path.c_str());
+    // decode and upload without holding the lock: other threads may query resources meanwhile
+    SDL_Surface* surf = LoadSurface(path); //SDL_LoadBMP(path.c_str());
 
     if (!surf)
     {
         SYSTEM_LOG << "DataManager::PreloadTexture IMG_Load failed for '" << path << "' : " << SDL_GetError() << "\n";
         return false;
     }
-
+    return AddDecodedTexture(id, path, category, surf, outHandle);
+}
+//-------------------------------------------------------------
+bool DataManager::AddDecodedTexture(const std::string& id, const std::string& path, ResourceCategory category, SDL_Surface* surf, ResourceHandle* outHandle)
+{
     SDL_Renderer* renderer = GameEngine::renderer;
     SDL_Texture* tex = nullptr;
     if (renderer)
@@ -120,24 +155,895 @@ bool DataManager::PreloadTexture(const std::string& id, const std::string& path,
         SDL_DestroySurface(surf);
     }
 
-    m_resources_.emplace(id, res);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        auto inserted = m_resources_.emplace(id, res);
+        if (!inserted.second)
+        {
+            // loaded concurrently by another caller: keep the first one
+            if (res->texture) SDL_DestroyTexture(res->texture);
+            if (res->data) SDL_DestroySurface(reinterpret_cast<SDL_Surface*>(res->data));
+            if (outHandle) *outHandle = inserted.first->second->handle;
+            return true;
+        }
+        AllocateSlot(*res);
+        AccountTexture(*res);
+        WatchResource(*res);
+        if (outHandle) *outHandle = res->handle;
+    }
     SYSTEM_LOG << "DataManager: Loaded texture '" << id << "' from '" << path << "'\n";
     return true;
 }
 //-------------------------------------------------------------
-bool DataManager::PreloadSprite(const std::string& id, const std::string& path, ResourceCategory category)
+std::shared_future<SDL_Texture*> DataManager::LoadTextureAsync(const std::string& id, const std::string& path, JobPriority priority, ResourceCategory category)
+{
+    std::shared_ptr<Resource> res;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        auto it = m_resources_.find(Symbol::Find(id));
+        if (it != m_resources_.end())
+        {
+            // already requested: share the pending load, or return the loaded texture
+            if (it->second->loadFuture.valid()) return it->second->loadFuture;
+            std::promise<SDL_Texture*> done;
+            done.set_value(it->second->texture);
+            return done.get_future().share();
+        }
+        if (id.empty() || path.empty())
+        {
+            std::promise<SDL_Texture*> failed;
+            failed.set_value(nullptr);
+            return failed.get_future().share();
+        }
+
+        res = std::make_shared<Resource>();
+        res->type = ResourceType::Texture;
+        res->category = category;
+        res->id = id;
+        res->path = path;
+        res->state = ResourceState::Loading;
+        res->loadPromise = std::make_shared<std::promise<SDL_Texture*>>();
+        res->loadFuture = res->loadPromise->get_future().share();
+        m_resources_.emplace(id, res);
+        AllocateSlot(*res);
+        WatchResource(*res);
+    }
+
+    QueueDecode(res, priority);
+    return res->loadFuture;
+}
+//-------------------------------------------------------------
+void DataManager::QueueDecode(const std::shared_ptr<Resource>& res, JobPriority priority)
+{
+    std::weak_ptr<Resource> weakRes = res;
+    const std::string path = res->path;
+    const size_t queue = static_cast<size_t>(priority);
+    JobSystem::Get().Submit([this, weakRes, path, queue]()
+    {
+        // skip the decode if the resource was released before we started
+        if (weakRes.expired()) return;
+        SDL_Surface* surf = LoadSurface(path);
+
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        std::shared_ptr<Resource> r = weakRes.lock();
+        if (!r || (r->state != ResourceState::Loading && !r->hotReload))
+        {
+            if (surf) SDL_DestroySurface(surf);
+            return;
+        }
+        if (!surf)
+        {
+            SYSTEM_LOG << "DataManager::LoadTextureAsync IMG_Load failed for '" << path << "' : " << SDL_GetError() << "\n";
+            if (r->hotReload)
+            {
+                // file saved in a broken state: keep the current texture until the next change
+                r->hotReload = false;
+                return;
+            }
+            r->state = ResourceState::Failed;
+            PublishSlot(*r);
+            CompleteLoad(*r, nullptr);
+            return;
+        }
+        // reuse the deferred surface slot, the upload is done by ProcessPendingUploads()
+        if (r->data) SDL_DestroySurface(reinterpret_cast<SDL_Surface*>(r->data)); // changed again before its upload
+        r->data = surf;
+        if (!r->hotReload)
+        {
+            r->state = ResourceState::Decoded;
+            PublishSlot(*r);
+        }
+        m_pendingUploads_[queue].push_back(weakRes);
+    }, priority);
+}
+//-------------------------------------------------------------
+void DataManager::CompleteLoad(Resource& res, SDL_Texture* tex)
+{
+    if (res.loadPromise)
+    {
+        res.loadPromise->set_value(tex);
+        res.loadPromise.reset();
+    }
+}
+//-------------------------------------------------------------
+void DataManager::AllocateSlot(Resource& res)
+{
+    uint32_t index;
+    if (!m_freeSlots_.empty())
+    {
+        index = m_freeSlots_.back();
+        m_freeSlots_.pop_back();
+    }
+    else if (m_slotCount_ < k_MAX_RESOURCE_SLOTS)
+    {
+        index = m_slotCount_++;
+    }
+    else
+    {
+        // still reachable through its id, only the handle lookups are unavailable
+        SYSTEM_LOG << "DataManager: no free resource slot for '" << res.id << "'\n";
+        res.handle = ResourceHandle();
+        return;
+    }
+    res.handle.index = index;
+    res.handle.generation = m_slots_[index].generation.load(std::memory_order_relaxed);
+    m_slots_[index].lastUsedFrame.store(m_frameStamp_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_slots_[index].pinCount.store(0, std::memory_order_relaxed);
+    m_slots_[index].reloadRequested.store(0, std::memory_order_relaxed);
+    PublishSlot(res);
+}
+//-------------------------------------------------------------
+void DataManager::PublishSlot(const Resource& res) const
+{
+    if (!res.handle.IsValid()) return;
+    const SDL_FRect src = (res.atlasPage >= 0 || !res.texture) ? res.srcRect
+        : SDL_FRect{ 0.0f, 0.0f, static_cast<float>(res.texture->w), static_cast<float>(res.texture->h) };
+    WriteSlot(m_slots_[res.handle.index], res.texture, res.state, src);
+}
+//-------------------------------------------------------------
+namespace
+{
+    inline uint64_t PackFloats(float a, float b)
+    {
+        uint32_t ua, ub;
+        std::memcpy(&ua, &a, sizeof(ua));
+        std::memcpy(&ub, &b, sizeof(ub));
+        return (static_cast<uint64_t>(ub) << 32) | ua;
+    }
+    inline void UnpackFloats(uint64_t v, float& a, float& b)
+    {
+        const uint32_t ua = static_cast<uint32_t>(v);
+        const uint32_t ub = static_cast<uint32_t>(v >> 32);
+        std::memcpy(&a, &ua, sizeof(a));
+        std::memcpy(&b, &ub, sizeof(b));
+    }
+}
+//-------------------------------------------------------------
+void DataManager::WriteSlot(ResourceSlot& slot, SDL_Texture* tex, ResourceState state, const SDL_FRect& src)
+{
+    // seqlock: odd sequence while writing, the fields are atomics so that readers racing the write are well defined
+    const uint32_t seq = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.srcPos.store(PackFloats(src.x, src.y), std::memory_order_relaxed);
+    slot.srcSize.store(PackFloats(src.w, src.h), std::memory_order_relaxed);
+    slot.state.store(static_cast<uint32_t>(state), std::memory_order_relaxed);
+    slot.texture.store(tex, std::memory_order_relaxed);
+    slot.sequence.store(seq + 2, std::memory_order_release);
+}
+//-------------------------------------------------------------
+void DataManager::ReadSlot(const ResourceSlot& slot, SDL_Texture*& outTex, ResourceState& outState, SDL_FRect& outSrc)
+{
+    uint32_t before, after;
+    uint64_t pos, size;
+    do
+    {
+        before = slot.sequence.load(std::memory_order_acquire);
+        pos = slot.srcPos.load(std::memory_order_relaxed);
+        size = slot.srcSize.load(std::memory_order_relaxed);
+        outState = static_cast<ResourceState>(slot.state.load(std::memory_order_relaxed));
+        outTex = slot.texture.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = slot.sequence.load(std::memory_order_relaxed);
+    } while ((before & 1u) != 0 || before != after);
+    UnpackFloats(pos, outSrc.x, outSrc.y);
+    UnpackFloats(size, outSrc.w, outSrc.h);
+}
+//-------------------------------------------------------------
+void DataManager::FreeSlot(Resource& res)
+{
+    if (!res.handle.IsValid()) return;
+    ResourceSlot& slot = m_slots_[res.handle.index];
+    // new generation first: readers holding the old handle fail their check from now on
+    slot.generation.fetch_add(1, std::memory_order_acq_rel);
+    WriteSlot(slot, nullptr, ResourceState::Failed, SDL_FRect{ 0.0f, 0.0f, 0.0f, 0.0f });
+    slot.pinCount.store(0, std::memory_order_relaxed);
+    slot.reloadRequested.store(0, std::memory_order_relaxed);
+    m_freeSlots_.push_back(res.handle.index);
+    res.handle = ResourceHandle();
+}
+//-------------------------------------------------------------
+ResourceHandle DataManager::GetHandle(const std::string& id) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    auto it = m_resources_.find(Symbol::Find(id));
+    return (it != m_resources_.end()) ? it->second->handle : ResourceHandle();
+}
+//-------------------------------------------------------------
+bool DataManager::IsValid(ResourceHandle handle) const
+{
+    return handle.index < k_MAX_RESOURCE_SLOTS && m_slots_[handle.index].generation.load(std::memory_order_acquire) == handle.generation;
+}
+//-------------------------------------------------------------
+SDL_Texture* DataManager::GetTexture(ResourceHandle handle) const
+{
+    SDL_Texture* tex = nullptr;
+    SDL_FRect src;
+    if (!GetSpriteRegion(handle, tex, src)) return nullptr;
+    if (src.x != 0.0f || src.y != 0.0f || src.w != static_cast<float>(tex->w) || src.h != static_cast<float>(tex->h))
+    {
+        SYSTEM_LOG << "DataManager::GetTexture: resource " << handle.index << " is packed in a sprite atlas, use GetSpriteRegion()\n";
+        return nullptr;
+    }
+    return tex;
+}
+//-------------------------------------------------------------
+bool DataManager::GetSpriteRegion(ResourceHandle handle, SDL_Texture*& outTexture, SDL_FRect& outSrcRect) const
+{
+    outTexture = nullptr;
+    if (handle.index >= k_MAX_RESOURCE_SLOTS) return false;
+    ResourceSlot& slot = m_slots_[handle.index];
+    if (slot.generation.load(std::memory_order_acquire) != handle.generation) return false;
+
+    SDL_Texture* tex;
+    ResourceState state;
+    SDL_FRect src;
+    ReadSlot(slot, tex, state, src); // texture, state and rect of the same publication
+    // released (and possibly reused) while reading: the values may belong to another resource
+    if (slot.generation.load(std::memory_order_acquire) != handle.generation) return false;
+    TouchSlot(slot);
+
+    if (!tex)
+    {
+        if (state == ResourceState::Evicted) RequestReload(slot);
+        else if (state != ResourceState::Loading && state != ResourceState::Decoded) return false;
+        tex = GetPlaceholderTexture();
+        if (!tex) return false;
+        outTexture = tex;
+        outSrcRect = { 0.0f, 0.0f, static_cast<float>(tex->w), static_cast<float>(tex->h) };
+        return true;
+    }
+    outTexture = tex;
+    outSrcRect = src;
+    return true;
+}
+//-------------------------------------------------------------
+void DataManager::UploadDeferredTextures()
+{
+    SDL_Renderer* renderer = GameEngine::renderer;
+    if (!renderer) return;
+
+    size_t count = 0;
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    for (auto& kv : m_resources_)
+    {
+        Resource& res = *kv.second;
+        // surfaces kept by PreloadTexture without a renderer (async decodes are uploaded by ProcessPendingUploads)
+        if (res.texture || !res.data || res.state != ResourceState::Ready) continue;
+        SDL_Surface* surf = reinterpret_cast<SDL_Surface*>(res.data);
+        res.texture = SDL_CreateTextureFromSurface(renderer, surf);
+        if (!res.texture)
+        {
+            SYSTEM_LOG << "DataManager: Failed to create deferred texture for '" << res.id << "' : " << SDL_GetError() << "\n";
+            continue;
+        }
+        SDL_DestroySurface(surf);
+        res.data = nullptr;
+        AccountTexture(res);
+        PublishSlot(res);
+        ++count;
+    }
+    if (count > 0) SYSTEM_LOG << "DataManager: Uploaded " << count << " deferred textures\n";
+}
+//-------------------------------------------------------------
+void DataManager::ProcessPendingUploads()
+{
+    SDL_Renderer* renderer = GameEngine::renderer;
+    if (!renderer) return;
+
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+    const Uint64 start = SDL_GetPerformanceCounter();
+    const Uint64 budget = static_cast<Uint64>(m_uploadBudgetMs * 0.001 * static_cast<double>(freq));
+
+    while (true)
+    {
+        // pop the next upload, highest priority first
+        std::shared_ptr<Resource> res;
+        SDL_Surface* surf = nullptr;
+        bool hotReload = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex_);
+            for (auto& q : m_pendingUploads_)
+            {
+                while (!q.empty() && !res)
+                {
+                    res = q.front().lock();
+                    q.pop_front();
+                    if (res && ((res->state != ResourceState::Decoded && !res->hotReload) || !res->data)) res.reset();
+                }
+                if (res) break;
+            }
+            if (!res) return;
+            surf = reinterpret_cast<SDL_Surface*>(res->data);
+            res->data = nullptr;
+            hotReload = res->hotReload;
+        }
+
+        if (hotReload)
+        {
+            UploadHotReload(res, surf);
+            SDL_DestroySurface(surf);
+            if (SDL_GetPerformanceCounter() - start >= budget) break;
+            continue;
+        }
+
+        // upload outside the lock so workers can keep queuing decoded surfaces
+        SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
+        if (!tex) SYSTEM_LOG << "DataManager: Failed to upload texture '" << res->id << "' : " << SDL_GetError() << "\n";
+        SDL_DestroySurface(surf);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex_);
+            res->texture = tex;
+            res->state = tex ? ResourceState::Ready : ResourceState::Failed;
+            if (res->handle.IsValid()) AccountTexture(*res); // not released while uploading
+            PublishSlot(*res);
+            CompleteLoad(*res, tex);
+        }
+        if (tex) SYSTEM_LOG << "DataManager: Loaded texture '" << res->id << "' from '" << res->path << "' (async)\n";
+
+        // at least one upload per frame so the queue always progresses
+        if (SDL_GetPerformanceCounter() - start >= budget) break;
+    }
+}
+//-------------------------------------------------------------
+size_t DataManager::GetPendingUploadCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    size_t n = 0;
+    for (const auto& q : m_pendingUploads_) n += q.size();
+    return n;
+}
+//-------------------------------------------------------------
+bool DataManager::IsTextureReady(const std::string& id) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    auto it = m_resources_.find(Symbol::Find(id));
+    return it != m_resources_.end() && it->second->state == ResourceState::Ready && it->second->texture;
+}
+//-------------------------------------------------------------
+SDL_Texture* DataManager::GetPlaceholderTexture() const
+{
+    if (m_placeholderTexture_ || !GameEngine::renderer) return m_placeholderTexture_;
+
+    // 8x8 magenta / black checker, easy to spot on screen
+    SDL_Surface* surf = SDL_CreateSurface(8, 8, SDL_PIXELFORMAT_RGBA8888);
+    if (!surf) return nullptr;
+    const Uint32 magenta = SDL_MapSurfaceRGBA(surf, 255, 0, 255, 255);
+    const Uint32 black = SDL_MapSurfaceRGBA(surf, 0, 0, 0, 255);
+    for (int y = 0; y < 8; ++y)
+    {
+        Uint32* row = reinterpret_cast<Uint32*>(static_cast<Uint8*>(surf->pixels) + y * surf->pitch);
+        for (int x = 0; x < 8; ++x) row[x] = (((x >> 2) ^ (y >> 2)) & 1) ? black : magenta;
+    }
+    m_placeholderTexture_ = SDL_CreateTextureFromSurface(GameEngine::renderer, surf);
+    if (m_placeholderTexture_) SDL_SetTextureScaleMode(m_placeholderTexture_, SDL_SCALEMODE_NEAREST);
+    SDL_DestroySurface(surf);
+    return m_placeholderTexture_;
+}
+//-------------------------------------------------------------
+void DataManager::TouchSlot(ResourceSlot& slot) const
+{
+    // LRU stamp: skip the store when already up to date, lookups are frequent
+    const uint32_t frame = m_frameStamp_.load(std::memory_order_relaxed);
+    if (slot.lastUsedFrame.load(std::memory_order_relaxed) != frame) slot.lastUsedFrame.store(frame, std::memory_order_relaxed);
+}
+//-------------------------------------------------------------
+void DataManager::RequestReload(ResourceSlot& slot) const
+{
+    if (slot.reloadRequested.exchange(1, std::memory_order_relaxed) == 0) m_reloadRequests_.fetch_add(1, std::memory_order_release);
+}
+//-------------------------------------------------------------
+size_t DataManager::EstimateTextureBytes(const SDL_Texture* texture)
+{
+    if (!texture) return 0;
+    const size_t pixels = static_cast<size_t>(texture->w) * static_cast<size_t>(texture->h);
+    if (SDL_ISPIXELFORMAT_FOURCC(texture->format)) return pixels * 3 / 2; // planar YUV: 12 bits per pixel
+    const size_t bpp = SDL_BYTESPERPIXEL(texture->format);
+    return pixels * (bpp ? bpp : 4);
+}
+//-------------------------------------------------------------
+void DataManager::AccountTexture(Resource& res) const
+{
+    const size_t category = static_cast<size_t>(res.category);
+    if (category >= k_RESOURCE_CATEGORY_COUNT) return;
+    // atlas pages are shared by many sprites: not counted per resource
+    res.vramBytes = (res.atlasPage < 0) ? EstimateTextureBytes(res.texture) : 0;
+    m_residentBytes_[category] += res.vramBytes;
+}
+//-------------------------------------------------------------
+void DataManager::UnaccountTexture(Resource& res) const
+{
+    const size_t category = static_cast<size_t>(res.category);
+    if (category >= k_RESOURCE_CATEGORY_COUNT) return;
+    m_residentBytes_[category] -= res.vramBytes;
+    res.vramBytes = 0;
+}
+//-------------------------------------------------------------
+void DataManager::SetMemoryBudget(ResourceCategory category, size_t bytes)
+{
+    const size_t c = static_cast<size_t>(category);
+    if (c >= k_RESOURCE_CATEGORY_COUNT) return;
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    m_memoryBudget_[c] = bytes;
+    m_budgetWarned_[c] = false;
+}
+//-------------------------------------------------------------
+size_t DataManager::GetMemoryBudget(ResourceCategory category) const
+{
+    const size_t c = static_cast<size_t>(category);
+    if (c >= k_RESOURCE_CATEGORY_COUNT) return 0;
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    return m_memoryBudget_[c];
+}
+//-------------------------------------------------------------
+size_t DataManager::GetResidentBytes(ResourceCategory category) const
+{
+    const size_t c = static_cast<size_t>(category);
+    if (c >= k_RESOURCE_CATEGORY_COUNT) return 0;
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    return m_residentBytes_[c];
+}
+//-------------------------------------------------------------
+bool DataManager::Pin(ResourceHandle handle)
+{
+    if (!IsValid(handle)) return false;
+    m_slots_[handle.index].pinCount.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+//-------------------------------------------------------------
+bool DataManager::Unpin(ResourceHandle handle)
 {
-	return PreloadTexture(id, path, category);
+    if (!IsValid(handle)) return false;
+    std::atomic<uint32_t>& pins = m_slots_[handle.index].pinCount;
+    uint32_t n = pins.load(std::memory_order_relaxed);
+    while (n > 0 && !pins.compare_exchange_weak(n, n - 1, std::memory_order_relaxed)) {}
+    return n > 0;
+}
+//-------------------------------------------------------------
+bool DataManager::Pin(const std::string& id)
+{
+    return Pin(GetHandle(id));
+}
+//-------------------------------------------------------------
+bool DataManager::Unpin(const std::string& id)
+{
+    return Unpin(GetHandle(id));
+}
+//-------------------------------------------------------------
+void DataManager::ProcessResidency()
+{
+    // lookups of the frame that just ended carry the previous stamp
+    const uint32_t frame = m_frameStamp_.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    std::lock_guard<std::mutex> lock(m_mutex_);
+
+    // evicted textures looked up since the last call: reload them from their path
+    if (m_reloadRequests_.exchange(0, std::memory_order_acquire) != 0)
+    {
+        for (auto& kv : m_resources_)
+        {
+            const std::shared_ptr<Resource>& res = kv.second;
+            if (!res->handle.IsValid()) continue;
+            if (m_slots_[res->handle.index].reloadRequested.exchange(0, std::memory_order_relaxed) == 0) continue;
+            if (res->state != ResourceState::Evicted) continue;
+
+            res->state = ResourceState::Loading;
+            res->loadPromise = std::make_shared<std::promise<SDL_Texture*>>();
+            res->loadFuture = res->loadPromise->get_future().share();
+            PublishSlot(*res);
+            QueueDecode(res, JobPriority::High);
+        }
+    }
+
+    for (size_t c = 0; c < k_RESOURCE_CATEGORY_COUNT; ++c)
+    {
+        if (m_memoryBudget_[c] != 0 && m_residentBytes_[c] > m_memoryBudget_[c]) EvictCategory(c, frame);
+    }
+}
+//-------------------------------------------------------------
+void DataManager::EvictCategory(size_t category, uint32_t frame)
+{
+    // candidates: owned, ready textures that can be reloaded and were not used during the last frame
+    std::vector<std::pair<uint32_t, Resource*>> candidates;
+    for (auto& kv : m_resources_)
+    {
+        Resource& res = *kv.second;
+        if (static_cast<size_t>(res.category) != category || res.state != ResourceState::Ready) continue;
+        if (!res.texture || res.atlasPage >= 0 || res.vramBytes == 0 || res.path.empty() || !res.handle.IsValid() || res.hotReload) continue;
+        const ResourceSlot& slot = m_slots_[res.handle.index];
+        if (slot.pinCount.load(std::memory_order_relaxed) != 0) continue;
+        const uint32_t lastUsed = slot.lastUsedFrame.load(std::memory_order_relaxed);
+        if (lastUsed + 1 >= frame) continue;
+        candidates.emplace_back(lastUsed, &res);
+    }
+    std::sort(candidates.begin(), candidates.end(),
+        [](const std::pair<uint32_t, Resource*>& a, const std::pair<uint32_t, Resource*>& b) { return a.first < b.first; });
+
+    // least recently used first
+    for (const auto& c : candidates)
+    {
+        if (m_residentBytes_[category] <= m_memoryBudget_[category]) break;
+        Resource& res = *c.second;
+        SYSTEM_LOG << "DataManager: evicting texture '" << res.id << "' (" << (res.vramBytes >> 10) << " KB, unused for " << (frame - 1 - c.first) << " frames)\n";
+        UnaccountTexture(res);
+        SDL_DestroyTexture(res.texture);
+        res.texture = nullptr;
+        res.state = ResourceState::Evicted;
+        PublishSlot(res);
+        ++m_evictionCount_;
+    }
+
+    if (m_residentBytes_[category] > m_memoryBudget_[category])
+    {
+        // everything left is pinned or in use: the budget is too small for the current scene
+        if (!m_budgetWarned_[category])
+        {
+            SYSTEM_LOG << "DataManager: memory budget of category " << category << " exceeded by textures in use ("
+                << (m_residentBytes_[category] >> 20) << " MB / " << (m_memoryBudget_[category] >> 20) << " MB)\n";
+            m_budgetWarned_[category] = true;
+        }
+    }
+    else m_budgetWarned_[category] = false;
+}
+//-------------------------------------------------------------
+void DataManager::SetHotReloadEnabled(bool enable)
+{
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    if (enable == (m_fileWatcher_ != nullptr)) return;
+    {
+        // cooked files may have been written while the source images were used
+        std::lock_guard<std::mutex> indexLock(m_cookedIndexMutex_);
+        m_cookedIndex_.clear();
+    }
+    if (!enable)
+    {
+        m_hotReloadEnabled_.store(false, std::memory_order_release);
+        m_fileWatcher_.reset();
+        SYSTEM_LOG << "DataManager: hot reload disabled\n";
+        return;
+    }
+    m_fileWatcher_.reset(new FileWatcher());
+    for (const auto& kv : m_resources_) WatchResource(*kv.second);
+    if (!m_systemConfigPath_.empty()) m_fileWatcher_->Watch(m_systemConfigPath_);
+    m_hotReloadEnabled_.store(true, std::memory_order_release);
+    SYSTEM_LOG << "DataManager: hot reload enabled (" << m_fileWatcher_->GetWatchedCount() << " files, "
+        << (m_fileWatcher_->IsUsingNotifications() ? "notifications" : "polling") << ")\n";
+}
+//-------------------------------------------------------------
+void DataManager::WatchResource(const Resource& res)
+{
+    // sprites of a baked atlas point to its json: the pages are not reloaded
+    if (!m_fileWatcher_ || res.path.empty() || (res.atlasPage >= 0 && res.path.size() > 5 && res.path.compare(res.path.size() - 5, 5, ".json") == 0)) return;
+    m_fileWatcher_->Watch(res.path);
+}
+//-------------------------------------------------------------
+void DataManager::UnwatchResource(const Resource& res)
+{
+    if (m_fileWatcher_ && !res.path.empty()) m_fileWatcher_->Unwatch(res.path);
+}
+//-------------------------------------------------------------
+void DataManager::WatchDataFile(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    if (m_fileWatcher_) m_fileWatcher_->Watch(path);
+}
+//-------------------------------------------------------------
+void DataManager::UnwatchDataFile(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    if (m_fileWatcher_) m_fileWatcher_->Unwatch(path);
+}
+//-------------------------------------------------------------
+void DataManager::PostReloaded(const Symbol& id, const std::string& path)
+{
+    Message msg;
+    msg.struct_type = EventStructType::EventStructType_Olympe;
+    msg.msg_type = EventType::Olympe_EventType_Resource_Reloaded;
+    msg.sender = this;
+    msg.objectName = id;
+    EventManager::Get().AddMessage(msg, path); // EventManager::GetPayloadString() in the listeners
+}
+//-------------------------------------------------------------
+void DataManager::ProcessHotReload()
+{
+    // cheap early out every frame; the watcher itself is only touched under the lock
+    if (!m_hotReloadEnabled_.load(std::memory_order_acquire)) return;
+
+    std::vector<std::string> dataFiles;
+    std::string configPath; // copied under the lock: PreloadSystemResources() may run on a worker
+    {
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        if (!m_fileWatcher_) return;
+        m_changedFiles_.clear();
+        m_fileWatcher_->Poll(m_changedFiles_);
+        if (m_changedFiles_.empty()) return;
+
+        for (const std::string& file : m_changedFiles_)
+        {
+            // only the resources loaded from this file are decoded again
+            bool isResource = false;
+            for (auto& kv : m_resources_)
+            {
+                const std::shared_ptr<Resource>& res = kv.second;
+                if (res->path.empty() || FileWatcher::NormalizePath(res->path) != file) continue;
+                isResource = true;
+                if (res->state == ResourceState::Ready && !res->hotReload)
+                {
+                    // the current texture is drawn until the new one is uploaded
+                    res->hotReload = true;
+                    QueueDecode(res, JobPriority::Normal);
+                }
+                else if (res->state == ResourceState::Failed)
+                {
+                    // a broken file was fixed: load it as a new texture
+                    res->state = ResourceState::Loading;
+                    res->loadPromise = std::make_shared<std::promise<SDL_Texture*>>();
+                    res->loadFuture = res->loadPromise->get_future().share();
+                    PublishSlot(*res);
+                    QueueDecode(res, JobPriority::Normal);
+                }
+                // Loading / Decoded / Evicted: the next decode reads the new file anyway
+            }
+            if (isResource) continue;
+            if (file == FileWatcher::NormalizePath(m_systemConfigPath_)) configPath = m_systemConfigPath_;
+            else dataFiles.push_back(file);
+        }
+    }
+
+    for (const std::string& file : dataFiles)
+    {
+        SYSTEM_LOG << "DataManager: data file changed '" << file << "'\n";
+        PostReloaded(Symbol(), file);
+    }
+    if (!configPath.empty())
+    {
+        SYSTEM_LOG << "DataManager: reloading system resources config '" << configPath << "'\n";
+        PreloadSystemResources(configPath);
+        PostReloaded(Symbol(), configPath);
+    }
+}
+//-------------------------------------------------------------
+void DataManager::UploadHotReload(const std::shared_ptr<Resource>& res, SDL_Surface* surf)
+{
+    SDL_Renderer* renderer = GameEngine::renderer;
+    bool updated = false;
+
+    std::unique_lock<std::mutex> lock(m_mutex_);
+    if (!res->hotReload || !res->handle.IsValid()) return; // released meanwhile
+    res->hotReload = false;
+
+    if (res->atlasPage >= 0)
+    {
+        // same size: new pixels in the atlas page, only this area is uploaded
+        updated = m_atlas_.Replace(res->id.str(), surf);
+        if (updated) m_atlas_.Flush(renderer);
+    }
+    else if (res->texture && res->texture->w == surf->w && res->texture->h == surf->h)
+    {
+        // same size: update the texture in place, raw pointers held elsewhere stay valid
+        SDL_Surface* conv = (surf->format == res->texture->format) ? surf : SDL_ConvertSurface(surf, res->texture->format);
+        if (conv)
+        {
+            updated = SDL_UpdateTexture(res->texture, nullptr, conv->pixels, conv->pitch);
+            if (conv != surf) SDL_DestroySurface(conv);
+            // cooked (premultiplied) <-> source image
+            SDL_BlendMode blendMode;
+            if (updated && SDL_GetSurfaceBlendMode(surf, &blendMode)) SDL_SetTextureBlendMode(res->texture, blendMode);
+        }
+    }
+
+    if (!updated)
+    {
+        // size or format changed: new standalone texture (an atlas sprite leaves its region unused)
+        lock.unlock();
+        SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
+        if (!tex)
+        {
+            SYSTEM_LOG << "DataManager: Failed to upload reloaded texture '" << res->id << "' : " << SDL_GetError() << "\n";
+            return;
+        }
+        lock.lock();
+        if (!res->handle.IsValid() || res->state != ResourceState::Ready)
+        {
+            SDL_DestroyTexture(tex);
+            return;
+        }
+        UnaccountTexture(*res);
+        SDL_Texture* old = (res->atlasPage < 0) ? res->texture : nullptr;
+        res->texture = tex;
+        res->atlasPage = -1;
+        res->srcRect = { 0.0f, 0.0f, static_cast<float>(tex->w), static_cast<float>(tex->h) };
+        AccountTexture(*res);
+        PublishSlot(*res);
+        // frame boundary: nothing drawn with the old texture is pending
+        if (old) SDL_DestroyTexture(old);
+    }
+    lock.unlock();
+
+    SYSTEM_LOG << "DataManager: Reloaded texture '" << res->id << "' from '" << res->path << "'" << (updated ? " (in place)" : "") << "\n";
+    PostReloaded(res->id, res->path);
+}
+//-------------------------------------------------------------
+bool DataManager::MountArchive(const std::string& path)
+{
+    std::unique_ptr<AssetArchive> archive(new AssetArchive());
+    if (!archive->Open(path))
+    {
+        SYSTEM_LOG << "DataManager: cannot mount archive '" << path << "' : " << archive->GetLastError() << "\n";
+        return false;
+    }
+    SYSTEM_LOG << "DataManager: mounted archive '" << path << "' (" << archive->GetEntryCount() << " files)\n";
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    m_archives_.push_back(std::move(archive));
+    return true;
+}
+//-------------------------------------------------------------
+void DataManager::UnmountArchives()
+{
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    m_archives_.clear();
+}
+//-------------------------------------------------------------
+size_t DataManager::GetMountedArchiveCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    return m_archives_.size();
+}
+//-------------------------------------------------------------
+bool DataManager::ReadFromArchives(const std::string& path, const uint8_t*& outData, size_t& outSize, std::vector<uint8_t>& buffer, bool& outLooseFirst) const
+{
+    const AssetArchive* archive = nullptr;
+    const ArchiveEntry* entry = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        // with hot reload the edited loose files must win over their packed copy
+        outLooseFirst = (m_fileWatcher_ != nullptr);
+        for (auto it = m_archives_.rbegin(); it != m_archives_.rend() && !entry; ++it)
+        {
+            entry = (*it)->Find(path);
+            archive = it->get();
+        }
+    }
+    if (!entry) return false;
+    // decompression outside the lock: the mapping stays valid until UnmountArchives()
+    if (archive->Read(*entry, outData, outSize, buffer)) return true;
+    SYSTEM_LOG << "DataManager: corrupted entry '" << path << "' in archive '" << archive->GetPath() << "'\n";
+    return false;
+}
+//-------------------------------------------------------------
+SDL_Surface* DataManager::LoadSurface(const std::string& path) const
+{
+    if (CookedTexture::IsCookedPath(path)) return LoadCookedSurface(path);
+    bool hotReload = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        hotReload = (m_fileWatcher_ != nullptr);
+    }
+    // cooked version first: no decode, no conversion. Not with hot reload: the source files are the edited (and watched) ones
+    if (!hotReload)
+    {
+        const std::string cookedPath = CookedTexture::GetCookedPath(path);
+        SDL_Surface* cooked = HasCookedFile(cookedPath) ? LoadCookedSurface(cookedPath) : nullptr;
+        if (cooked) return cooked;
+    }
+
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    std::vector<uint8_t> buffer;
+    bool looseFirst = false;
+    if (!ReadFromArchives(path, data, size, buffer, looseFirst)) return IMG_Load(path.c_str());
+
+    if (looseFirst)
+    {
+        SDL_Surface* surf = IMG_Load(path.c_str());
+        if (surf) return surf;
+    }
+    // decoded from memory: no file system access
+    SDL_IOStream* io = SDL_IOFromConstMem(data, size);
+    SDL_Surface* surf = io ? IMG_Load_IO(io, true) : nullptr;
+    if (!surf && !looseFirst)
+    {
+        SYSTEM_LOG << "DataManager: cannot decode '" << path << "' from archive : " << SDL_GetError() << "\n";
+        surf = IMG_Load(path.c_str());
+    }
+    return surf;
+}
+//-------------------------------------------------------------
+bool DataManager::HasCookedFile(const std::string& cookedPath) const
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        for (const auto& archive : m_archives_)
+            if (archive->Contains(cookedPath)) return true;
+    }
+
+    const size_t sep = cookedPath.find_last_of("/\\");
+    const std::string dir = (sep == std::string::npos) ? std::string(".") : cookedPath.substr(0, sep);
+    const std::string name = (sep == std::string::npos) ? cookedPath : cookedPath.substr(sep + 1);
+
+    std::lock_guard<std::mutex> lock(m_cookedIndexMutex_);
+    auto it = m_cookedIndex_.find(dir);
+    if (it == m_cookedIndex_.end())
+    {
+        // one directory listing instead of a failed open for each image that is not cooked
+        it = m_cookedIndex_.emplace(dir, std::unordered_set<std::string>()).first;
+        int count = 0;
+        char** files = SDL_GlobDirectory(dir.c_str(), "*.otex", 0, &count);
+        if (files)
+        {
+            for (int i = 0; i < count; ++i) it->second.insert(files[i]);
+            SDL_free(files);
+        }
+    }
+    return it->second.count(name) != 0;
+}
+//-------------------------------------------------------------
+SDL_Surface* DataManager::LoadCookedSurface(const std::string& path) const
+{
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    std::vector<uint8_t> buffer;
+    bool looseFirst = false;
+    if (ReadFromArchives(path, data, size, buffer, looseFirst)) return CookedTexture::Load(data, size);
+
+    void* file = SDL_LoadFile(path.c_str(), &size);
+    if (!file) return nullptr; // not cooked
+    SDL_Surface* surf = CookedTexture::Load(static_cast<const uint8_t*>(file), size);
+    if (!surf) SYSTEM_LOG << "DataManager: invalid cooked texture '" << path << "' : " << SDL_GetError() << "\n";
+    SDL_free(file);
+    return surf;
+}
+//-------------------------------------------------------------
+bool DataManager::PreloadSprite(const std::string& id, const std::string& path, ResourceCategory category, ResourceHandle* outHandle)
+{
+	return PreloadTexture(id, path, category, outHandle);
 }
 //-------------------------------------------------------------
 SDL_Texture* DataManager::GetTexture(const std::string& id) const
 {
     std::lock_guard<std::mutex> lock(m_mutex_);
-    auto it = m_resources_.find(id);
+    auto it = m_resources_.find(Symbol::Find(id));
     if (it == m_resources_.end()) return nullptr;
     auto res = it->second;
+    if (res->atlasPage >= 0)
+    {
+        // the page alone would draw every sprite packed in it
+        SYSTEM_LOG << "DataManager::GetTexture: '" << id << "' is packed in a sprite atlas, use GetSpriteRegion()\n";
+        return nullptr;
+    }
+    if (res->handle.IsValid()) TouchSlot(m_slots_[res->handle.index]);
     if (res->texture) return res->texture;
 
+    // evicted to fit the memory budget: reloaded by the next ProcessResidency()
+    if (res->state == ResourceState::Evicted)
+    {
+        if (res->handle.IsValid()) RequestReload(m_slots_[res->handle.index]);
+        return GetPlaceholderTexture();
+    }
+    // asynchronous load in progress: the upload is done within the frame budget by ProcessPendingUploads()
+    if (res->state == ResourceState::Loading || res->state == ResourceState::Decoded) return GetPlaceholderTexture();
+
     // If texture not created yet but we have a surface stored, try to create it now
     if (res->data)
     {
@@ -152,6 +1058,8 @@ SDL_Texture* DataManager::GetTexture(const std::string& id) const
                 // we can free the surface now
                 SDL_DestroySurface(surf);
                 res->data = nullptr;
+                AccountTexture(*res);
+                PublishSlot(*res);
                 return res->texture;
             }
             else
@@ -169,8 +1077,14 @@ SDL_Texture* DataManager::GetSprite(const std::string& id, const std::string& pa
     // Optimized: Check existence without locking twice
     {
         std::lock_guard<std::mutex> lock(m_mutex_);
-        auto it = m_resources_.find(id);
+        auto it = m_resources_.find(Symbol::Find(id));
+        if (it != m_resources_.end() && it->second->atlasPage >= 0)
+        {
+            SYSTEM_LOG << "DataManager::GetSprite: '" << id << "' is packed in a sprite atlas, use GetSpriteRegion()\n";
+            return nullptr;
+        }
         if (it != m_resources_.end() && it->second->texture) {
+            if (it->second->handle.IsValid()) TouchSlot(m_slots_[it->second->handle.index]);
             return it->second->texture;
         }
     }
@@ -183,18 +1097,140 @@ SDL_Texture* DataManager::GetSprite(const std::string& id, const std::string& pa
     return nullptr;
 }
 //-------------------------------------------------------------
+bool DataManager::GetSpriteRegion(const std::string& id, const std::string& path, SDL_Texture*& outTexture, SDL_FRect& outSrcRect, ResourceCategory category, ResourceHandle* outHandle)
+{
+    outTexture = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        auto it = m_resources_.find(Symbol::Find(id));
+        if (it != m_resources_.end() && outHandle) *outHandle = it->second->handle;
+        if (it != m_resources_.end() && it->second->handle.IsValid())
+        {
+            ResourceSlot& slot = m_slots_[it->second->handle.index];
+            TouchSlot(slot);
+            if (it->second->state == ResourceState::Evicted) RequestReload(slot);
+        }
+        if (it != m_resources_.end() && it->second->texture)
+        {
+            const Resource& res = *it->second;
+            outTexture = res.texture;
+            outSrcRect = (res.atlasPage >= 0) ? res.srcRect : SDL_FRect{ 0.0f, 0.0f, static_cast<float>(res.texture->w), static_cast<float>(res.texture->h) };
+            return true;
+        }
+        if (it != m_resources_.end()) return false; // pending async load or failed
+    }
+
+    SDL_Renderer* renderer = GameEngine::renderer;
+    if (path.empty() || !renderer) return false;
+
+    SDL_Surface* surf = LoadSurface(path);
+    if (!surf)
+    {
+        SYSTEM_LOG << "DataManager::GetSpriteRegion IMG_Load failed for '" << path << "' : " << SDL_GetError() << "\n";
+        return false;
+    }
+
+    auto res = std::make_shared<Resource>();
+    res->type = ResourceType::Sprite;
+    res->category = category;
+    res->id = id;
+    res->path = path;
+
+    // cooked sprites are premultiplied: they don't share the (straight alpha) atlas pages
+    SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+    SDL_GetSurfaceBlendMode(surf, &blendMode);
+    AtlasRegion region;
+    if (m_useAtlas_ && blendMode != SDL_BLENDMODE_BLEND_PREMULTIPLIED && m_atlas_.Insert(id, surf, region))
+    {
+        m_atlas_.Flush(renderer);
+        res->atlasPage = region.page;
+        res->srcRect = region.srcRect;
+        res->texture = m_atlas_.GetPageTexture(region.page);
+    }
+    else
+    {
+        // too big for the atlas: standalone texture
+        res->texture = SDL_CreateTextureFromSurface(renderer, surf);
+        if (res->texture) res->srcRect = { 0.0f, 0.0f, static_cast<float>(surf->w), static_cast<float>(surf->h) };
+    }
+    SDL_DestroySurface(surf);
+    if (!res->texture)
+    {
+        SYSTEM_LOG << "DataManager::GetSpriteRegion failed to create texture for '" << path << "' : " << SDL_GetError() << "\n";
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        m_resources_.emplace(id, res);
+        AllocateSlot(*res);
+        AccountTexture(*res);
+        WatchResource(*res);
+        if (outHandle) *outHandle = res->handle;
+    }
+    SYSTEM_LOG << "DataManager: Loaded sprite '" << id << "' from '" << path << "'" << (res->atlasPage >= 0 ? " (atlas)" : "") << "\n";
+    outTexture = res->texture;
+    outSrcRect = res->srcRect;
+    return true;
+}
+//-------------------------------------------------------------
+bool DataManager::SaveSpriteAtlas(const std::string& basePath) const
+{
+    auto pos = basePath.find_last_of("/\\");
+    if (pos != std::string::npos) EnsureDirectoryExists(basePath.substr(0, pos));
+    return m_atlas_.Save(basePath);
+}
+//-------------------------------------------------------------
+bool DataManager::LoadSpriteAtlas(const std::string& jsonPath, ResourceCategory category)
+{
+    // loading replaces the pages: sprites already packed would point to destroyed textures
+    if (m_atlas_.GetPageCount() > 0)
+    {
+        SYSTEM_LOG << "DataManager: LoadSpriteAtlas '" << jsonPath << "' ignored, the sprite atlas is already in use\n";
+        return false;
+    }
+    if (!m_atlas_.Load(jsonPath))
+    {
+        SYSTEM_LOG << "DataManager: failed to load sprite atlas '" << jsonPath << "'\n";
+        return false;
+    }
+    m_atlas_.Flush(GameEngine::renderer);
+
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    for (const auto& kv : m_atlas_.GetRegions())
+    {
+        if (m_resources_.find(Symbol::Find(kv.first)) != m_resources_.end()) continue;
+        auto res = std::make_shared<Resource>();
+        res->type = ResourceType::Sprite;
+        res->category = category;
+        res->id = kv.first;
+        res->path = jsonPath;
+        res->atlasPage = kv.second.page;
+        res->srcRect = kv.second.srcRect;
+        res->texture = m_atlas_.GetPageTexture(kv.second.page);
+        m_resources_.emplace(kv.first, res);
+        AllocateSlot(*res);
+    }
+    SYSTEM_LOG << "DataManager: Loaded sprite atlas '" << jsonPath << "' (" << m_atlas_.GetPageCount() << " pages, " << m_atlas_.GetRegions().size() << " sprites)\n";
+    return true;
+}
+//-------------------------------------------------------------
 bool DataManager::ReleaseResource(const std::string& id)
 {
     std::lock_guard<std::mutex> lock(m_mutex_);
-    auto it = m_resources_.find(id);
+    auto it = m_resources_.find(Symbol::Find(id));
     if (it == m_resources_.end()) return false;
     auto res = it->second;
 
-    if (res->texture)
+    UnaccountTexture(*res);
+    UnwatchResource(*res);
+    res->hotReload = false;
+    // atlas pages are shared: the region is simply left unused
+    if (res->texture && res->atlasPage < 0)
     {
         SDL_DestroyTexture(res->texture);
-        res->texture = nullptr;
     }
+    res->texture = nullptr;
     if (res->data)
     {
         // if it was a surface store, free it
@@ -202,6 +1238,10 @@ bool DataManager::ReleaseResource(const std::string& id)
         if (surf) SDL_DestroySurface(surf);
         res->data = nullptr;
     }
+    // pending async load: waiters get nullptr, the worker drops its result
+    res->state = ResourceState::Failed;
+    CompleteLoad(*res, nullptr);
+    FreeSlot(*res);
 
     m_resources_.erase(it);
     SYSTEM_LOG << "DataManager: Released resource '" << id << "'\n";
@@ -214,25 +1254,34 @@ void DataManager::UnloadAll()
     for (auto& kv : m_resources_)
     {
         auto res = kv.second;
-        if (res->texture)
+        UnaccountTexture(*res);
+        UnwatchResource(*res);
+        res->hotReload = false;
+        if (res->texture && res->atlasPage < 0)
         {
             SDL_DestroyTexture(res->texture);
-            res->texture = nullptr;
         }
+        res->texture = nullptr;
         if (res->data)
         {
             SDL_Surface* surf = reinterpret_cast<SDL_Surface*>(res->data);
             if (surf) SDL_DestroySurface(surf);
             res->data = nullptr;
         }
+        res->state = ResourceState::Failed;
+        CompleteLoad(*res, nullptr);
+        FreeSlot(*res);
     }
     m_resources_.clear();
+    m_residentBytes_.fill(0);
+    for (auto& q : m_pendingUploads_) q.clear();
+    m_atlas_.Clear();
 }
 //-------------------------------------------------------------
 bool DataManager::HasResource(const std::string& id) const
 {
     std::lock_guard<std::mutex> lock(m_mutex_);
-    return m_resources_.find(id) != m_resources_.end();
+    return m_resources_.find(Symbol::Find(id)) != m_resources_.end();
 }
 //-------------------------------------------------------------
 std::vector<std::string> DataManager::ListResourcesByType(ResourceType type) const
@@ -243,7 +1292,7 @@ std::vector<std::string> DataManager::ListResourcesByType(ResourceType type) con
     out.reserve(m_resources_.size());
     for (const auto& kv : m_resources_)
     {
-        if (kv.second->type == type) out.push_back(kv.first);
+        if (kv.second->type == type) out.push_back(kv.first.str());
     }
     return out;
 }
@@ -256,7 +1305,7 @@ std::vector<std::string> DataManager::ListResourcesByCategory(ResourceCategory c
     out.reserve(m_resources_.size());
     for (const auto& kv : m_resources_)
     {
-        if (kv.second->category == category) out.push_back(kv.first);
+        if (kv.second->category == category) out.push_back(kv.first.str());
     }
     return out;
 }
@@ -295,8 +1344,25 @@ bool DataManager::LoadTextFile(const std::string& filepath, std::string& outCont
 {
     outContent.clear();
     if (filepath.empty()) return false;
+
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    std::vector<uint8_t> buffer;
+    bool looseFirst = false;
+    const bool packed = ReadFromArchives(filepath, data, size, buffer, looseFirst);
+    if (packed && !looseFirst)
+    {
+        outContent.assign(reinterpret_cast<const char*>(data), size);
+        return true;
+    }
+
     std::ifstream ifs(filepath.c_str(), std::ios::binary);
-    if (!ifs) return false;
+    if (!ifs)
+    {
+        if (!packed) return false;
+        outContent.assign(reinterpret_cast<const char*>(data), size);
+        return true;
+    }
     std::ostringstream ss;
     ss << ifs.rdbuf();
     outContent = ss.str();
@@ -378,9 +1444,55 @@ bool DataManager::PreloadSystemResources(const std::string& configFilePath)
     try
     {
         nlohmann::json root = nlohmann::json::parse(content);
+        if (root.contains("archives") && root["archives"].is_array())
+        {
+            const auto& archives = root["archives"];
+            for (size_t i = 0; i < archives.size(); ++i)
+            {
+                if (!archives[i].is_string()) continue;
+                const std::string path = archives[i].get<std::string>();
+                bool mounted = false;
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex_);
+                    for (const auto& a : m_archives_) mounted = mounted || a->GetPath() == path;
+                }
+                if (!mounted) MountArchive(path);
+            }
+        }
+        if (root.contains("hot_reload") && root["hot_reload"].is_boolean()) SetHotReloadEnabled(root["hot_reload"].get<bool>());
+        {
+            // a change of this file applies it again (new resources, budgets)
+            std::lock_guard<std::mutex> lock(m_mutex_);
+            if (m_systemConfigPath_ != configFilePath)
+            {
+                if (m_fileWatcher_ && !m_systemConfigPath_.empty()) m_fileWatcher_->Unwatch(m_systemConfigPath_);
+                m_systemConfigPath_ = configFilePath;
+                if (m_fileWatcher_) m_fileWatcher_->Watch(m_systemConfigPath_);
+            }
+        }
+        if (root.contains("memory_budgets_mb") && root["memory_budgets_mb"].is_object())
+        {
+            const auto& budgets = root["memory_budgets_mb"];
+            const char* keys[k_RESOURCE_CATEGORY_COUNT] = { "system", "gameobject", "level" };
+            for (size_t c = 0; c < k_RESOURCE_CATEGORY_COUNT; ++c)
+            {
+                if (!budgets.contains(keys[c]) || !budgets[keys[c]].is_number()) continue;
+                const int mb = budgets[keys[c]].get<int>();
+                SetMemoryBudget(static_cast<ResourceCategory>(c), mb > 0 ? static_cast<size_t>(mb) * 1024 * 1024 : 0);
+            }
+        }
         if (!root.contains("system_resources")) return true; // nothing to do
         const auto& arr = root["system_resources"];
         if (!arr.is_array()) return false;
+
+        struct Preload
+        {
+            std::string id;
+            std::string path;
+            ResourceCategory category;
+            SDL_Surface* surf;
+        };
+        std::vector<Preload> preloads;
         for (size_t i = 0; i < arr.size(); ++i)
         {
             const auto& item = arr[i];
@@ -389,19 +1501,34 @@ bool DataManager::PreloadSystemResources(const std::string& configFilePath)
             std::string path = item.contains("path") ? item["path"].get<std::string>() : std::string();
             std::string type = item.contains("type") ? item["type"].get<std::string>() : std::string();
             if (id.empty() || path.empty()) continue;
-            if (type == "texture")
+            const bool async = item.contains("async") && item["async"].is_boolean() && item["async"].get<bool>();
+            const ResourceCategory category = (type == "texture") ? ResourceCategory::Level
+                : (type == "sprite" || type == "animation") ? ResourceCategory::GameObject : ResourceCategory::System;
+            if (async)
             {
-                PreloadTexture(id, path, ResourceCategory::Level);
+                // decoded on workers, uploaded over the next frames
+                LoadTextureAsync(id, path, JobPriority::Low, category);
             }
             else
-                if (type == "sprite" || type == "animation")
-                {
-                    PreloadSprite(id, path, ResourceCategory::GameObject);
-				}
-                else
-                {
-                    PreloadTexture(id, path, ResourceCategory::System);
-                }
+            {
+                preloads.push_back({ id, path, category, nullptr });
+            }
+        }
+
+        // synchronous entries: decoded in parallel (JobSystem workers and this thread), then registered in order
+        JobSystem::Get().ParallelFor(preloads.size(), 1, [this, &preloads](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                Preload& p = preloads[i];
+                if (HasResource(p.id)) continue; // already loaded
+                p.surf = LoadSurface(p.path);
+                if (!p.surf) SYSTEM_LOG << "DataManager::PreloadSystemResources IMG_Load failed for '" << p.path << "' : " << SDL_GetError() << "\n";
+            }
+        });
+        for (Preload& p : preloads)
+        {
+            if (p.surf) AddDecodedTexture(p.id, p.path, p.category, p.surf);
         }
     }
     catch (const std::exception& e)
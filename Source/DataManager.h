@@ -19,18 +19,68 @@ Notes:
 - JSON serialization of complex objects is expected to be done by
   calling code; DataManager provides file IO helpers and a directory
   layout convention: "./Gamedata/{videogameName}/{objectName}.json".
+- LoadTextureAsync() decodes images on JobSystem workers; the GPU upload
+  happens on the main thread in ProcessPendingUploads() within a per-frame
+  time budget. Until then GetTexture() returns a placeholder texture.
+- Small sprites requested with GetSpriteRegion() are packed into shared
+  TextureAtlas pages: the returned texture is the page and the source rect
+  locates the sprite in it. Atlases can also be baked offline and loaded
+  with LoadSpriteAtlas().
+- Every resource owns a slot in a fixed array: the ResourceHandle returned
+  at load time (or by GetHandle()) resolves with atomic reads of that slot,
+  without hashing the id or taking the mutex. String ids are only hashed
+  once, when the handle is obtained.
+- Residency: each ResourceCategory has a texture memory budget (estimated
+  from the texture size and pixel format, 0 = unlimited). When a category
+  goes over budget, ProcessResidency() evicts its least recently used
+  textures that are not pinned. The resource and its handle stay valid:
+  the next lookup reloads the texture asynchronously from its path and the
+  placeholder is returned meanwhile. Code keeping a raw SDL_Texture* across
+  frames must Pin() the resource; handle users (Sprite) resolve the texture
+  every frame and don't need to. Atlas pages are shared, never evicted.
+- Hot reload (SetHotReloadEnabled, on by default in debug builds): the
+  files behind the loaded resources are watched (FileWatcher). A changed
+  texture is decoded again on a worker while the current one stays in use,
+  then ProcessPendingUploads() updates it in place (same size: the texture
+  pointer doesn't change) or swaps it, and an
+  Olympe_EventType_Resource_Reloaded message is posted. Changed data files
+  registered with WatchDataFile() only post the message; a change of the
+  system resources config applies it again.
+- Asset archives (AssetArchive, built with "OlympeAssetTool pack"): mounted
+  archives are memory mapped and searched before the loose files by
+  LoadSurface() (all image loads) and LoadTextFile(). "Resources.opak" is
+  mounted by Initialize() when present, others with MountArchive() or the
+  "archives" list of the system resources config. Files written at runtime
+  (save games, olympe.ini) must stay out of the archives: the packed copy
+  would hide them. With hot reload on, loose files come first.
+- Cooked textures (CookedTexture, built with "OlympeAssetTool cook"): when
+  "<path>.otex" exists LoadSurface() loads it instead of decoding <path>.
+  Cooked sprites are premultiplied and stay out of the atlas pages. Cooked
+  files are ignored while hot reload is on. Loose .otex files are looked up
+  in a listing of their directory made once, not with a file open per image.
 */
 
 #pragma once
 
 #include "object.h"
 #include "system/system_utils.h"
+#include "system/JobSystem.h"
+#include "TextureAtlas.h"
+#include "ResourceHandle.h"
+#include "system/Symbol.h"
+#include "system/FileWatcher.h"
+#include "AssetArchive.h"
 #include <SDL3/SDL.h>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <mutex>
 #include <vector>
+#include <deque>
+#include <array>
+#include <future>
+#include <atomic>
 #include "third_party/nlohmann/json.hpp"
 
 // Catgories et types de ressources
@@ -57,18 +107,41 @@ enum class ResourceCategory : uint32_t
     Level         // level / map data
 };
 
+// Loading state of a resource (textures loaded asynchronously go through Loading -> Decoded -> Ready)
+enum class ResourceState : uint32_t
+{
+    Ready = 0,  // usable
+    Loading,    // decode queued or running on a worker
+    Decoded,    // surface decoded, waiting for the GPU upload (main thread)
+    Failed,
+    Evicted     // texture released to fit the memory budget, reloaded from 'path' on next lookup
+};
+
 // Generic resource container
 struct Resource
 {
     ResourceType type = ResourceType::Unknown;
     ResourceCategory category = ResourceCategory::System;
-    std::string id;   // logical identifier
+    Symbol id;        // logical identifier (interned)
     std::string path; // filesystem path
 
     // data payloads depending on the resource type
     SDL_Texture* texture = nullptr; // for texture/sprite resources
     void* data = nullptr;           // generic pointer for deferred objects
 
+    // atlas packed sprites: 'texture' is the shared page (not owned by the resource)
+    int atlasPage = -1;
+    SDL_FRect srcRect = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+    ResourceState state = ResourceState::Ready;
+    // async texture loads: completed with the texture (nullptr on failure) once uploaded
+    std::shared_ptr<std::promise<SDL_Texture*>> loadPromise;
+    std::shared_future<SDL_Texture*> loadFuture;
+
+    ResourceHandle handle; // slot in DataManager's handle table
+    size_t vramBytes = 0;  // estimated GPU memory of the owned texture (0 for atlas regions)
+    bool hotReload = false; // changed file being decoded again, 'texture' stays in use until the swap
+
     Resource() = default;
     ~Resource() = default;
 };
@@ -89,12 +162,78 @@ public:
     void Shutdown();
 
     // Texture loading / retrieval / release
-    bool PreloadTexture(const std::string& id, const std::string& path, ResourceCategory category = ResourceCategory::System);
-	bool PreloadSprite(const std::string& id, const std::string& path, ResourceCategory category = ResourceCategory::GameObject);
+    bool PreloadTexture(const std::string& id, const std::string& path, ResourceCategory category = ResourceCategory::System,
+        ResourceHandle* outHandle = nullptr);
+	bool PreloadSprite(const std::string& id, const std::string& path, ResourceCategory category = ResourceCategory::GameObject,
+        ResourceHandle* outHandle = nullptr);
+    // Whole texture resources only: atlas packed sprites return nullptr (use GetSpriteRegion)
     SDL_Texture* GetTexture(const std::string& id) const;
 	SDL_Texture* GetSprite(const std::string& id, const std::string& path, ResourceCategory category = ResourceCategory::GameObject);
     bool ReleaseResource(const std::string& id);
 
+    // Sprite lookup returning the texture to bind and the source rect of the sprite in it.
+    // Small images are packed into the sprite atlas, bigger ones get their own texture (full rect).
+    bool GetSpriteRegion(const std::string& id, const std::string& path, SDL_Texture*& outTexture, SDL_FRect& outSrcRect,
+        ResourceCategory category = ResourceCategory::GameObject, ResourceHandle* outHandle = nullptr);
+
+    // Handle based lookups: lock-free array reads, for per-frame render paths.
+    // Textures still loading resolve to the placeholder texture (full rect).
+    ResourceHandle GetHandle(const std::string& id) const;
+    bool IsValid(ResourceHandle handle) const;
+    SDL_Texture* GetTexture(ResourceHandle handle) const;
+    bool GetSpriteRegion(ResourceHandle handle, SDL_Texture*& outTexture, SDL_FRect& outSrcRect) const;
+    void SetUseSpriteAtlas(bool b) { m_useAtlas_ = b; }
+    TextureAtlas& GetSpriteAtlas() { return m_atlas_; }
+    // Offline baked atlas: "<basePath>.json" + "<basePath>_<n>.png"
+    bool SaveSpriteAtlas(const std::string& basePath) const;
+    bool LoadSpriteAtlas(const std::string& jsonPath, ResourceCategory category = ResourceCategory::GameObject);
+
+    // Asynchronous texture loading: decode on a worker, upload on the main thread in ProcessPendingUploads().
+    // The future is completed with the texture (or nullptr on failure). Loading an id already known returns its state.
+    std::shared_future<SDL_Texture*> LoadTextureAsync(const std::string& id, const std::string& path,
+        JobPriority priority = JobPriority::Normal, ResourceCategory category = ResourceCategory::System);
+    // Upload decoded surfaces to the GPU (main thread, once per frame) until the time budget is spent
+    void ProcessPendingUploads();
+    void SetUploadBudgetMs(float ms) { m_uploadBudgetMs = ms; }
+    float GetUploadBudgetMs() const { return m_uploadBudgetMs; }
+    size_t GetPendingUploadCount() const;
+    bool IsTextureReady(const std::string& id) const;
+    // Texture returned by GetTexture() while an asynchronous load is pending
+    SDL_Texture* GetPlaceholderTexture() const;
+
+
+    // Residency: per category texture memory budgets with LRU eviction of unpinned textures
+    // Once per frame (main thread), after ProcessPendingUploads(): reloads evicted textures that were looked up, then evicts
+    void ProcessResidency();
+    void SetMemoryBudget(ResourceCategory category, size_t bytes); // 0 = unlimited
+    size_t GetMemoryBudget(ResourceCategory category) const;
+    size_t GetResidentBytes(ResourceCategory category) const;
+    uint32_t GetEvictionCount() const { return m_evictionCount_; }
+    // Pinned resources are never evicted. Pins are counted and dropped when the resource is released.
+    bool Pin(const std::string& id);
+    bool Unpin(const std::string& id);
+    bool Pin(ResourceHandle handle);   // lock-free
+    bool Unpin(ResourceHandle handle); // lock-free
+    static size_t EstimateTextureBytes(const SDL_Texture* texture);
+
+    // Hot reload of the files behind the loaded resources (see notes above)
+    void SetHotReloadEnabled(bool enable);
+    bool IsHotReloadEnabled() const { return m_hotReloadEnabled_.load(std::memory_order_acquire); }
+    // JSON / data files read by the calling code: a change posts Olympe_EventType_Resource_Reloaded (path in the message payload)
+    void WatchDataFile(const std::string& path);
+    void UnwatchDataFile(const std::string& path);
+    // Once per frame (main thread), before ProcessPendingUploads(): queues the decode of the changed files
+    void ProcessHotReload();
+
+    // Asset archives: the last mounted archive is searched first, then the loose files
+    bool MountArchive(const std::string& path);
+    void UnmountArchives(); // no load may be in flight (mapped data is released)
+    size_t GetMountedArchiveCount() const;
+    // Main thread, once a renderer exists: creates the textures of the images preloaded without renderer
+    // (PreloadTexture / PreloadSystemResources called before the renderer creation keep the decoded surface)
+    void UploadDeferredTextures();
+    // Decode an image from the mounted archives or from the disk (any thread)
+    SDL_Surface* LoadSurface(const std::string& path) const;
 
     // Resource helpers
     void UnloadAll();
@@ -122,9 +261,93 @@ public:
     // Preload system resources from a configuration JSON file (e.g. "olympe.ini")
     // Expected format:
     // { "system_resources": [ { "id":"ui_icon", "path":"assets/ui/icon.bmp", "type":"texture" }, ... ] }
+    // Entries with "async": true are loaded with LoadTextureAsync(), the others are decoded in parallel
+    // (JobSystem) before the function returns. Without renderer the textures are created by UploadDeferredTextures().
+    // Optional budgets: { "memory_budgets_mb": { "system":0, "gameobject":256, "level":512 } }
+    // Optional hot reload switch: { "hot_reload": true }
+    // Optional archives, mounted first: { "archives": [ "Levels.opak", ... ] }
     bool PreloadSystemResources(const std::string& configFilePath);
 
 private:
+    void CompleteLoad(Resource& res, SDL_Texture* tex); // expects m_mutex_ locked
+    // registers a texture decoded by the caller (takes the surface), uploaded now if there is a renderer
+    bool AddDecodedTexture(const std::string& id, const std::string& path, ResourceCategory category, SDL_Surface* surf, ResourceHandle* outHandle = nullptr);
+    void QueueDecode(const std::shared_ptr<Resource>& res, JobPriority priority); // decode 'path' on a worker
+    void UploadHotReload(const std::shared_ptr<Resource>& res, SDL_Surface* surf); // main thread, m_mutex_ not locked
+    void WatchResource(const Resource& res);   // expects m_mutex_ locked
+    void UnwatchResource(const Resource& res); // expects m_mutex_ locked
+    void PostReloaded(const Symbol& id, const std::string& path);
+    // Content of 'path' in the mounted archives (in place or decompressed into 'buffer')
+    bool ReadFromArchives(const std::string& path, const uint8_t*& outData, size_t& outSize, std::vector<uint8_t>& buffer, bool& outLooseFirst) const;
+    SDL_Surface* LoadCookedSurface(const std::string& path) const; // nullptr if there is no such cooked file
+    bool HasCookedFile(const std::string& cookedPath) const; // in an archive or in the loose cooked file index
+
+    // Handle table: fixed size so that readers never see it reallocated.
+    // Writers (expect m_mutex_ locked) update texture / state / source rect together inside a
+    // per-slot seqlock (WriteSlot), readers (ReadSlot) retry until they get a consistent copy and
+    // check the generation before and after reading the slot.
+    struct ResourceSlot
+    {
+        std::atomic<uint32_t> generation{ 0 };
+        std::atomic<uint32_t> sequence{ 0 };  // odd while the fields below are being written
+        std::atomic<SDL_Texture*> texture{ nullptr };
+        std::atomic<uint32_t> state{ 0 };     // ResourceState
+        std::atomic<uint64_t> srcPos{ 0 };    // source rect x, y (float bits)
+        std::atomic<uint64_t> srcSize{ 0 };   // source rect w, h
+        std::atomic<uint32_t> lastUsedFrame{ 0 };   // LRU stamp, written by the lookups
+        std::atomic<uint32_t> pinCount{ 0 };
+        std::atomic<uint32_t> reloadRequested{ 0 }; // evicted texture looked up since the last ProcessResidency()
+    };
+    static const uint32_t k_MAX_RESOURCE_SLOTS = 16384;
+    void AllocateSlot(Resource& res);       // expects m_mutex_ locked
+    void PublishSlot(const Resource& res) const; // texture / state changed, expects m_mutex_ locked
+    void FreeSlot(Resource& res);           // expects m_mutex_ locked
+    static void WriteSlot(ResourceSlot& slot, SDL_Texture* tex, ResourceState state, const SDL_FRect& src); // single writer
+    static void ReadSlot(const ResourceSlot& slot, SDL_Texture*& outTex, ResourceState& outState, SDL_FRect& outSrc);
+    void TouchSlot(ResourceSlot& slot) const;
+    void RequestReload(ResourceSlot& slot) const;
+
+    // residency accounting (expect m_mutex_ locked)
+    static const size_t k_RESOURCE_CATEGORY_COUNT = 3;
+    void AccountTexture(Resource& res) const;   // after the texture is set
+    void UnaccountTexture(Resource& res) const; // before the texture is destroyed
+    void EvictCategory(size_t category, uint32_t frame);
+
     mutable std::mutex m_mutex_;
-    std::unordered_map<std::string, std::shared_ptr<Resource>> m_resources_;
+    std::unordered_map<Symbol, std::shared_ptr<Resource>> m_resources_;
+    std::unique_ptr<ResourceSlot[]> m_slots_;
+    uint32_t m_slotCount_ = 0;          // slots used at least once
+    std::vector<uint32_t> m_freeSlots_; // released slots, reused first
+
+    // decoded surfaces waiting for upload, one FIFO per priority (protected by m_mutex_)
+    std::array<std::deque<std::weak_ptr<Resource>>, static_cast<size_t>(JobPriority::Count)> m_pendingUploads_;
+    float m_uploadBudgetMs = 2.0f;
+    mutable SDL_Texture* m_placeholderTexture_ = nullptr; // created on first use (main thread)
+
+    // residency
+    std::atomic<uint32_t> m_frameStamp_{ 1 };
+    mutable std::atomic<uint32_t> m_reloadRequests_{ 0 };
+    std::array<size_t, k_RESOURCE_CATEGORY_COUNT> m_memoryBudget_;
+    mutable std::array<size_t, k_RESOURCE_CATEGORY_COUNT> m_residentBytes_; // protected by m_mutex_
+    std::array<bool, k_RESOURCE_CATEGORY_COUNT> m_budgetWarned_;
+    uint32_t m_evictionCount_ = 0;
+
+    // hot reload (watcher created / destroyed and only dereferenced under m_mutex_;
+    // the flag mirrors it for the lock-free early outs and is written under m_mutex_ too)
+    std::unique_ptr<FileWatcher> m_fileWatcher_;
+    std::atomic<bool> m_hotReloadEnabled_{ false };
+    std::vector<std::string> m_changedFiles_;
+    std::string m_systemConfigPath_;
+
+    // mounted asset archives (list protected by m_mutex_, mappings read without locking)
+    std::vector<std::unique_ptr<AssetArchive>> m_archives_;
+
+    // loose cooked files: directory -> names of its .otex files, listed on first use
+    // (own mutex: the listing is not done under m_mutex_; cleared when hot reload is toggled)
+    mutable std::mutex m_cookedIndexMutex_;
+    mutable std::unordered_map<std::string, std::unordered_set<std::string>> m_cookedIndex_;
+
+    // sprite atlas pages (main thread only)
+    TextureAtlas m_atlas_;
+    bool m_useAtlas_ = true;
 };
@@ -0,0 +1,239 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- Implementation of DebugDraw (primitive recording and batched submission).
+*/
+
+#include "DebugDraw.h"
+#include "OptionsManager.h"
+#include "system/system_utils.h"
+#include "system/system_consts.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    inline SDL_FColor ToFColor(const SDL_Color& c)
+    {
+        return { c.r / 255.0f, c.g / 255.0f, c.b / 255.0f, c.a / 255.0f };
+    }
+    inline uint32_t PackColor(const SDL_Color& c)
+    {
+        return (static_cast<uint32_t>(c.r) << 24) | (static_cast<uint32_t>(c.g) << 16) | (static_cast<uint32_t>(c.b) << 8) | c.a;
+    }
+    inline void AddQuadIndices(std::vector<int>& indices, int v)
+    {
+        indices.push_back(v); indices.push_back(v + 1); indices.push_back(v + 2);
+        indices.push_back(v); indices.push_back(v + 2); indices.push_back(v + 3);
+    }
+}
+
+//-------------------------------------------------------------
+DebugDraw::DebugDraw()
+{
+    name = "DebugDraw";
+    SYSTEM_LOG << "DebugDraw created\n";
+}
+//-------------------------------------------------------------
+DebugDraw::~DebugDraw()
+{
+    SYSTEM_LOG << "DebugDraw destroyed\n";
+}
+//-------------------------------------------------------------
+DebugDraw& DebugDraw::GetInstance()
+{
+    static DebugDraw instance;
+    return instance;
+}
+//-------------------------------------------------------------
+void DebugDraw::Begin(SDL_Renderer* renderer)
+{
+    // disabled overlay: keep m_renderer null so that every Add call returns immediately
+    m_renderer = OptionsManager::Get().IsSet(OptionFlags::ShowDebugInfo) ? renderer : nullptr;
+    m_fillVertices.clear();
+    m_fillIndices.clear();
+    m_lineVertices.clear();
+    m_lineIndices.clear();
+    m_points.clear();
+    m_primitives = 0;
+}
+//-------------------------------------------------------------
+int DebugDraw::CircleSegments(float radius)
+{
+    // about one segment per 4 pixels of perimeter
+    const int n = static_cast<int>(2.0f * k_PI * radius / 4.0f);
+    return std::max(12, std::min(n, 96));
+}
+//-------------------------------------------------------------
+int DebugDraw::AddVertex(std::vector<SDL_Vertex>& vertices, float x, float y, const SDL_FColor& color)
+{
+    vertices.push_back({ { x, y }, color, { 0.0f, 0.0f } });
+    return static_cast<int>(vertices.size()) - 1;
+}
+//-------------------------------------------------------------
+void DebugDraw::Line(float x0, float y0, float x1, float y1, const SDL_Color& color)
+{
+    if (!m_renderer) return;
+    ++m_primitives;
+
+    // 1 pixel wide quad along the segment
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    const float len = std::sqrt(dx * dx + dy * dy);
+    if (len < 0.0001f) { dx = 1.0f; dy = 0.0f; }
+    else { dx /= len; dy /= len; }
+    const float nx = -dy * 0.5f;
+    const float ny = dx * 0.5f;
+
+    const SDL_FColor c = ToFColor(color);
+    const int v = AddVertex(m_lineVertices, x0 + nx, y0 + ny, c);
+    AddVertex(m_lineVertices, x1 + nx, y1 + ny, c);
+    AddVertex(m_lineVertices, x1 - nx, y1 - ny, c);
+    AddVertex(m_lineVertices, x0 - nx, y0 - ny, c);
+    AddQuadIndices(m_lineIndices, v);
+}
+//-------------------------------------------------------------
+void DebugDraw::Point(float x, float y, const SDL_Color& color)
+{
+    if (!m_renderer) return;
+    ++m_primitives;
+    m_points.push_back({ PackColor(color), { x, y } });
+}
+//-------------------------------------------------------------
+void DebugDraw::Rect(const SDL_FRect& rect, const SDL_Color& color)
+{
+    if (!m_renderer) return;
+    ++m_primitives;
+
+    // 4 axis aligned 1 pixel wide bands, same pixels as SDL_RenderRect
+    const SDL_FColor c = ToFColor(color);
+    const SDL_FRect bands[4] = {
+        { rect.x, rect.y, rect.w, 1.0f },
+        { rect.x, rect.y + rect.h - 1.0f, rect.w, 1.0f },
+        { rect.x, rect.y + 1.0f, 1.0f, rect.h - 2.0f },
+        { rect.x + rect.w - 1.0f, rect.y + 1.0f, 1.0f, rect.h - 2.0f }
+    };
+    for (const SDL_FRect& b : bands)
+    {
+        if (b.w <= 0.0f || b.h <= 0.0f) continue;
+        const int v = AddVertex(m_lineVertices, b.x, b.y, c);
+        AddVertex(m_lineVertices, b.x + b.w, b.y, c);
+        AddVertex(m_lineVertices, b.x + b.w, b.y + b.h, c);
+        AddVertex(m_lineVertices, b.x, b.y + b.h, c);
+        AddQuadIndices(m_lineIndices, v);
+    }
+}
+//-------------------------------------------------------------
+void DebugDraw::FilledRect(const SDL_FRect& rect, const SDL_Color& color)
+{
+    if (!m_renderer) return;
+    ++m_primitives;
+
+    const SDL_FColor c = ToFColor(color);
+    const int v = AddVertex(m_fillVertices, rect.x, rect.y, c);
+    AddVertex(m_fillVertices, rect.x + rect.w, rect.y, c);
+    AddVertex(m_fillVertices, rect.x + rect.w, rect.y + rect.h, c);
+    AddVertex(m_fillVertices, rect.x, rect.y + rect.h, c);
+    AddQuadIndices(m_fillIndices, v);
+}
+//-------------------------------------------------------------
+void DebugDraw::Circle(float cx, float cy, float radius, const SDL_Color& color)
+{
+    if (!m_renderer) return;
+
+    const int segments = CircleSegments(radius);
+    const float step = static_cast<float>(2.0 * k_PI / segments);
+    float px = cx + radius;
+    float py = cy;
+    for (int i = 1; i <= segments; ++i)
+    {
+        const float x = cx + radius * std::cos(step * i);
+        const float y = cy + radius * std::sin(step * i);
+        Line(px, py, x, y, color);
+        px = x;
+        py = y;
+    }
+    m_primitives -= segments - 1; // counted as one primitive
+}
+//-------------------------------------------------------------
+void DebugDraw::FilledCircle(float cx, float cy, float radius, const SDL_Color& color)
+{
+    if (!m_renderer) return;
+    ++m_primitives;
+
+    // triangle fan around the center
+    const SDL_FColor c = ToFColor(color);
+    const int segments = CircleSegments(radius);
+    const float step = static_cast<float>(2.0 * k_PI / segments);
+    const int center = AddVertex(m_fillVertices, cx, cy, c);
+    for (int i = 0; i < segments; ++i)
+        AddVertex(m_fillVertices, cx + radius * std::cos(step * i), cy + radius * std::sin(step * i), c);
+    for (int i = 0; i < segments; ++i)
+    {
+        m_fillIndices.push_back(center);
+        m_fillIndices.push_back(center + 1 + i);
+        m_fillIndices.push_back(center + 1 + (i + 1) % segments);
+    }
+}
+//-------------------------------------------------------------
+void DebugDraw::FilledTriangle(const SDL_FPoint& p1, const SDL_FPoint& p2, const SDL_FPoint& p3, const SDL_Color& color)
+{
+    if (!m_renderer) return;
+    ++m_primitives;
+
+    const SDL_FColor c = ToFColor(color);
+    const int v = AddVertex(m_fillVertices, p1.x, p1.y, c);
+    AddVertex(m_fillVertices, p2.x, p2.y, c);
+    AddVertex(m_fillVertices, p3.x, p3.y, c);
+    m_fillIndices.push_back(v);
+    m_fillIndices.push_back(v + 1);
+    m_fillIndices.push_back(v + 2);
+}
+//-------------------------------------------------------------
+void DebugDraw::End()
+{
+    m_stats.primitives = m_primitives;
+    m_stats.drawCalls = 0;
+    if (!m_renderer) return;
+
+    if (!m_fillIndices.empty())
+    {
+        SDL_RenderGeometry(m_renderer, nullptr, m_fillVertices.data(), static_cast<int>(m_fillVertices.size()),
+            m_fillIndices.data(), static_cast<int>(m_fillIndices.size()));
+        ++m_stats.drawCalls;
+    }
+    if (!m_lineIndices.empty())
+    {
+        SDL_RenderGeometry(m_renderer, nullptr, m_lineVertices.data(), static_cast<int>(m_lineVertices.size()),
+            m_lineIndices.data(), static_cast<int>(m_lineIndices.size()));
+        ++m_stats.drawCalls;
+    }
+    if (!m_points.empty())
+    {
+        Uint8 r, g, b, a;
+        SDL_GetRenderDrawColor(m_renderer, &r, &g, &b, &a);
+
+        // group by color: one SDL_RenderPoints per color
+        std::stable_sort(m_points.begin(), m_points.end(),
+            [](const ColoredPoint& p, const ColoredPoint& q) { return p.color < q.color; });
+        size_t runStart = 0;
+        while (runStart < m_points.size())
+        {
+            const uint32_t color = m_points[runStart].color;
+            m_pointRun.clear();
+            size_t runEnd = runStart;
+            while (runEnd < m_points.size() && m_points[runEnd].color == color) m_pointRun.push_back(m_points[runEnd++].pos);
+
+            SDL_SetRenderDrawColor(m_renderer, static_cast<Uint8>(color >> 24), static_cast<Uint8>(color >> 16),
+                static_cast<Uint8>(color >> 8), static_cast<Uint8>(color));
+            SDL_RenderPoints(m_renderer, m_pointRun.data(), static_cast<int>(m_pointRun.size()));
+            ++m_stats.drawCalls;
+            runStart = runEnd;
+        }
+        SDL_SetRenderDrawColor(m_renderer, r, g, b, a);
+    }
+    m_renderer = nullptr;
+}
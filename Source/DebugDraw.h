@@ -0,0 +1,86 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- DebugDraw is an immediate-mode debug overlay: lines, points, rectangles,
+  circles and filled shapes are only recorded into per-frame vertex arrays
+  and submitted at End() with one call per primitive kind:
+    - filled shapes: one SDL_RenderGeometry call (colored triangles)
+    - lines / outlines: one SDL_RenderGeometry call (1 pixel wide quads, so
+      that segments of different colors share the call)
+    - points: one SDL_RenderPoints call per color
+- Nothing is recorded when OptionFlags::ShowDebugInfo is off: every Add
+  method returns on its first test.
+
+Notes:
+- Coordinates are render coordinates of the current viewport (same as the
+  former drawing.cpp calls): world-space callers convert with
+  CameraManager::WorldToRender() so that overlays follow the camera zoom. Begin() / End() bracket a viewport pass, World
+  calls them around the RenderDebug() loops.
+- Vertex / index arrays are members reused from frame to frame (frame arena):
+  no allocation once the peak primitive count has been reached.
+- Draw order: filled shapes, then lines, then points.
+*/
+#pragma once
+
+#include "object.h"
+#include <SDL3/SDL.h>
+#include <vector>
+#include <cstdint>
+
+class DebugDraw : public Object
+{
+public:
+    DebugDraw();
+    virtual ~DebugDraw();
+
+    virtual ObjectType GetObjectType() const override { return ObjectType::Singleton; }
+
+    static DebugDraw& GetInstance();
+    static DebugDraw& Get() { return GetInstance(); }
+
+    void Begin(SDL_Renderer* renderer);
+    void End();
+
+    // true between Begin() and End() when debug info is enabled: callers can skip their own computations
+    bool IsEnabled() const { return m_renderer != nullptr; }
+
+    void Line(float x0, float y0, float x1, float y1, const SDL_Color& color);
+    void Point(float x, float y, const SDL_Color& color);
+    void Rect(const SDL_FRect& rect, const SDL_Color& color);
+    void FilledRect(const SDL_FRect& rect, const SDL_Color& color);
+    void Circle(float cx, float cy, float radius, const SDL_Color& color);
+    void FilledCircle(float cx, float cy, float radius, const SDL_Color& color);
+    void FilledTriangle(const SDL_FPoint& p1, const SDL_FPoint& p2, const SDL_FPoint& p3, const SDL_Color& color);
+
+    struct Stats
+    {
+        size_t primitives = 0; // primitives recorded in the last pass
+        size_t drawCalls = 0;  // SDL calls issued in the last pass
+    };
+    const Stats& GetStats() const { return m_stats; }
+
+private:
+    struct ColoredPoint
+    {
+        uint32_t color; // RGBA packed, used to group points
+        SDL_FPoint pos;
+    };
+
+    static int CircleSegments(float radius);
+    int AddVertex(std::vector<SDL_Vertex>& vertices, float x, float y, const SDL_FColor& color);
+
+    SDL_Renderer* m_renderer = nullptr;
+
+    std::vector<SDL_Vertex> m_fillVertices;
+    std::vector<int> m_fillIndices;
+    std::vector<SDL_Vertex> m_lineVertices;
+    std::vector<int> m_lineIndices;
+    std::vector<ColoredPoint> m_points;
+    std::vector<SDL_FPoint> m_pointRun; // points of one color, for SDL_RenderPoints
+
+    size_t m_primitives = 0;
+    Stats m_stats;
+};
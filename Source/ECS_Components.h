@@ -12,6 +12,7 @@ Components purpose: Include all component definitions used in the ECS architectu
 #pragma once
 
 #include "Ecs_Entity.h"
+#include "system/Symbol.h"
 #include <string>
 
 // --- Component 1: Position (Data) ---
@@ -24,8 +25,8 @@ struct _Position
 // --- Component 2: Sprite (Render Data) ---
 struct _Sprite
 {
-    std::string assetID; // Texture ID
-    int zIndex = 0;      // Render order
+    Symbol assetID;         // Texture ID (authoring / serialization)
+    int zIndex = 0;         // Render order
 };
 
 // --- Component 3: AI_Player (Behavior Data/Marker) ---
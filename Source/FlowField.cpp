@@ -0,0 +1,272 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- Implementation of FlowField (Dijkstra integration + direction field) and
+  FlowFieldManager (shared fields, async double-buffered rebuilds).
+*/
+
+#include "FlowField.h"
+#include "system/JobSystem.h"
+#include "system/system_utils.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    const float k_SQRT2 = 1.41421356f;
+    const float k_INVSQRT2 = 0.70710678f;
+
+    // 8 neighbors: E, SE, S, SW, W, NW, N, NE
+    const int k_dx[8] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+    const int k_dy[8] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+
+    struct HeapNode
+    {
+        float cost;
+        int32_t index;
+    };
+    struct HeapNodeGreater
+    {
+        bool operator()(const HeapNode& a, const HeapNode& b) const { return a.cost > b.cost; }
+    };
+
+    // reused between builds on the same worker
+    thread_local std::vector<HeapNode> t_heap;
+}
+
+const int8_t FlowField::DIR_NONE;
+const int8_t FlowField::DIR_GOAL;
+
+//-------------------------------------------------------------
+SDL_FPoint FlowField::DirectionVector(int8_t dir)
+{
+    static const SDL_FPoint k_dirs[8] = {
+        { 1.0f, 0.0f }, { k_INVSQRT2, k_INVSQRT2 }, { 0.0f, 1.0f }, { -k_INVSQRT2, k_INVSQRT2 },
+        { -1.0f, 0.0f }, { -k_INVSQRT2, -k_INVSQRT2 }, { 0.0f, -1.0f }, { k_INVSQRT2, -k_INVSQRT2 }
+    };
+    if (dir < 0 || dir > 7) return { 0.0f, 0.0f };
+    return k_dirs[dir];
+}
+//-------------------------------------------------------------
+void FlowField::Build(const NavGrid& grid, int gx, int gy, FlowField& out)
+{
+    const float INF = std::numeric_limits<float>::infinity();
+    const size_t cellCount = static_cast<size_t>(grid.width) * static_cast<size_t>(grid.height);
+
+    out.width = grid.width;
+    out.height = grid.height;
+    out.cellSize = grid.cellSize;
+    out.version = grid.version;
+    out.goalX = gx;
+    out.goalY = gy;
+    out.integration.assign(cellCount, INF);
+    out.direction.assign(cellCount, DIR_NONE);
+    if (!grid.IsWalkable(gx, gy)) return;
+
+    // 1) integration field: Dijkstra from the goal
+    std::vector<HeapNode>& heap = t_heap;
+    heap.clear();
+    const int32_t goal = grid.Index(gx, gy);
+    out.integration[goal] = 0.0f;
+    heap.push_back({ 0.0f, goal });
+
+    while (!heap.empty())
+    {
+        std::pop_heap(heap.begin(), heap.end(), HeapNodeGreater());
+        const HeapNode node = heap.back();
+        heap.pop_back();
+        if (node.cost > out.integration[node.index]) continue; // stale entry
+
+        const int cx = node.index % grid.width;
+        const int cy = node.index / grid.width;
+        for (int d = 0; d < 8; ++d)
+        {
+            const int nx = cx + k_dx[d];
+            const int ny = cy + k_dy[d];
+            if (!grid.IsWalkable(nx, ny)) continue;
+            const bool diagonal = (k_dx[d] != 0 && k_dy[d] != 0);
+            if (diagonal && (!grid.IsWalkable(nx, cy) || !grid.IsWalkable(cx, ny))) continue;
+
+            const int32_t n = grid.Index(nx, ny);
+            const float cost = node.cost + (diagonal ? k_SQRT2 : 1.0f);
+            if (cost < out.integration[n])
+            {
+                out.integration[n] = cost;
+                heap.push_back({ cost, n });
+                std::push_heap(heap.begin(), heap.end(), HeapNodeGreater());
+            }
+        }
+    }
+
+    // 2) direction field: steepest descent toward the goal
+    for (int y = 0; y < grid.height; ++y)
+    {
+        for (int x = 0; x < grid.width; ++x)
+        {
+            const int32_t i = grid.Index(x, y);
+            if (out.integration[i] == INF) continue;
+            if (i == goal) { out.direction[i] = DIR_GOAL; continue; }
+
+            float best = out.integration[i];
+            int8_t bestDir = DIR_NONE;
+            for (int d = 0; d < 8; ++d)
+            {
+                const int nx = x + k_dx[d];
+                const int ny = y + k_dy[d];
+                if (!grid.IsWalkable(nx, ny)) continue;
+                if (k_dx[d] != 0 && k_dy[d] != 0 && (!grid.IsWalkable(nx, y) || !grid.IsWalkable(x, ny))) continue;
+                const float c = out.integration[grid.Index(nx, ny)];
+                if (c < best)
+                {
+                    best = c;
+                    bestDir = static_cast<int8_t>(d);
+                }
+            }
+            out.direction[i] = bestDir;
+        }
+    }
+}
+
+//-------------------------------------------------------------
+FlowFieldManager::FlowFieldManager()
+{
+    name = "FlowFieldManager";
+    SYSTEM_LOG << "FlowFieldManager created\n";
+}
+//-------------------------------------------------------------
+FlowFieldManager::~FlowFieldManager()
+{
+    SYSTEM_LOG << "FlowFieldManager destroyed\n";
+}
+//-------------------------------------------------------------
+FlowFieldManager& FlowFieldManager::GetInstance()
+{
+    static FlowFieldManager instance;
+    return instance;
+}
+//-------------------------------------------------------------
+void FlowFieldManager::SetGoal(uint64_t goalKey, const Vector& goalPos)
+{
+    std::shared_ptr<const NavGrid> grid = PathfindingManager::Get().GetNavGrid();
+    if (!grid) return;
+
+    const int gx = static_cast<int>(std::floor(goalPos.x / grid->cellSize));
+    const int gy = static_cast<int>(std::floor(goalPos.y / grid->cellSize));
+
+    Entry& e = m_fields[goalKey];
+    e.lastUsedFrame = m_frame;
+    if (e.released)
+    {
+        e.released = false;
+        e.dirty = true; // the running build is for the released goal
+    }
+    if (!e.dirty && e.goalX == gx && e.goalY == gy && e.requestedVersion == grid->version) return;
+
+    // goal crossed a cell or map changed
+    e.goalX = gx;
+    e.goalY = gy;
+    e.requestedVersion = grid->version;
+    e.dirty = true;
+}
+//-------------------------------------------------------------
+void FlowFieldManager::ReleaseGoal(uint64_t goalKey)
+{
+    auto it = m_fields.find(goalKey);
+    if (it == m_fields.end()) return;
+    if (it->second.building)
+    {
+        // keep the entry until the running build completes (Process() drops it then), so that
+        // a SetGoal() meanwhile doesn't start a second build and get the stale one published
+        it->second.released = true;
+        it->second.current.reset();
+        return;
+    }
+    m_fields.erase(it);
+}
+//-------------------------------------------------------------
+FlowFieldPtr FlowFieldManager::GetField(uint64_t goalKey) const
+{
+    auto it = m_fields.find(goalKey);
+    return (it != m_fields.end()) ? it->second.current : FlowFieldPtr();
+}
+//-------------------------------------------------------------
+bool FlowFieldManager::SampleDirection(uint64_t goalKey, const Vector& worldPos, Vector& outDir)
+{
+    auto it = m_fields.find(goalKey);
+    if (it == m_fields.end() || !it->second.current) return false;
+    it->second.lastUsedFrame = m_frame;
+
+    const FlowField& f = *it->second.current;
+    const int x = static_cast<int>(std::floor(worldPos.x / f.cellSize));
+    const int y = static_cast<int>(std::floor(worldPos.y / f.cellSize));
+    if (x < 0 || y < 0 || x >= f.width || y >= f.height) return false;
+
+    const int8_t dir = f.direction[static_cast<size_t>(y) * f.width + x];
+    if (dir == FlowField::DIR_NONE) return false;
+    const SDL_FPoint v = FlowField::DirectionVector(dir);
+    outDir.Set(v.x, v.y, 0.0f);
+    return true;
+}
+//-------------------------------------------------------------
+void FlowFieldManager::StartBuild(uint64_t key, Entry& e, const std::shared_ptr<const NavGrid>& grid)
+{
+    e.dirty = false;
+    e.building = true;
+    const int gx = e.goalX;
+    const int gy = e.goalY;
+    JobSystem::Get().Submit([this, key, grid, gx, gy]()
+    {
+        auto field = std::make_shared<FlowField>();
+        FlowField::Build(*grid, gx, gy, *field);
+        std::lock_guard<std::mutex> lock(m_completedMutex);
+        m_completed.push_back({ key, field });
+    }, JobPriority::Normal);
+}
+//-------------------------------------------------------------
+void FlowFieldManager::Process()
+{
+    ++m_frame;
+
+    // publish finished builds (swap the front buffer)
+    std::vector<CompletedBuild> completed;
+    {
+        std::lock_guard<std::mutex> lock(m_completedMutex);
+        completed.swap(m_completed);
+    }
+    for (auto& c : completed)
+    {
+        auto it = m_fields.find(c.key);
+        if (it == m_fields.end()) continue;
+        it->second.building = false;
+        if (it->second.released)
+        {
+            m_fields.erase(it);
+            continue;
+        }
+        it->second.current = c.field;
+    }
+
+    std::shared_ptr<const NavGrid> grid = PathfindingManager::Get().GetNavGrid();
+
+    for (auto it = m_fields.begin(); it != m_fields.end(); )
+    {
+        Entry& e = it->second;
+        if (m_frame - e.lastUsedFrame > m_idleFramesBeforeRelease && !e.building)
+        {
+            it = m_fields.erase(it);
+            continue;
+        }
+        if (grid && e.requestedVersion != grid->version)
+        {
+            e.requestedVersion = grid->version;
+            e.dirty = true;
+        }
+        // one build at a time per field: a goal moving every frame does not pile up jobs
+        if (grid && e.dirty && !e.building) StartBuild(it->first, e, grid);
+        ++it;
+    }
+}
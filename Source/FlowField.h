@@ -0,0 +1,112 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- FlowFieldManager builds flow fields on the active CollisionMap for goals
+  shared by many agents (e.g. every Npc chasing the same Player).
+- A field is an integration field (Dijkstra, octile costs, no corner cutting)
+  from the goal cell, converted into a direction field: for each cell the
+  direction of the cheapest neighbor. Agents only sample one cell per frame.
+
+Notes:
+- Fields are keyed by a goal key chosen by the caller (typically the UID of
+  the target object). SetGoal() is cheap: the field is rebuilt only when the
+  goal enters another cell or when the map version changes.
+- Builds run on JobSystem workers; the previous field stays in use until the
+  new one is published in Process() (double buffering), so agents never see a
+  half built field.
+- Fields not sampled for 'idleFramesBeforeRelease' frames are released.
+- The grid snapshot is the one maintained by PathfindingManager, so both
+  services always agree on the map content.
+*/
+#pragma once
+
+#include "object.h"
+#include "vector.h"
+#include "Pathfinding.h"
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+
+struct FlowField
+{
+    int width = 0;
+    int height = 0;
+    float cellSize = 32.0f;
+    uint32_t version = 0;   // map version used for the build
+    int goalX = 0;
+    int goalY = 0;
+
+    static const int8_t DIR_NONE = -1; // blocked or unreachable
+    static const int8_t DIR_GOAL = 8;  // goal cell
+    std::vector<float> integration;    // cost to goal, +inf when unreachable
+    std::vector<int8_t> direction;     // 0..7 (see DirectionVector), DIR_NONE or DIR_GOAL
+
+    // Unit vector for a direction index (0..7), zero vector otherwise
+    static SDL_FPoint DirectionVector(int8_t dir);
+
+    // Build the field for a goal cell on a navigation grid snapshot (thread-safe)
+    static void Build(const NavGrid& grid, int goalX, int goalY, FlowField& out);
+};
+using FlowFieldPtr = std::shared_ptr<const FlowField>;
+
+class FlowFieldManager : public Object
+{
+public:
+    FlowFieldManager();
+    virtual ~FlowFieldManager();
+
+    virtual ObjectType GetObjectType() const override { return ObjectType::Singleton; }
+
+    static FlowFieldManager& GetInstance();
+    static FlowFieldManager& Get() { return GetInstance(); }
+
+    // Declare / move the goal of a field. Requests a rebuild only if the goal cell or the map changed.
+    void SetGoal(uint64_t goalKey, const Vector& goalPos);
+    void ReleaseGoal(uint64_t goalKey);
+
+    // Direction to follow at worldPos (unit vector, or zero at the goal).
+    // Returns false if the field is not built yet or the cell is blocked / unreachable.
+    bool SampleDirection(uint64_t goalKey, const Vector& worldPos, Vector& outDir);
+
+    // Current published field (may be nullptr while the first build is running)
+    FlowFieldPtr GetField(uint64_t goalKey) const;
+
+    // Per-frame update: publish finished builds, start pending ones, release idle fields
+    void Process() override;
+
+    void SetIdleFramesBeforeRelease(uint32_t n) { m_idleFramesBeforeRelease = n; }
+    size_t GetFieldCount() const { return m_fields.size(); }
+
+private:
+    struct Entry
+    {
+        FlowFieldPtr current;       // published field, read by agents
+        int goalX = 0;              // requested goal cell
+        int goalY = 0;
+        uint32_t requestedVersion = 0;
+        bool dirty = true;          // needs a (re)build
+        bool building = false;      // a build is running on a worker
+        bool released = false;      // ReleaseGoal() called while building
+        uint32_t lastUsedFrame = 0;
+    };
+    struct CompletedBuild
+    {
+        uint64_t key;
+        FlowFieldPtr field;
+    };
+
+    void StartBuild(uint64_t key, Entry& e, const std::shared_ptr<const NavGrid>& grid);
+
+    std::unordered_map<uint64_t, Entry> m_fields;
+
+    std::mutex m_completedMutex;
+    std::vector<CompletedBuild> m_completed;
+
+    uint32_t m_frame = 0;
+    uint32_t m_idleFramesBeforeRelease = 120;
+};
@@ -21,8 +21,7 @@ void GameEngine::Initialize()
 	ptr_optionsmanager = &OptionsManager::GetInstance();
 	ptr_datamanager = &DataManager::GetInstance();
 
-	// Preload system resources from olymp.ini
-	DataManager::Get().PreloadSystemResources("./olympe.ini");
+	// System resources (olympe.ini) are preloaded by a startup task, in parallel with the SDL initialization (see SDL_AppInit)
 
 	// Create and initialize panel manager
 	PanelManager::Get().Initialize();
@@ -32,7 +32,7 @@ std::string GameObject::Save() const
     ss << std::fixed << std::setprecision(6);
     ss << "{\n";
     ss << "  \"uid\": " << GetUID() << ",\n";
-    ss << "  \"name\": \"" << escape_json_string(name) << "\",\n";
+    ss << "  \"name\": \"" << escape_json_string(name.str()) << "\",\n";
     ss << "  \"className\": \"GameObject\",\n";
     ss << "  \"entityType\": " << static_cast<int>(GetEntityType()) << ",\n";
     ss << "  \"position\": { \"x\": " << position.x << ", \"y\": " << position.y << " },\n";
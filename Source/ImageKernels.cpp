@@ -0,0 +1,368 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- Implementation of the ImageKernels (color field, separable box blur,
+  streaming texture upload).
+*/
+
+#include "ImageKernels.h"
+#include "system/JobSystem.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OLYMPE_IMAGE_SSE2 1
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#define OLYMPE_IMAGE_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    const size_t k_ROW_GRAIN = 32;      // rows per job
+    const size_t k_COLUMN_GRAIN = 128;  // columns per job (vertical blur pass)
+
+    inline uint32_t PackARGB(int r, int g, int b)
+    {
+        return 0xFF000000u | (static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8) | static_cast<uint32_t>(b);
+    }
+
+    //-------------------------------------------------------------
+    void ColorFieldRows(uint32_t* pixels, int width, int rowBegin, int rowEnd,
+        const ImageKernels::ColorFieldPoint* points, int count, float softness)
+    {
+        // per row: dy^2 + softness of every point
+        std::vector<float> dy2(count);
+        for (int y = rowBegin; y < rowEnd; ++y)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                const float dy = static_cast<float>(y) - points[i].y;
+                dy2[i] = dy * dy + softness;
+            }
+            uint32_t* row = pixels + static_cast<size_t>(y) * width;
+            int x = 0;
+
+#if defined(OLYMPE_IMAGE_AVX2)
+            const __m256 lane8 = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+            const __m256i alpha8 = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+            for (; x + 8 <= width; x += 8)
+            {
+                const __m256 xs = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(x)), lane8);
+                __m256 sw = _mm256_setzero_ps(), sr = sw, sg = sw, sb = sw;
+                for (int i = 0; i < count; ++i)
+                {
+                    const __m256 dx = _mm256_sub_ps(xs, _mm256_set1_ps(points[i].x));
+                    const __m256 d = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_set1_ps(dy2[i]));
+                    // 1 / d: reciprocal estimate + one Newton step
+                    const __m256 e = _mm256_rcp_ps(d);
+                    const __m256 w = _mm256_mul_ps(e, _mm256_sub_ps(_mm256_set1_ps(2.0f), _mm256_mul_ps(d, e)));
+                    sw = _mm256_add_ps(sw, w);
+                    sr = _mm256_add_ps(sr, _mm256_mul_ps(w, _mm256_set1_ps(points[i].r)));
+                    sg = _mm256_add_ps(sg, _mm256_mul_ps(w, _mm256_set1_ps(points[i].g)));
+                    sb = _mm256_add_ps(sb, _mm256_mul_ps(w, _mm256_set1_ps(points[i].b)));
+                }
+                const __m256 inv = _mm256_div_ps(_mm256_set1_ps(1.0f), sw);
+                const __m256i r = _mm256_cvtps_epi32(_mm256_mul_ps(sr, inv));
+                const __m256i g = _mm256_cvtps_epi32(_mm256_mul_ps(sg, inv));
+                const __m256i b = _mm256_cvtps_epi32(_mm256_mul_ps(sb, inv));
+                const __m256i argb = _mm256_or_si256(_mm256_or_si256(alpha8, _mm256_slli_epi32(r, 16)),
+                    _mm256_or_si256(_mm256_slli_epi32(g, 8), b));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(row + x), argb);
+            }
+#endif
+#if defined(OLYMPE_IMAGE_SSE2)
+            const __m128 lane4 = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+            const __m128i alpha4 = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+            for (; x + 4 <= width; x += 4)
+            {
+                const __m128 xs = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), lane4);
+                __m128 sw = _mm_setzero_ps(), sr = sw, sg = sw, sb = sw;
+                for (int i = 0; i < count; ++i)
+                {
+                    const __m128 dx = _mm_sub_ps(xs, _mm_set1_ps(points[i].x));
+                    const __m128 d = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_set1_ps(dy2[i]));
+                    // 1 / d: reciprocal estimate + one Newton step
+                    const __m128 e = _mm_rcp_ps(d);
+                    const __m128 w = _mm_mul_ps(e, _mm_sub_ps(_mm_set1_ps(2.0f), _mm_mul_ps(d, e)));
+                    sw = _mm_add_ps(sw, w);
+                    sr = _mm_add_ps(sr, _mm_mul_ps(w, _mm_set1_ps(points[i].r)));
+                    sg = _mm_add_ps(sg, _mm_mul_ps(w, _mm_set1_ps(points[i].g)));
+                    sb = _mm_add_ps(sb, _mm_mul_ps(w, _mm_set1_ps(points[i].b)));
+                }
+                const __m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), sw);
+                const __m128i r = _mm_cvtps_epi32(_mm_mul_ps(sr, inv));
+                const __m128i g = _mm_cvtps_epi32(_mm_mul_ps(sg, inv));
+                const __m128i b = _mm_cvtps_epi32(_mm_mul_ps(sb, inv));
+                const __m128i argb = _mm_or_si128(_mm_or_si128(alpha4, _mm_slli_epi32(r, 16)),
+                    _mm_or_si128(_mm_slli_epi32(g, 8), b));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x), argb);
+            }
+#endif
+            // scalar path (remainder, or whole row without SIMD)
+            for (; x < width; ++x)
+            {
+                float sw = 0.0f, sr = 0.0f, sg = 0.0f, sb = 0.0f;
+                for (int i = 0; i < count; ++i)
+                {
+                    const float dx = static_cast<float>(x) - points[i].x;
+                    const float w = 1.0f / (dx * dx + dy2[i]);
+                    sw += w;
+                    sr += w * points[i].r;
+                    sg += w * points[i].g;
+                    sb += w * points[i].b;
+                }
+                const float inv = 1.0f / sw;
+                row[x] = PackARGB(static_cast<int>(sr * inv + 0.5f), static_cast<int>(sg * inv + 0.5f), static_cast<int>(sb * inv + 0.5f));
+            }
+        }
+    }
+
+    //-------------------------------------------------------------
+    // Running window sums hold the channels of a pixel (B, G, R, A in memory order) as 16-bit
+    // integers: with radius <= 127 a sum never exceeds 255 * 255. The average is computed as
+    // ((sum + n / 2) * scale) >> 16 with scale = 65536 / n (n = window size).
+#if defined(OLYMPE_IMAGE_SSE2)
+    typedef __m128i ChannelSum;
+    inline ChannelSum LoadChannels(uint32_t p) { return _mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(p)), _mm_setzero_si128()); }
+    inline ChannelSum ZeroChannels() { return _mm_setzero_si128(); }
+    inline ChannelSum AddChannels(ChannelSum a, ChannelSum b) { return _mm_add_epi16(a, b); }
+    inline ChannelSum SubChannels(ChannelSum a, ChannelSum b) { return _mm_sub_epi16(a, b); }
+    // column sums kept in plain uint16_t arrays (4 per pixel): std::vector<__m128i> would drop the alignment
+    inline ChannelSum LoadSum(const uint16_t* s) { return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(s)); }
+    inline void StoreSum(uint16_t* s, ChannelSum v) { _mm_storel_epi64(reinterpret_cast<__m128i*>(s), v); }
+    inline __m128i Average(__m128i sum, uint16_t half, uint16_t scale)
+    {
+        return _mm_mulhi_epu16(_mm_add_epi16(sum, _mm_set1_epi16(static_cast<short>(half))), _mm_set1_epi16(static_cast<short>(scale)));
+    }
+    inline uint32_t StoreChannels(ChannelSum sum, uint16_t half, uint16_t scale)
+    {
+        const __m128i v = Average(sum, half, scale);
+        return static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_packus_epi16(v, v)));
+    }
+#else
+    struct ChannelSum { uint32_t c[4]; };
+    inline ChannelSum LoadChannels(uint32_t p)
+    {
+        ChannelSum s = { { p & 0xFF, (p >> 8) & 0xFF, (p >> 16) & 0xFF, p >> 24 } };
+        return s;
+    }
+    inline ChannelSum ZeroChannels() { ChannelSum s = { { 0, 0, 0, 0 } }; return s; }
+    inline ChannelSum AddChannels(ChannelSum a, ChannelSum b) { for (int i = 0; i < 4; ++i) a.c[i] += b.c[i]; return a; }
+    inline ChannelSum SubChannels(ChannelSum a, ChannelSum b) { for (int i = 0; i < 4; ++i) a.c[i] -= b.c[i]; return a; }
+    inline ChannelSum LoadSum(const uint16_t* s) { ChannelSum v = { { s[0], s[1], s[2], s[3] } }; return v; }
+    inline void StoreSum(uint16_t* s, ChannelSum v) { for (int i = 0; i < 4; ++i) s[i] = static_cast<uint16_t>(v.c[i]); }
+    inline uint32_t StoreChannels(ChannelSum sum, uint16_t half, uint16_t scale)
+    {
+        uint32_t p = 0;
+        for (int i = 0; i < 4; ++i) p |= (((sum.c[i] + half) * scale) >> 16) << (8 * i);
+        return p;
+    }
+#endif
+
+    //-------------------------------------------------------------
+    void BlurHorizontalRows(const uint32_t* src, uint32_t* dst, int width, int radius, int rowBegin, int rowEnd)
+    {
+        const int n = 2 * radius + 1;
+        const uint16_t half = static_cast<uint16_t>(n / 2);
+        const uint16_t scale = static_cast<uint16_t>((65536 + n / 2) / n);
+        int y = rowBegin;
+
+#if defined(OLYMPE_IMAGE_SSE2)
+        // 2 rows per step: row y in the low 4 lanes, row y + 1 in the high 4 lanes
+        const __m128i zero = _mm_setzero_si128();
+        for (; y + 2 <= rowEnd; y += 2)
+        {
+            const uint32_t* in0 = src + static_cast<size_t>(y) * width;
+            const uint32_t* in1 = in0 + width;
+            uint32_t* out0 = dst + static_cast<size_t>(y) * width;
+            uint32_t* out1 = out0 + width;
+            auto load = [&](int x)
+            {
+                return _mm_unpacklo_epi8(_mm_unpacklo_epi32(_mm_cvtsi32_si128(static_cast<int>(in0[x])),
+                    _mm_cvtsi32_si128(static_cast<int>(in1[x]))), zero);
+            };
+
+            __m128i sum = zero;
+            for (int k = -radius; k <= radius; ++k) sum = _mm_add_epi16(sum, load(std::min(std::max(k, 0), width - 1)));
+            for (int x = 0; x < width; ++x)
+            {
+                const __m128i v = Average(sum, half, scale);
+                const __m128i packed = _mm_packus_epi16(v, v);
+                out0[x] = static_cast<uint32_t>(_mm_cvtsi128_si32(packed));
+                out1[x] = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(packed, 4)));
+                sum = _mm_sub_epi16(_mm_add_epi16(sum, load(std::min(x + radius + 1, width - 1))), load(std::max(x - radius, 0)));
+            }
+        }
+#endif
+        for (; y < rowEnd; ++y)
+        {
+            const uint32_t* in = src + static_cast<size_t>(y) * width;
+            uint32_t* out = dst + static_cast<size_t>(y) * width;
+
+            // window [x - radius, x + radius], edges replicated
+            ChannelSum sum = ZeroChannels();
+            for (int k = -radius; k <= radius; ++k) sum = AddChannels(sum, LoadChannels(in[std::min(std::max(k, 0), width - 1)]));
+            for (int x = 0; x < width; ++x)
+            {
+                out[x] = StoreChannels(sum, half, scale);
+                const int add = std::min(x + radius + 1, width - 1);
+                const int sub = std::max(x - radius, 0);
+                sum = SubChannels(AddChannels(sum, LoadChannels(in[add])), LoadChannels(in[sub]));
+            }
+        }
+    }
+
+    //-------------------------------------------------------------
+    void BlurVerticalColumns(const uint32_t* src, uint32_t* dst, int width, int height, int radius, int colBegin, int colEnd)
+    {
+        const int n = 2 * radius + 1;
+        const uint16_t half = static_cast<uint16_t>(n / 2);
+        const uint16_t scale = static_cast<uint16_t>((65536 + n / 2) / n);
+        int x = colBegin;
+
+#if defined(OLYMPE_IMAGE_SSE2)
+        // 4 pixels (16 channels) per step: two 8 x 16-bit sums per group of 4 columns,
+        // stored as 16 uint16_t per group (unaligned loads / stores)
+        const int groupCount = (colEnd - colBegin) / 4;
+        if (groupCount > 0)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            std::vector<uint16_t> sums(static_cast<size_t>(groupCount) * 16, 0);
+            for (int k = -radius; k <= radius; ++k)
+            {
+                const uint32_t* in = src + static_cast<size_t>(std::min(std::max(k, 0), height - 1)) * width + colBegin;
+                for (int g = 0; g < groupCount; ++g)
+                {
+                    __m128i* lo = reinterpret_cast<__m128i*>(&sums[static_cast<size_t>(g) * 16]);
+                    __m128i* hi = reinterpret_cast<__m128i*>(&sums[static_cast<size_t>(g) * 16 + 8]);
+                    const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + g * 4));
+                    _mm_storeu_si128(lo, _mm_add_epi16(_mm_loadu_si128(lo), _mm_unpacklo_epi8(p, zero)));
+                    _mm_storeu_si128(hi, _mm_add_epi16(_mm_loadu_si128(hi), _mm_unpackhi_epi8(p, zero)));
+                }
+            }
+            for (int y = 0; y < height; ++y)
+            {
+                uint32_t* out = dst + static_cast<size_t>(y) * width + colBegin;
+                const uint32_t* inAdd = src + static_cast<size_t>(std::min(y + radius + 1, height - 1)) * width + colBegin;
+                const uint32_t* inSub = src + static_cast<size_t>(std::max(y - radius, 0)) * width + colBegin;
+                for (int g = 0; g < groupCount; ++g)
+                {
+                    __m128i* loSum = reinterpret_cast<__m128i*>(&sums[static_cast<size_t>(g) * 16]);
+                    __m128i* hiSum = reinterpret_cast<__m128i*>(&sums[static_cast<size_t>(g) * 16 + 8]);
+                    const __m128i lo = _mm_loadu_si128(loSum);
+                    const __m128i hi = _mm_loadu_si128(hiSum);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + g * 4), _mm_packus_epi16(Average(lo, half, scale), Average(hi, half, scale)));
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inAdd + g * 4));
+                    const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inSub + g * 4));
+                    _mm_storeu_si128(loSum, _mm_sub_epi16(_mm_add_epi16(lo, _mm_unpacklo_epi8(a, zero)), _mm_unpacklo_epi8(s, zero)));
+                    _mm_storeu_si128(hiSum, _mm_sub_epi16(_mm_add_epi16(hi, _mm_unpackhi_epi8(a, zero)), _mm_unpackhi_epi8(s, zero)));
+                }
+            }
+            x += groupCount * 4;
+        }
+#endif
+        // remaining columns one pixel at a time (rows walked top to bottom to stay in contiguous segments)
+        const int bandWidth = colEnd - x;
+        if (bandWidth <= 0) return;
+        std::vector<uint16_t> sums(static_cast<size_t>(bandWidth) * 4, 0); // 4 channels per column
+        for (int k = -radius; k <= radius; ++k)
+        {
+            const uint32_t* in = src + static_cast<size_t>(std::min(std::max(k, 0), height - 1)) * width;
+            for (int i = 0; i < bandWidth; ++i)
+            {
+                uint16_t* sum = &sums[static_cast<size_t>(i) * 4];
+                StoreSum(sum, AddChannels(LoadSum(sum), LoadChannels(in[x + i])));
+            }
+        }
+        for (int y = 0; y < height; ++y)
+        {
+            uint32_t* out = dst + static_cast<size_t>(y) * width;
+            const uint32_t* inAdd = src + static_cast<size_t>(std::min(y + radius + 1, height - 1)) * width;
+            const uint32_t* inSub = src + static_cast<size_t>(std::max(y - radius, 0)) * width;
+            for (int i = 0; i < bandWidth; ++i)
+            {
+                uint16_t* sum = &sums[static_cast<size_t>(i) * 4];
+                const ChannelSum v = LoadSum(sum);
+                out[x + i] = StoreChannels(v, half, scale);
+                StoreSum(sum, SubChannels(AddChannels(v, LoadChannels(inAdd[x + i])), LoadChannels(inSub[x + i])));
+            }
+        }
+    }
+}
+
+namespace ImageKernels
+{
+    //-------------------------------------------------------------
+    void ColorField(uint32_t* pixels, int width, int height, const ColorFieldPoint* points, int count, float softness, bool parallel)
+    {
+        if (!pixels || width <= 0 || height <= 0) return;
+        if (count <= 0)
+        {
+            std::fill(pixels, pixels + static_cast<size_t>(width) * height, 0xFF000000u);
+            return;
+        }
+        if (softness <= 0.0f) softness = 1.0f; // avoids a division by zero on the points
+
+        if (parallel)
+        {
+            JobSystem::Get().ParallelFor(static_cast<size_t>(height), k_ROW_GRAIN, [=](size_t begin, size_t end)
+            {
+                ColorFieldRows(pixels, width, static_cast<int>(begin), static_cast<int>(end), points, count, softness);
+            });
+        }
+        else
+        {
+            ColorFieldRows(pixels, width, 0, height, points, count, softness);
+        }
+    }
+    //-------------------------------------------------------------
+    void BoxBlur(uint32_t* pixels, std::vector<uint32_t>& scratch, int width, int height, int radius, int passes, bool parallel)
+    {
+        if (!pixels || width <= 0 || height <= 0 || radius <= 0) return;
+        radius = std::min(radius, 127); // keeps the 16-bit window sums from overflowing
+        scratch.resize(static_cast<size_t>(width) * height);
+        uint32_t* tmp = scratch.data();
+
+        for (int p = 0; p < passes; ++p)
+        {
+            if (parallel)
+            {
+                JobSystem::Get().ParallelFor(static_cast<size_t>(height), k_ROW_GRAIN, [=](size_t begin, size_t end)
+                {
+                    BlurHorizontalRows(pixels, tmp, width, radius, static_cast<int>(begin), static_cast<int>(end));
+                });
+                JobSystem::Get().ParallelFor(static_cast<size_t>(width), k_COLUMN_GRAIN, [=](size_t begin, size_t end)
+                {
+                    BlurVerticalColumns(tmp, pixels, width, height, radius, static_cast<int>(begin), static_cast<int>(end));
+                });
+            }
+            else
+            {
+                BlurHorizontalRows(pixels, tmp, width, radius, 0, height);
+                BlurVerticalColumns(tmp, pixels, width, height, radius, 0, width);
+            }
+        }
+    }
+    //-------------------------------------------------------------
+    bool UploadToTexture(SDL_Texture* texture, const uint32_t* pixels, int width, int height)
+    {
+        if (!texture || !pixels) return false;
+
+        void* dst = nullptr;
+        int pitch = 0;
+        if (!SDL_LockTexture(texture, nullptr, &dst, &pitch)) return false;
+
+        const size_t rowBytes = static_cast<size_t>(width) * sizeof(uint32_t);
+        for (int y = 0; y < height; ++y)
+            std::memcpy(static_cast<uint8_t*>(dst) + static_cast<size_t>(y) * pitch, pixels + static_cast<size_t>(y) * width, rowBytes);
+
+        SDL_UnlockTexture(texture);
+        return true;
+    }
+}
@@ -0,0 +1,49 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- CPU image kernels used for procedural backgrounds (OlympeSystem):
+    - ColorField: multi-point color interpolation (inverse squared distance
+      weighting) filling an ARGB8888 buffer
+    - BoxBlur: separable box blur, repeated passes approximate a gaussian
+      (3 passes are visually equivalent)
+  The result is uploaded to an SDL_TEXTUREACCESS_STREAMING texture with
+  UploadToTexture (SDL_LockTexture + row copies).
+
+Notes:
+- Kernels are vectorized with SSE2 (4 pixels / 4 channels per instruction)
+  and AVX2 (8 pixels) when the compiler targets it (/arch:AVX2 or -mavx2),
+  with a scalar fallback otherwise.
+- 'parallel' splits the work between the JobSystem workers: by rows for the
+  color field and the horizontal blur pass, by column bands for the vertical
+  pass (its running sums go down the columns).
+- Buffers are tightly packed (pitch = width), pixels are ARGB8888 values.
+- Blur sums are 16-bit: the radius is clamped to 127.
+*/
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <vector>
+#include <cstdint>
+
+namespace ImageKernels
+{
+    struct ColorFieldPoint
+    {
+        float x, y;     // position in pixels
+        float r, g, b;  // color, 0..255
+    };
+
+    // Fill 'pixels' (width * height) with the colors of 'points' blended by 1 / (distance^2 + softness)
+    void ColorField(uint32_t* pixels, int width, int height, const ColorFieldPoint* points, int count,
+        float softness = 1.0f, bool parallel = true);
+
+    // Blur 'pixels' in place, 'scratch' is resized as needed (keep it between frames to avoid allocations)
+    void BoxBlur(uint32_t* pixels, std::vector<uint32_t>& scratch, int width, int height, int radius,
+        int passes = 1, bool parallel = true);
+
+    // Copy a width * height ARGB8888 buffer into a streaming texture of the same size
+    bool UploadToTexture(SDL_Texture* texture, const uint32_t* pixels, int width, int height);
+}
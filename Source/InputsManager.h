@@ -123,7 +123,7 @@ public:
         for (auto &kv : m_playerBindings) if (kv.second == controller) return false;
         m_playerBindings[playerID] = controller;
         m_playerIndex[playerID]->m_ControllerID = controller;
-		SYSTEM_LOG << "Player " << playerID << " named "+ ((Player*)m_playerIndex[playerID])->name +" bound to joystick " << controller << "\n";
+		SYSTEM_LOG << "Player " << playerID << " named " << ((Player*)m_playerIndex[playerID])->name << " bound to joystick " << controller << "\n";
         return true;
     }
 
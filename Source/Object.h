@@ -10,6 +10,7 @@ Purpose:
 #pragma once
 #include <string>
 #include "system/message.h"
+#include "system/Symbol.h"
 #include <chrono>
 #include <cstdint>
 
@@ -42,7 +43,7 @@ public:
 
 public:
 
-	std::string name = "unnamed_object";
+	Symbol name = "unnamed_object"; // interned: copies and comparisons are integer operations
 	virtual ObjectType GetObjectType() const { return ObjectType::None; }
 
 	virtual void Process() {};
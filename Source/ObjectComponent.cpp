@@ -19,6 +19,18 @@ void AIComponent::SetOwner(Object* _owner)
     }
 }
 //-------------------------------------------------------------
+bool AIComponent::GetWorldBounds(SDL_FRect& outBounds) const
+{
+    if (!gao) return false;
+    // owner box, inflated for the debug markers drawn around the position
+    const float margin = 8.0f;
+    Vector pos = gao->GetPosition();
+    float w, h;
+    gao->GetSize(w, h);
+    outBounds = { pos.x - margin, pos.y - margin, w + 2.0f * margin, h + 2.0f * margin };
+    return true;
+}
+//-------------------------------------------------------------
 void ObjectComponent::OnEvent(const Message& msg)
 {
     if (msg.struct_type == EventStructType::EventStructType_System_Windows)
@@ -4,9 +4,11 @@
 #include "system/message.h"
 //#include "system/system_consts.h"
 #include <memory>
+#include <SDL3/SDL_rect.h>
 #include "system/system_utils.h"
 
 class GameObject;
+class RenderList;
 
 // Components processing types in order of execution
 enum class ComponentType
@@ -43,6 +45,14 @@ public:
     virtual void Render() {}
     virtual void RenderDebug() {}
 
+    // World-space area covered by Render / RenderDebug, used for viewport culling.
+    // Returns false when unknown: the component is then rendered in every viewport.
+    virtual bool GetWorldBounds(SDL_FRect& /*outBounds*/) const { return false; }
+
+    // Record world-space draw items once per frame (replayed by World for each viewport).
+    // Returns false if the component must be drawn through Render() instead.
+    virtual bool ExtractRenderItems(RenderList& /*list*/) { return false; }
+
     // Called when a message is delivered to this property (via owner forwarding)
     virtual void OnEvent(const Message& /*msg*/);
 
@@ -81,6 +91,7 @@ public:
     virtual void SetOwner(Object* _owner) override;
     virtual void Process() override {/*AI logic goes here.*/ }
     virtual void OnEvent(const Message& msg) override;
+    virtual bool GetWorldBounds(SDL_FRect& outBounds) const override;
 
 protected:
 
@@ -9,7 +9,7 @@ Purpose:
 */
 #pragma once
 #include "Object.h"
-#include <map>
+#include <unordered_map>
 #include <string>
 #include <functional>
 #include <memory>
@@ -24,7 +24,7 @@ class ObjectFactory: public Object
 {
 public:
     using CreatorFunction = std::function<Object* ()>;
-    std::map<std::string, CreatorFunction> m_registeredCreators;
+    std::unordered_map<Symbol, CreatorFunction> m_registeredCreators; // keyed by interned class name
 
     ObjectFactory()
     {
@@ -61,7 +61,7 @@ public:
      * @param creator La fonction de cration (std::function retournant BaseObject*).
      * @return true si l'enregistrement a russi, false sinon (dj enregistr).
      */
-    bool Register(const std::string& className, CreatorFunction creator)
+    bool Register(Symbol className, CreatorFunction creator)
     {
         auto it = m_registeredCreators.find(className);
         if (it != m_registeredCreators.end())
@@ -80,7 +80,7 @@ public:
 	// @brief Check if a class is registered in the factory
 	// @param className The name of the class to check
 	// @return true if the class is registered, false otherwise
-    bool IsRegistered(const std::string& className) const
+    bool IsRegistered(Symbol className) const
     {
         return m_registeredCreators.find(className) != m_registeredCreators.end();
 	}
@@ -90,7 +90,7 @@ public:
      * @param className Le nom de la classe  crer.
      * @return Un pointeur vers le nouvel objet BaseObject, ou nullptr si non trouv.
      */
-    Object* CreateObject(const std::string& className)
+    Object* CreateObject(Symbol className)
     {
         auto it = m_registeredCreators.find(className);
         if (it == m_registeredCreators.end())
@@ -103,7 +103,7 @@ public:
         return o;
     }
 
-    ObjectComponent* AddComponent(const std::string& className, Object* owner)
+    ObjectComponent* AddComponent(Symbol className, Object* owner)
     {
         auto it = m_registeredCreators.find(className);
         if (it == m_registeredCreators.end())
@@ -239,7 +239,7 @@ template <typename T>
 class AutoRegister
 {
 public:
-    AutoRegister(const std::string& className)
+    AutoRegister(const char* className)
     {
         ObjectFactory::GetInstance().Register(className, createT<T>);
     }
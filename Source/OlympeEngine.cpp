@@ -28,6 +28,8 @@ Notes:
 #include "videogame.h"
 #include "DataManager.h"
 #include "system/system_utils.h"
+#include "system/JobSystem.h"
+#include "system/StartupOrchestrator.h"
 #include "PanelManager.h"
 
 // Avoid Win32 macro collisions: PostMessage is a Win32 macro expanding to PostMessageW/A
@@ -52,42 +54,113 @@ const Uint32 FRAME_TARGET_TIME_MS = 1000 / TARGET_FPS;
 /* This function runs once at startup. */
 SDL_AppResult SDL_AppInit(void** appstate, int argc, char* argv[])
 {
+    // Initialization tasks and their dependencies: independent tasks run in parallel, Main tasks
+    // (SDL, window, Win32 panels, renderer) on this thread, Worker tasks on the JobSystem threads.
+    // The timings are logged, and saved in "startup_trace.json" with the first frame time in debug
+    // builds or with "--startup-trace".
+    StartupOrchestrator& startup = StartupOrchestrator::Get(); // time reference of the startup trace
+    for (int i = 1; i < argc; ++i)
+    {
+        if (SDL_strcmp(argv[i], "--startup-trace") == 0) startup.SetTracePath(StartupOrchestrator::k_DEFAULT_TRACE_PATH);
+    }
+
     SYSTEM_LOG << "----------- OLYMPE ENGINE V2 ------------" << endl;
     SYSTEM_LOG << "System Initialization\n" << endl;
 
+    // Initialize system logger so SYSTEM_LOG forwards to UI (if available)
+    startup.AddTask("logger", StartupThread::Main, {}, []()
+    {
+        Logging::InitLogger();
+        return true;
+    });
+
     // Load configuration (JSON inside "olympe.ini"). Defaults used if not present.
-    LoadOlympeConfig("olympe.ini");
+    startup.AddTask("config", StartupThread::Worker, { "logger" }, []()
+    {
+        LoadOlympeConfig("olympe.ini");
+        return true;
+    });
 
-    SDL_SetAppMetadata("Olympe Game Engine", "2.0", "com.googlesites.olympeengine");
+    // SDL subsystems must be initialized on the main thread: video first (window), the slow device
+    // enumerations (audio, joysticks) run while the workers load the resources
+    startup.AddTask("sdl_video", StartupThread::Main, { "logger" }, []()
+    {
+        SDL_SetAppMetadata("Olympe Game Engine", "2.0", "com.googlesites.olympeengine");
+        if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS)) {
+            SDL_Log("Couldn't initialize SDL: %s", SDL_GetError());
+            return false;
+        }
+        return true;
+    });
 
-    // Initialize system logger so SYSTEM_LOG forwards to UI (if available)
-    Logging::InitLogger();
+    startup.AddTask("window", StartupThread::Main, { "sdl_video", "config" }, []()
+    {
+        if (!SDL_CreateWindowAndRenderer("Olympe Engine 2.0", GameEngine::screenWidth, GameEngine::screenHeight, SDL_WINDOW_RESIZABLE, &window, &renderer)) {
+            SDL_Log("Couldn't create window/renderer: %s", SDL_GetError());
+            return false;
+        }
+        SDL_SetRenderLogicalPresentation(renderer, GameEngine::screenWidth, GameEngine::screenHeight, SDL_LOGICAL_PRESENTATION_LETTERBOX);
+        return true;
+    });
 
+    // Initialize DataManager (load system resources if needed)
+    // DataManager must be initialized before GameEngine to enable loading resources during GameEngine init
+    startup.AddTask("data_manager", StartupThread::Worker, { "logger" }, []()
+    {
+        DataManager::Get().Initialize();
+        return true;
+    });
 
-    if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_JOYSTICK | SDL_INIT_AUDIO | SDL_INIT_GAMEPAD)) {
-        SDL_Log("Couldn't initialize SDL: %s", SDL_GetError());
-        return SDL_APP_FAILURE;
-    }
+    // Preload system resources from olympe.ini: decoded on the workers before the renderer exists,
+    // the textures are created by the "engine" task (UploadDeferredTextures)
+    startup.AddTask("resources", StartupThread::Worker, { "data_manager" }, []()
+    {
+        DataManager::Get().PreloadSystemResources("./olympe.ini");
+        return true;
+    });
 
-    if (!SDL_CreateWindowAndRenderer("Olympe Engine 2.0", GameEngine::screenWidth, GameEngine::screenHeight, SDL_WINDOW_RESIZABLE, &window, &renderer)) {
-        SDL_Log("Couldn't create window/renderer: %s", SDL_GetError());
-        return SDL_APP_FAILURE;
-    }
-    SDL_SetRenderLogicalPresentation(renderer, GameEngine::screenWidth, GameEngine::screenHeight, SDL_LOGICAL_PRESENTATION_LETTERBOX);
+    startup.AddTask("sdl_audio", StartupThread::Main, { "sdl_video" }, []()
+    {
+        if (!SDL_InitSubSystem(SDL_INIT_AUDIO)) SDL_Log("Couldn't initialize SDL audio: %s", SDL_GetError());
+        return true; // the game runs without sound
+    });
 
-	// Create and initialize PanelManager (for debug panels)
-	PanelManager::Get().Initialize();
+    // Joystick enumeration: InputsManager opens the connected joysticks (JoystickManager)
+    startup.AddTask("joysticks", StartupThread::Main, { "sdl_video" }, []()
+    {
+        if (!SDL_InitSubSystem(SDL_INIT_JOYSTICK | SDL_INIT_GAMEPAD)) {
+            SDL_Log("Couldn't initialize SDL joysticks: %s", SDL_GetError());
+            return false;
+        }
+        InputsManager::GetInstance();
+        return true;
+    });
 
-    // Initialize DataManager (load system resources if needed)
-	DataManager::Get().Initialize(); // DataManager must be initialized before GameEngine to enable loading resources during GameEngine init
+    // Create and initialize PanelManager (for debug panels)
+    startup.AddTask("panels", StartupThread::Main, { "config" }, []()
+    {
+        PanelManager::Get().Initialize();
+        return true;
+    });
 
     //Olympe Engine and all managers singleton Initialization Here
-    GameEngine::renderer = renderer; // important: set main renderer for GameEngine before GetInstance
-    GameEngine::GetInstance(); // create the GameEngine itself
-    GameEngine::Get().Initialize(); // initialize all submanagers
+    startup.AddTask("engine", StartupThread::Main, { "window", "resources", "sdl_audio", "joysticks", "panels" }, []()
+    {
+        GameEngine::renderer = renderer; // important: set main renderer for GameEngine before GetInstance
+        DataManager::Get().UploadDeferredTextures(); // system resources preloaded without renderer
+        GameEngine::GetInstance(); // create the GameEngine itself
+        GameEngine::Get().Initialize(); // initialize all submanagers
+        return true;
+    });
 
     // Attach panels/menu to main SDL window (Windows only)
-    PanelManager::Get().AttachToSDLWindow(window);
+    startup.AddTask("attach_panels", StartupThread::Main, { "engine" }, []()
+    {
+        PanelManager::Get().AttachToSDLWindow(window);
+        return true;
+    });
+
+    if (!startup.Run()) return SDL_APP_FAILURE;
 
     return SDL_APP_CONTINUE;  /* carry on with the program! */
 }
@@ -195,8 +268,10 @@ SDL_AppResult SDL_AppIterate(void* appstate)
     #endif
 
 	GameEngine::Get().Process(); // update fDt here for all managers
-	World::Get().Process(); // process all world objects/components
-	EventManager::Get().Process(); // ensure queued events are dispatched to all registered listeners
+	DataManager::Get().ProcessHotReload(); // decode again the files changed on disk (swapped by ProcessPendingUploads)
+	DataManager::Get().ProcessPendingUploads(); // upload textures decoded by the workers (time budgeted)
+	DataManager::Get().ProcessResidency(); // reload evicted textures in use, evict the least recently used ones over budget
+	World::Get().Process(); // dispatches the queued events first (EventManager::Process), then processes all world objects/components
 
     // If game state requests quit, end the application loop
     if (GameStateManager::GetState() == GameState::GameState_Quit) { return SDL_APP_SUCCESS; }
@@ -243,6 +318,7 @@ SDL_AppResult SDL_AppIterate(void* appstate)
     }
 
     SDL_RenderPresent(renderer);  /* put it all on the screen! */
+    StartupOrchestrator::Get().MarkFirstFrame(); // time to first frame (once)
 
     // Update FPS counter and set window title once per second
     static int frameCount = 0;
@@ -286,9 +362,15 @@ void SDL_AppQuit(void* appstate, SDL_AppResult result)
 {
     /* SDL will clean up the window/renderer for us. */
 
+    // Stop worker threads before releasing the resources they may use
+    JobSystem::Get().Shutdown();
+
     // Shutdown datamanager to ensure resources freed
     DataManager::Get().Shutdown();
 
+    // event latency and backlog per priority over the session
+    EventManager::Get().LogPriorityStats();
+
     SYSTEM_LOG << "----------- OLYMPE ENGINE V2 ------------" << endl;
     SYSTEM_LOG << "System shutdown completed\n" << endl;
 }
@@ -8,22 +8,14 @@
 #include "drawing.h"
 #include "DataManager.h"
 #include "system/CameraManager.h"
+#include "ParticleSystem.h"
+#include "ImageKernels.h"
 
 
 #define NUM_POINTS 500
 #define MIN_PIXELS_PER_SECOND 30  /* move at least this many pixels per second. */
 #define MAX_PIXELS_PER_SECOND 60  /* move this many pixels per second at most. */
 
-/* (track everything as parallel arrays instead of a array of structs,
-   so we can pass the coordinates to the renderer in a single function call.) */
-
-   /* Points are plotted as a set of X and Y coordinates.
-      (0, 0) is the top left of the window, and larger numbers go down
-      and to the right. This isn't how geometry works, but this is pretty
-      standard in 2D graphics. */
-static SDL_FPoint snowpoints[NUM_POINTS];
-static float snowpoint_speeds[NUM_POINTS];
-
 
 bool OlympeSystem::FactoryRegistered = ObjectFactory::Get().Register("OlympeSystem", OlympeSystem::Create);
 ObjectComponent* OlympeSystem::Create()
@@ -45,23 +37,42 @@ OlympeSystem::OlympeSystem()
     
     morphTexture = SDL_CreateTexture(GameEngine::renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
     SDL_SetTextureBlendMode(morphTexture, SDL_BLENDMODE_BLEND);
+
+    const int gw = SDL_max(1, width / gradientScale), gh = SDL_max(1, height / gradientScale);
+    gradientTexture = SDL_CreateTexture(GameEngine::renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, gw, gh);
+    SDL_SetTextureScaleMode(gradientTexture, SDL_SCALEMODE_LINEAR);
+    gradientPixels.resize(static_cast<size_t>(gw) * gh);
     Initialize();
+    // logo / background textures replaced by a hot reload
+    EventManager::Get().Register(this, EventType::Olympe_EventType_Resource_Reloaded);
 }
 
 OlympeSystem::~OlympeSystem()
 {
+    EventManager::Get().Unregister(this, EventType::Olympe_EventType_Resource_Reloaded);
     SDL_DestroyTexture(morphTexture);
+    SDL_DestroyTexture(gradientTexture);
+    if (m_snow) ParticleSystem::Get().DestroyEmitter(m_snow);
 }
 
 void OlympeSystem::Initialize()
 {
-    //animation of snow points
-    /* set up the data for a bunch of points. */
-    for (int i = 0; i < SDL_arraysize(snowpoints); i++) {
-        snowpoints[i].x = SDL_randf() * ((float)GameEngine::screenWidth);
-        snowpoints[i].y = SDL_randf() * ((float)GameEngine::screenHeight);
-        snowpoint_speeds[i] = MIN_PIXELS_PER_SECOND + (SDL_randf() * (MAX_PIXELS_PER_SECOND - MIN_PIXELS_PER_SECOND));
-    }
+    //animation of snow points: particles drift diagonally and are respawned on the top / left edges
+    // (spawned on the top edge extended to the left so that a part of them enters through the left edge)
+    const float w = static_cast<float>(GameEngine::screenWidth);
+    const float h = static_cast<float>(GameEngine::screenHeight);
+    ParticleEmitterDesc snow;
+    snow.capacity = NUM_POINTS;
+    snow.spawnRate = 0.0f;      // keep NUM_POINTS flakes alive
+    snow.lifetimeMin = snow.lifetimeMax = 0.0f; // killed when leaving the screen
+    snow.spawnArea = { -h, 0.0f, w + h, 0.0f };
+    snow.killBounds = { -h - 1.0f, -1.0f, w + h + 1.0f, h + 1.0f };
+    snow.direction = { 1.0f, 1.0f };
+    snow.speedMin = MIN_PIXELS_PER_SECOND;
+    snow.speedMax = MAX_PIXELS_PER_SECOND;
+    if (m_snow) ParticleSystem::Get().DestroyEmitter(m_snow);
+    m_snow = ParticleSystem::Get().CreateEmitter(snow);
+    m_snow->Prewarm(NUM_POINTS, { 0.0f, 0.0f, w, h });
 
 
     // Initialize a few random color points
@@ -95,45 +106,35 @@ void OlympeSystem::Initialize()
 	//}
 
 	logoTexture = DataManager::Get().GetSprite("Olympe_Logo", "Resources/olympe_logo.png", ResourceCategory::GameObject);
+	DataManager::Get().Pin("Olympe_Logo"); // raw texture pointers are kept: never evicted
     if (!logoTexture) 
     {
         SYSTEM_LOG << "Failed to load logo texture from DataManager\n";
 	}
 
 	backgroundTexture = DataManager::Get().GetSprite("Olympe_Background", "Resources/background.jpg", ResourceCategory::GameObject);
+	DataManager::Get().Pin("Olympe_Background");
     if (!backgroundTexture) 
     {
-        SYSTEM_LOG << "Failed to load background texture from DataManager\n";
+        SYSTEM_LOG << "Failed to load background texture from DataManager, using the animated background\n";
 	}
+    animatedBackground = (backgroundTexture == nullptr);
 }
 
 void OlympeSystem::OnEvent(const Message& msg)
 {
 	// Handle events if needed (e.g., reset colors on specific event)
+	if (msg.msg_type == EventType::Olympe_EventType_Resource_Reloaded)
+	{
+		// resized images get a new texture: refresh the pointers kept here
+		if (msg.objectName == OLYMPE_SYMBOL("Olympe_Logo")) logoTexture = DataManager::Get().GetTexture("Olympe_Logo");
+		else if (msg.objectName == OLYMPE_SYMBOL("Olympe_Background") && !animatedBackground) backgroundTexture = DataManager::Get().GetTexture("Olympe_Background");
+	}
 }
 
 void OlympeSystem::Process()
 {
-	// move and animate snow points
-    /* let's move all our points a little for a new frame. */
-    for (int i = 0; i < SDL_arraysize(snowpoints); i++) {
-        const float distance = GameEngine::fDt * snowpoint_speeds[i];
-        snowpoints[i].x += distance;
-        snowpoints[i].y += distance;
-        if ((snowpoints[i].x >= GameEngine::screenWidth) || (snowpoints[i].y >= GameEngine::screenHeight)) {
-            /* off the screen; restart it elsewhere! */
-            if (SDL_rand(2)) {
-                snowpoints[i].x = SDL_randf() * ((float)GameEngine::screenWidth);
-                snowpoints[i].y = 0.0f;
-            }
-            else {
-                snowpoints[i].x = 0.0f;
-                snowpoints[i].y = SDL_randf() * ((float)GameEngine::screenHeight);
-            }
-            snowpoint_speeds[i] = MIN_PIXELS_PER_SECOND + (SDL_randf() * (MAX_PIXELS_PER_SECOND - MIN_PIXELS_PER_SECOND));
-        }
-    }
-
+	// snow points are moved by the ParticleSystem (World::Process)
 
     // Slowly animate color positions and hues
     time += fDt * 0.5f;
@@ -180,14 +181,22 @@ void OlympeSystem::Process()
     Draw_FilledCircle(GameEngine::renderer, width / 2, height / 2, width / 20);
     
 
-    //GenerateGradient();
-    //ApplyBlur(2);
     /**/
     // Render the logo onto the morph texture
     //SDL_SetTextureBlendMode(logoTexture, SDL_BLENDMODE_BLEND);
     SDL_SetRenderDrawColor(GameEngine::renderer, 0xFF, 0xFF, 0xFF, 0xFF);
 
-	SDL_RenderTexture(GameEngine::renderer, backgroundTexture, nullptr, nullptr);
+    if (animatedBackground)
+    {
+        GenerateGradient();
+        ApplyBlur(1);
+        ImageKernels::UploadToTexture(gradientTexture, gradientPixels.data(), gradientTexture->w, gradientTexture->h);
+        SDL_RenderTexture(GameEngine::renderer, gradientTexture, nullptr, nullptr);
+    }
+    else
+    {
+        SDL_RenderTexture(GameEngine::renderer, backgroundTexture, nullptr, nullptr);
+    }
 
   //  SDL_SetTextureAlphaMod(logoTexture, 200);
     SDL_FRect destRect = { (width - 200.f) / 2.f, (height - 100.f) / 2.f, 300.f, 121.f };
@@ -202,12 +211,10 @@ void OlympeSystem::Process()
 void OlympeSystem::Render()
 {
 	// render the snow points on top of the morph texture
-    SDL_SetRenderDrawColor(GameEngine::renderer, 255, 255, 255, SDL_ALPHA_OPAQUE);
-    SDL_RenderPoints(GameEngine::renderer, snowpoints, SDL_arraysize(snowpoints));
+    if (m_snow) m_snow->Render(GameEngine::renderer);
 
-	Vector vPos = -CameraManager::Get().GetCameraPositionForActivePlayer();
-	// compute destination and source rectangles with CameraManager position offset if any
-	SDL_FRect destRect = { vPos.x, vPos.y, static_cast<float>(width), static_cast<float>(height) };
+	// background placed at the world origin, through the active camera
+	SDL_FRect destRect = CameraManager::Get().WorldToRender(SDL_FRect{ 0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height) });
 	
     // Copy our texture onto the main renderer
     SDL_RenderTexture(GameEngine::renderer, morphTexture, nullptr, &destRect);
@@ -215,25 +222,24 @@ void OlympeSystem::Render()
 
 void OlympeSystem::GenerateGradient()
 {
-    // Fill texture with interpolated colors based on color points
-    const int steps = 6;
+    // Fill the CPU buffer with colors interpolated between the color points (SIMD, split by rows)
+    if (!gradientTexture) return;
+    const int gw = gradientTexture->w, gh = gradientTexture->h;
 
-    SDL_SetTextureBlendMode(morphTexture, SDL_BLENDMODE_BLEND);
+    ImageKernels::ColorFieldPoint field[16];
+    int count = 0;
     for (auto& cp : points) {
-        SDL_SetRenderDrawColor(GameEngine::renderer, cp.color.r, cp.color.g, cp.color.b, 220);
-        int radius = width / steps;
-        //SDL_FRect circleRect = { cp.x * width - radius / 2, cp.y * height - radius / 2, float(radius), float(radius) };
-        //SDL_RenderFillRect(GameEngine::renderer, &circleRect);
-		Draw_FilledCircle(GameEngine::renderer, static_cast<int>(cp.x * width), static_cast<int>(cp.y * height), radius);
+        if (count == SDL_arraysize(field)) break;
+        field[count++] = { cp.x * gw, cp.y * gh, float(cp.color.r), float(cp.color.g), float(cp.color.b) };
     }
+    // softness ~ spot radius: large values give wide soft spots
+    const float radius = float(gw) / 6.f;
+    ImageKernels::ColorField(gradientPixels.data(), gw, gh, field, count, radius * radius);
 }
 
 void OlympeSystem::ApplyBlur(int passes)
 {
-    // Simple blur: multiple passes with semi-transparent overlays
-    SDL_SetTextureBlendMode(morphTexture, SDL_BLENDMODE_ADD);
-    for (int i = 0; i < passes; ++i) {
-        SDL_SetTextureAlphaMod(morphTexture, 180 - i * 40);
-        SDL_RenderTexture(GameEngine::renderer, morphTexture, nullptr, nullptr);
-    }
-}
\ No newline at end of file
+    // Separable box blur on the CPU buffer (3 passes ~ gaussian)
+    if (!gradientTexture) return;
+    ImageKernels::BoxBlur(gradientPixels.data(), blurScratch, gradientTexture->w, gradientTexture->h, blurRadius, passes);
+}
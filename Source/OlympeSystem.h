@@ -3,6 +3,8 @@
 #include <SDL3/SDL.h>
 #include <vector>
 
+class ParticleEmitter;
+
 class OlympeSystem : public ObjectComponent
 {
 	public:
@@ -26,6 +28,8 @@ class OlympeSystem : public ObjectComponent
 	SDL_Texture* logoTexture = nullptr;
 	SDL_Texture* backgroundTexture = nullptr;
 
+	ParticleEmitter* m_snow = nullptr; // snow points (owned by ParticleSystem)
+
 	int width = 800, height = 600;
 	float time = 0.f;
 
@@ -35,6 +39,15 @@ class OlympeSystem : public ObjectComponent
 	};
 	std::vector<ColorPoint> points;
 
+	// Animated background (used when no background image is available): the color field is computed
+	// on the CPU at 1/gradientScale of the screen resolution and upscaled by the GPU
+	SDL_Texture* gradientTexture = nullptr; // streaming, ARGB8888
+	int gradientScale = 2;
+	int blurRadius = 6;
+	bool animatedBackground = false;
+	std::vector<uint32_t> gradientPixels;
+	std::vector<uint32_t> blurScratch;
+
 	void GenerateGradient(); // Fill the texture with interpolated colors
 	void ApplyBlur(int passes = 2); // Apply soft blur
 
@@ -0,0 +1,292 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- Implementation of ParticleEmitter (SoA pool, SIMD integration kernel,
+  swap-kill, batched rendering) and ParticleSystem (emitter updates).
+*/
+
+#include "ParticleSystem.h"
+#include "GameEngine.h"
+#include "system/JobSystem.h"
+#include "system/system_utils.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OLYMPE_PARTICLES_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    inline float RandRange(float a, float b)
+    {
+        return a + SDL_randf() * (b - a);
+    }
+
+    // Particles per job when the update is split between workers
+    const size_t k_PARALLEL_GRAIN = 16384;
+}
+
+//-------------------------------------------------------------
+ParticleEmitter::ParticleEmitter(const ParticleEmitterDesc& desc)
+    : m_desc(desc)
+{
+    const size_t n = m_desc.capacity;
+    m_x.resize(n); m_y.resize(n);
+    m_vx.resize(n); m_vy.resize(n);
+    m_age.resize(n); m_invLife.resize(n);
+    m_r.resize(n); m_g.resize(n); m_b.resize(n); m_a.resize(n);
+}
+//-------------------------------------------------------------
+void ParticleEmitter::SpawnOne(const SDL_FRect& area)
+{
+    const size_t i = m_count++;
+    m_x[i] = area.x + SDL_randf() * area.w;
+    m_y[i] = area.y + SDL_randf() * area.h;
+
+    const float angle = (m_desc.spread > 0.0f) ? RandRange(-m_desc.spread, m_desc.spread) : 0.0f;
+    const float speed = RandRange(m_desc.speedMin, m_desc.speedMax);
+    const float c = std::cos(angle), s = std::sin(angle);
+    m_vx[i] = (m_desc.direction.x * c - m_desc.direction.y * s) * speed;
+    m_vy[i] = (m_desc.direction.x * s + m_desc.direction.y * c) * speed;
+
+    const float life = RandRange(m_desc.lifetimeMin, m_desc.lifetimeMax);
+    m_age[i] = 0.0f;
+    m_invLife[i] = (life > 0.0f) ? 1.0f / life : 0.0f;
+
+    m_r[i] = m_desc.colorStart.r;
+    m_g[i] = m_desc.colorStart.g;
+    m_b[i] = m_desc.colorStart.b;
+    m_a[i] = m_desc.colorStart.a;
+}
+//-------------------------------------------------------------
+void ParticleEmitter::Prewarm(size_t n, const SDL_FRect& area)
+{
+    n = std::min(n, m_desc.capacity - m_count);
+    for (size_t k = 0; k < n; ++k) SpawnOne(area);
+}
+//-------------------------------------------------------------
+void ParticleEmitter::Spawn(float dt)
+{
+    if (!m_active) return;
+
+    size_t n;
+    if (m_desc.spawnRate <= 0.0f)
+    {
+        n = m_desc.capacity - m_count; // keep the pool full
+    }
+    else
+    {
+        m_spawnAccumulator += m_desc.spawnRate * dt;
+        n = static_cast<size_t>(m_spawnAccumulator);
+        m_spawnAccumulator -= static_cast<float>(n);
+        n = std::min(n, m_desc.capacity - m_count);
+    }
+    for (size_t k = 0; k < n; ++k) SpawnOne(m_desc.spawnArea);
+}
+//-------------------------------------------------------------
+void ParticleEmitter::Integrate(size_t begin, size_t end, float dt)
+{
+    const SDL_FColor& c0 = m_desc.colorStart;
+    const SDL_FColor& c1 = m_desc.colorEnd;
+    const bool fade = (c0.r != c1.r || c0.g != c1.g || c0.b != c1.b || c0.a != c1.a);
+
+    float* x = m_x.data(); float* y = m_y.data();
+    float* vx = m_vx.data(); float* vy = m_vy.data();
+    float* age = m_age.data(); const float* invLife = m_invLife.data();
+    float* r = m_r.data(); float* g = m_g.data(); float* b = m_b.data(); float* a = m_a.data();
+
+    size_t i = begin;
+#ifdef OLYMPE_PARTICLES_SSE2
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 vgx = _mm_set1_ps(m_desc.gravity.x * dt);
+    const __m128 vgy = _mm_set1_ps(m_desc.gravity.y * dt);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 r0 = _mm_set1_ps(c0.r), dr = _mm_set1_ps(c1.r - c0.r);
+    const __m128 g0 = _mm_set1_ps(c0.g), dg = _mm_set1_ps(c1.g - c0.g);
+    const __m128 b0 = _mm_set1_ps(c0.b), db = _mm_set1_ps(c1.b - c0.b);
+    const __m128 a0 = _mm_set1_ps(c0.a), da = _mm_set1_ps(c1.a - c0.a);
+
+    for (; i + 4 <= end; i += 4)
+    {
+        const __m128 nvx = _mm_add_ps(_mm_loadu_ps(vx + i), vgx);
+        const __m128 nvy = _mm_add_ps(_mm_loadu_ps(vy + i), vgy);
+        _mm_storeu_ps(vx + i, nvx);
+        _mm_storeu_ps(vy + i, nvy);
+        _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(nvx, vdt)));
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(nvy, vdt)));
+        const __m128 nage = _mm_add_ps(_mm_loadu_ps(age + i), vdt);
+        _mm_storeu_ps(age + i, nage);
+
+        if (fade)
+        {
+            const __m128 t = _mm_min_ps(_mm_mul_ps(nage, _mm_loadu_ps(invLife + i)), one);
+            _mm_storeu_ps(r + i, _mm_add_ps(r0, _mm_mul_ps(dr, t)));
+            _mm_storeu_ps(g + i, _mm_add_ps(g0, _mm_mul_ps(dg, t)));
+            _mm_storeu_ps(b + i, _mm_add_ps(b0, _mm_mul_ps(db, t)));
+            _mm_storeu_ps(a + i, _mm_add_ps(a0, _mm_mul_ps(da, t)));
+        }
+    }
+#endif
+    // scalar path (remainder, or whole range without SSE2)
+    const float gx = m_desc.gravity.x * dt;
+    const float gy = m_desc.gravity.y * dt;
+    for (; i < end; ++i)
+    {
+        vx[i] += gx;
+        vy[i] += gy;
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        age[i] += dt;
+        if (fade)
+        {
+            const float t = std::min(age[i] * invLife[i], 1.0f);
+            r[i] = c0.r + (c1.r - c0.r) * t;
+            g[i] = c0.g + (c1.g - c0.g) * t;
+            b[i] = c0.b + (c1.b - c0.b) * t;
+            a[i] = c0.a + (c1.a - c0.a) * t;
+        }
+    }
+}
+//-------------------------------------------------------------
+void ParticleEmitter::KillAt(size_t i)
+{
+    // swap-kill: the last live particle takes the slot
+    const size_t last = --m_count;
+    if (i == last) return;
+    m_x[i] = m_x[last]; m_y[i] = m_y[last];
+    m_vx[i] = m_vx[last]; m_vy[i] = m_vy[last];
+    m_age[i] = m_age[last]; m_invLife[i] = m_invLife[last];
+    m_r[i] = m_r[last]; m_g[i] = m_g[last]; m_b[i] = m_b[last]; m_a[i] = m_a[last];
+}
+//-------------------------------------------------------------
+void ParticleEmitter::KillDead()
+{
+    const SDL_FRect& kb = m_desc.killBounds;
+    const bool bounded = (kb.w > 0.0f && kb.h > 0.0f);
+    const float xmax = kb.x + kb.w, ymax = kb.y + kb.h;
+
+    size_t i = 0;
+    while (i < m_count)
+    {
+        const bool expired = (m_invLife[i] > 0.0f && m_age[i] * m_invLife[i] >= 1.0f);
+        const bool outside = bounded && (m_x[i] < kb.x || m_x[i] >= xmax || m_y[i] < kb.y || m_y[i] >= ymax);
+        if (expired || outside) KillAt(i); // slot i now holds another particle: test it again
+        else ++i;
+    }
+}
+//-------------------------------------------------------------
+bool ParticleEmitter::DrawsAsPoints() const
+{
+    const SDL_FColor& c0 = m_desc.colorStart;
+    const SDL_FColor& c1 = m_desc.colorEnd;
+    return m_desc.size <= 1.0f && !m_desc.texture &&
+        c0.r == c1.r && c0.g == c1.g && c0.b == c1.b && c0.a == c1.a;
+}
+//-------------------------------------------------------------
+void ParticleEmitter::Render(SDL_Renderer* renderer, float offsetX, float offsetY)
+{
+    if (!renderer || m_count == 0) return;
+
+    if (DrawsAsPoints())
+    {
+        m_points.resize(m_count);
+        for (size_t i = 0; i < m_count; ++i) m_points[i] = { m_x[i] + offsetX, m_y[i] + offsetY };
+
+        const SDL_FColor& c = m_desc.colorStart;
+        SDL_SetRenderDrawColorFloat(renderer, c.r, c.g, c.b, c.a);
+        SDL_RenderPoints(renderer, m_points.data(), static_cast<int>(m_count));
+        return;
+    }
+
+    // colored (and optionally textured) quads centered on the particles
+    const float h = m_desc.size * 0.5f;
+    m_vertices.resize(m_count * 4);
+    if (m_indices.size() < m_count * 6)
+    {
+        size_t q = m_indices.size() / 6;
+        m_indices.resize(m_count * 6);
+        for (; q < m_count; ++q)
+        {
+            const int v = static_cast<int>(q * 4);
+            int* idx = &m_indices[q * 6];
+            idx[0] = v; idx[1] = v + 1; idx[2] = v + 2;
+            idx[3] = v; idx[4] = v + 2; idx[5] = v + 3;
+        }
+    }
+    SDL_Vertex* vtx = m_vertices.data();
+    for (size_t i = 0; i < m_count; ++i, vtx += 4)
+    {
+        const float cx = m_x[i] + offsetX, cy = m_y[i] + offsetY;
+        const SDL_FColor c = { m_r[i], m_g[i], m_b[i], m_a[i] };
+        vtx[0] = { { cx - h, cy - h }, c, { 0.0f, 0.0f } };
+        vtx[1] = { { cx + h, cy - h }, c, { 1.0f, 0.0f } };
+        vtx[2] = { { cx + h, cy + h }, c, { 1.0f, 1.0f } };
+        vtx[3] = { { cx - h, cy + h }, c, { 0.0f, 1.0f } };
+    }
+    SDL_RenderGeometry(renderer, m_desc.texture, m_vertices.data(), static_cast<int>(m_count * 4),
+        m_indices.data(), static_cast<int>(m_count * 6));
+}
+
+//-------------------------------------------------------------
+ParticleSystem::ParticleSystem()
+{
+    name = "ParticleSystem";
+    SYSTEM_LOG << "ParticleSystem created\n";
+}
+//-------------------------------------------------------------
+ParticleSystem::~ParticleSystem()
+{
+    SYSTEM_LOG << "ParticleSystem destroyed\n";
+}
+//-------------------------------------------------------------
+ParticleSystem& ParticleSystem::GetInstance()
+{
+    static ParticleSystem instance;
+    return instance;
+}
+//-------------------------------------------------------------
+ParticleEmitter* ParticleSystem::CreateEmitter(const ParticleEmitterDesc& desc)
+{
+    m_emitters.push_back(std::unique_ptr<ParticleEmitter>(new ParticleEmitter(desc)));
+    return m_emitters.back().get();
+}
+//-------------------------------------------------------------
+void ParticleSystem::DestroyEmitter(ParticleEmitter* emitter)
+{
+    auto it = std::find_if(m_emitters.begin(), m_emitters.end(),
+        [emitter](const std::unique_ptr<ParticleEmitter>& e) { return e.get() == emitter; });
+    if (it != m_emitters.end()) m_emitters.erase(it);
+}
+//-------------------------------------------------------------
+void ParticleSystem::Process()
+{
+    const float dt = GameEngine::fDt;
+    for (auto& e : m_emitters)
+    {
+        ParticleEmitter* emitter = e.get();
+        const size_t count = emitter->GetLiveCount();
+        if (m_parallel && count >= m_parallelThreshold)
+        {
+            JobSystem::Get().ParallelFor(count, k_PARALLEL_GRAIN,
+                [emitter, dt](size_t begin, size_t end) { emitter->Integrate(begin, end, dt); });
+        }
+        else
+        {
+            emitter->Integrate(0, count, dt);
+        }
+        emitter->KillDead();
+        emitter->Spawn(dt);
+    }
+}
+//-------------------------------------------------------------
+size_t ParticleSystem::GetLiveParticleCount() const
+{
+    size_t n = 0;
+    for (const auto& e : m_emitters) n += e->GetLiveCount();
+    return n;
+}
@@ -0,0 +1,131 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- ParticleEmitter owns a fixed capacity particle pool stored as parallel
+  arrays (SoA: x[], y[], vx[], vy[], age[], ...) so that the update kernel
+  streams through contiguous floats (SSE2, 4 particles per iteration, with a
+  scalar fallback) and the renderer can submit the whole pool in one call.
+- Dead particles are removed with a swap-kill (the last live particle takes
+  the slot): O(1), live particles always stay packed in [0, count).
+- ParticleSystem is the singleton owning the emitters and updating them once
+  per frame (World::Process). Large pools are split in chunks processed by
+  the JobSystem (SetParallelUpdate / SetParallelThreshold).
+
+Notes:
+- Emitters are drawn by their owner (e.g. OlympeSystem::Render) with
+  ParticleEmitter::Render(): one SDL_RenderPoints call when particles are
+  1 pixel points of a constant color, otherwise one SDL_RenderGeometry call
+  (colored quads, optionally textured) per emitter.
+- Spawning and killing run on the main thread; only the integration kernel
+  (velocity, gravity, lifetime, color fade) is parallel.
+- Positions are in the emitter's own space: Render() takes the offset to
+  apply (camera position for world-space effects, 0 for screen-space ones).
+*/
+#pragma once
+
+#include "object.h"
+#include <SDL3/SDL.h>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+struct ParticleEmitterDesc
+{
+    size_t capacity = 1024;
+    float spawnRate = 0.0f;         // particles per second, <= 0: keep the pool full
+    float lifetimeMin = 1.0f;       // seconds, <= 0: infinite (killed by killBounds only)
+    float lifetimeMax = 1.0f;
+
+    SDL_FRect spawnArea = { 0.0f, 0.0f, 0.0f, 0.0f };   // particles spawn uniformly in this rect
+    SDL_FRect killBounds = { 0.0f, 0.0f, 0.0f, 0.0f };  // particles leaving it die (w <= 0: no bounds)
+
+    SDL_FPoint direction = { 0.0f, -1.0f }; // initial velocity = rotate(direction, +-spread) * speed
+    float spread = 0.0f;                    // radians
+    float speedMin = 10.0f;
+    float speedMax = 10.0f;
+    SDL_FPoint gravity = { 0.0f, 0.0f };    // pixels / s^2
+
+    SDL_FColor colorStart = { 1.0f, 1.0f, 1.0f, 1.0f }; // color at birth, faded to colorEnd over the lifetime
+    SDL_FColor colorEnd = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+    float size = 1.0f;                  // <= 1 and constant color: drawn as points
+    SDL_Texture* texture = nullptr;     // quads only (nullptr: plain colored quads)
+};
+
+class ParticleEmitter
+{
+public:
+    explicit ParticleEmitter(const ParticleEmitterDesc& desc);
+
+    const ParticleEmitterDesc& GetDesc() const { return m_desc; }
+    size_t GetLiveCount() const { return m_count; }
+    size_t GetCapacity() const { return m_desc.capacity; }
+
+    void SetSpawnArea(const SDL_FRect& area) { m_desc.spawnArea = area; }
+    void SetKillBounds(const SDL_FRect& bounds) { m_desc.killBounds = bounds; }
+    void SetActive(bool active) { m_active = active; } // inactive: no spawn, live particles finish their life
+
+    // Spawn up to 'n' particles in 'area' (e.g. to fill the screen at startup)
+    void Prewarm(size_t n, const SDL_FRect& area);
+    void Clear() { m_count = 0; }
+
+    // Integration kernel on the particles [begin, end)
+    void Integrate(size_t begin, size_t end, float dt);
+    // Spawn / kill pass (main thread)
+    void Spawn(float dt);
+    void KillDead();
+
+    void Render(SDL_Renderer* renderer, float offsetX = 0.0f, float offsetY = 0.0f);
+
+private:
+    void SpawnOne(const SDL_FRect& area);
+    void KillAt(size_t i);
+    bool DrawsAsPoints() const;
+
+    ParticleEmitterDesc m_desc;
+    bool m_active = true;
+    float m_spawnAccumulator = 0.0f;
+    size_t m_count = 0;
+
+    // SoA pool, m_desc.capacity entries each
+    std::vector<float> m_x, m_y, m_vx, m_vy;
+    std::vector<float> m_age, m_invLife;        // invLife = 0: immortal
+    std::vector<float> m_r, m_g, m_b, m_a;
+
+    // render scratch buffers
+    std::vector<SDL_FPoint> m_points;
+    std::vector<SDL_Vertex> m_vertices;
+    std::vector<int> m_indices;
+};
+
+class ParticleSystem : public Object
+{
+public:
+    ParticleSystem();
+    virtual ~ParticleSystem();
+
+    virtual ObjectType GetObjectType() const override { return ObjectType::Singleton; }
+
+    static ParticleSystem& GetInstance();
+    static ParticleSystem& Get() { return GetInstance(); }
+
+    ParticleEmitter* CreateEmitter(const ParticleEmitterDesc& desc);
+    void DestroyEmitter(ParticleEmitter* emitter);
+
+    // Update every emitter: spawn, integrate, kill (called once per frame by World::Process)
+    void Process();
+
+    void SetParallelUpdate(bool enable) { m_parallel = enable; }
+    // Minimum live count of an emitter for its update to be split between workers
+    void SetParallelThreshold(size_t count) { m_parallelThreshold = count; }
+
+    size_t GetLiveParticleCount() const;
+
+private:
+    std::vector<std::unique_ptr<ParticleEmitter>> m_emitters;
+    bool m_parallel = true;
+    size_t m_parallelThreshold = 32768;
+};
@@ -0,0 +1,608 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- Implementation of PathfindingManager: A* / Jump Point Search on the
+  CollisionMap grid, request merging, LRU path cache and per-frame budgets.
+
+Notes:
+- Each worker thread owns a SearchContext (thread_local) whose node arrays
+  are reused between searches. Nodes are invalidated with a generation stamp
+  so no clear is needed between two searches.
+*/
+
+#include "Pathfinding.h"
+#include "system/JobSystem.h"
+#include "system/system_utils.h"
+#include <SDL3/SDL_timer.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+    const float k_SQRT2 = 1.41421356f;
+
+    // Octile distance between two cells (unit straight cost, sqrt(2) diagonal cost)
+    inline float Octile(int x0, int y0, int x1, int y1)
+    {
+        const int dx = std::abs(x1 - x0);
+        const int dy = std::abs(y1 - y0);
+        return static_cast<float>(dx + dy) + (k_SQRT2 - 2.0f) * static_cast<float>(std::min(dx, dy));
+    }
+
+    inline int Sign(int v) { return (v > 0) - (v < 0); }
+
+    struct OpenNode
+    {
+        float f;
+        int32_t index;
+    };
+    struct OpenNodeGreater
+    {
+        bool operator()(const OpenNode& a, const OpenNode& b) const { return a.f > b.f; }
+    };
+
+    // Node pool reused between searches on the same thread
+    struct SearchContext
+    {
+        std::vector<float> g;
+        std::vector<int32_t> parent;
+        std::vector<uint32_t> stamp;   // == generation when the node was reached this search
+        std::vector<uint8_t> closed;   // valid only when stamp == generation
+        std::vector<OpenNode> open;    // binary heap
+        uint32_t generation = 0;
+
+        void Prepare(size_t cellCount)
+        {
+            if (g.size() < cellCount)
+            {
+                g.resize(cellCount);
+                parent.resize(cellCount);
+                stamp.resize(cellCount, 0);
+                closed.resize(cellCount);
+            }
+            open.clear();
+            if (++generation == 0)
+            {
+                // wrapped around: reset stamps once every 4 billion searches
+                std::fill(stamp.begin(), stamp.end(), 0u);
+                generation = 1;
+            }
+        }
+
+        inline bool Reached(int32_t i) const { return stamp[i] == generation; }
+        inline bool IsClosed(int32_t i) const { return Reached(i) && closed[i] != 0; }
+
+        void Push(int32_t i, float f)
+        {
+            open.push_back({ f, i });
+            std::push_heap(open.begin(), open.end(), OpenNodeGreater());
+        }
+        OpenNode Pop()
+        {
+            std::pop_heap(open.begin(), open.end(), OpenNodeGreater());
+            OpenNode n = open.back();
+            open.pop_back();
+            return n;
+        }
+    };
+
+    thread_local SearchContext t_context;
+
+    //---------------------------------------------------------
+    // Jump Point Search helpers (variant without corner cutting: a diagonal
+    // move requires both adjacent straight cells to be walkable)
+    int32_t JumpStraight(const NavGrid& grid, int x, int y, int dx, int dy, int32_t goal)
+    {
+        while (true)
+        {
+            if (!grid.IsWalkable(x, y)) return -1;
+            const int32_t idx = grid.Index(x, y);
+            if (idx == goal) return idx;
+
+            if (dx != 0)
+            {
+                if ((grid.IsWalkable(x, y - 1) && !grid.IsWalkable(x - dx, y - 1)) ||
+                    (grid.IsWalkable(x, y + 1) && !grid.IsWalkable(x - dx, y + 1)))
+                    return idx;
+            }
+            else
+            {
+                if ((grid.IsWalkable(x - 1, y) && !grid.IsWalkable(x - 1, y - dy)) ||
+                    (grid.IsWalkable(x + 1, y) && !grid.IsWalkable(x + 1, y - dy)))
+                    return idx;
+            }
+            x += dx;
+            y += dy;
+        }
+    }
+
+    int32_t JumpDiagonal(const NavGrid& grid, int x, int y, int dx, int dy, int32_t goal)
+    {
+        while (true)
+        {
+            if (!grid.IsWalkable(x, y)) return -1;
+            const int32_t idx = grid.Index(x, y);
+            if (idx == goal) return idx;
+
+            if (JumpStraight(grid, x + dx, y, dx, 0, goal) >= 0 || JumpStraight(grid, x, y + dy, 0, dy, goal) >= 0)
+                return idx;
+
+            if (!grid.IsWalkable(x + dx, y) || !grid.IsWalkable(x, y + dy)) return -1;
+            x += dx;
+            y += dy;
+        }
+    }
+
+    inline int32_t Jump(const NavGrid& grid, int x, int y, int dx, int dy, int32_t goal)
+    {
+        return (dx != 0 && dy != 0) ? JumpDiagonal(grid, x, y, dx, dy, goal) : JumpStraight(grid, x, y, dx, dy, goal);
+    }
+
+    // Fill 'dirs' with the directions to explore from (x,y). Returns the count.
+    int PrunedDirections(const NavGrid& grid, int x, int y, int dx, int dy, int dirs[8][2])
+    {
+        int n = 0;
+        auto add = [&dirs, &n](int ax, int ay) { dirs[n][0] = ax; dirs[n][1] = ay; ++n; };
+
+        if (dx == 0 && dy == 0)
+        {
+            // start node: every walkable neighbor
+            for (int oy = -1; oy <= 1; ++oy)
+                for (int ox = -1; ox <= 1; ++ox)
+                {
+                    if (ox == 0 && oy == 0) continue;
+                    if (ox != 0 && oy != 0 && (!grid.IsWalkable(x + ox, y) || !grid.IsWalkable(x, y + oy))) continue;
+                    if (grid.IsWalkable(x + ox, y + oy)) add(ox, oy);
+                }
+            return n;
+        }
+
+        if (dx != 0 && dy != 0)
+        {
+            const bool wx = grid.IsWalkable(x + dx, y);
+            const bool wy = grid.IsWalkable(x, y + dy);
+            if (wy) add(0, dy);
+            if (wx) add(dx, 0);
+            if (wx && wy) add(dx, dy);
+        }
+        else if (dx != 0)
+        {
+            const bool next = grid.IsWalkable(x + dx, y);
+            const bool up = grid.IsWalkable(x, y - 1);
+            const bool down = grid.IsWalkable(x, y + 1);
+            if (next)
+            {
+                add(dx, 0);
+                if (up) add(dx, -1);
+                if (down) add(dx, 1);
+            }
+            if (up) add(0, -1);
+            if (down) add(0, 1);
+        }
+        else
+        {
+            const bool next = grid.IsWalkable(x, y + dy);
+            const bool left = grid.IsWalkable(x - 1, y);
+            const bool right = grid.IsWalkable(x + 1, y);
+            if (next)
+            {
+                add(0, dy);
+                if (left) add(-1, dy);
+                if (right) add(1, dy);
+            }
+            if (left) add(-1, 0);
+            if (right) add(1, 0);
+        }
+        return n;
+    }
+}
+
+//-------------------------------------------------------------
+PathfindingManager::PathfindingManager()
+{
+    name = "PathfindingManager";
+    SYSTEM_LOG << "PathfindingManager created\n";
+}
+//-------------------------------------------------------------
+PathfindingManager::~PathfindingManager()
+{
+    SYSTEM_LOG << "PathfindingManager destroyed\n";
+}
+//-------------------------------------------------------------
+PathfindingManager& PathfindingManager::GetInstance()
+{
+    static PathfindingManager instance;
+    return instance;
+}
+//-------------------------------------------------------------
+void PathfindingManager::SetCollisionMap(const CollisionMap* map)
+{
+    m_map = map;
+    m_grid.reset();
+    RefreshGrid();
+}
+//-------------------------------------------------------------
+void PathfindingManager::SetCacheCapacity(size_t n)
+{
+    m_cacheCapacity = (n > 0) ? n : 1;
+    while (m_cache.size() > m_cacheCapacity)
+    {
+        m_cache.erase(m_lru.back());
+        m_lru.pop_back();
+    }
+}
+//-------------------------------------------------------------
+PathfindingManager::Stats PathfindingManager::GetStats() const
+{
+    Stats s = m_stats;
+    s.queued = m_queue.size();
+    s.inFlight = m_inFlight;
+    return s;
+}
+//-------------------------------------------------------------
+void PathfindingManager::RefreshGrid()
+{
+    if (!m_map || m_map->width <= 0 || m_map->height <= 0)
+    {
+        m_grid.reset();
+        return;
+    }
+    if (m_grid && m_grid->version == m_map->GetVersion()) return;
+
+    auto grid = std::make_shared<NavGrid>();
+    grid->width = m_map->width;
+    grid->height = m_map->height;
+    grid->cellSize = m_map->cellSize;
+    grid->version = m_map->GetVersion();
+    const std::vector<int>& data = m_map->GetData();
+    grid->blocked.resize(data.size());
+    for (size_t i = 0; i < data.size(); ++i) grid->blocked[i] = (data[i] != 0) ? 1 : 0;
+    m_grid = grid;
+
+    // paths computed on older versions can no longer be hit: drop them
+    m_cache.clear();
+    m_lru.clear();
+}
+//-------------------------------------------------------------
+PathRequestID PathfindingManager::RequestPath(const Vector& start, const Vector& goal)
+{
+    PathRequestID id = m_nextRequestID++;
+    if (m_nextRequestID == INVALID_PATH_REQUEST) m_nextRequestID = 1;
+    RequestSlot& slot = m_requests[id];
+
+    RefreshGrid();
+    if (!m_grid)
+    {
+        slot.status = PathStatus::NotFound;
+        return id;
+    }
+
+    const NavGrid& grid = *m_grid;
+    const int sx = static_cast<int>(std::floor(start.x / grid.cellSize));
+    const int sy = static_cast<int>(std::floor(start.y / grid.cellSize));
+    const int gx = static_cast<int>(std::floor(goal.x / grid.cellSize));
+    const int gy = static_cast<int>(std::floor(goal.y / grid.cellSize));
+    if (!grid.IsWalkable(sx, sy) || !grid.IsWalkable(gx, gy))
+    {
+        slot.status = PathStatus::NotFound;
+        return id;
+    }
+
+    PathKey key;
+    key.start = grid.Index(sx, sy);
+    key.goal = grid.Index(gx, gy);
+    key.version = grid.version;
+
+    PathPtr cached;
+    bool found = false;
+    if (LookupCache(key, cached, found))
+    {
+        ++m_stats.cacheHits;
+        slot.status = found ? PathStatus::Found : PathStatus::NotFound;
+        slot.path = cached;
+        return id;
+    }
+
+    auto it = m_searches.find(key);
+    if (it != m_searches.end())
+    {
+        ++m_stats.mergedRequests;
+        it->second.waiters.push_back(id);
+        return id;
+    }
+
+    Search& search = m_searches[key];
+    search.waiters.push_back(id);
+    m_queue.push_back(key);
+    return id;
+}
+//-------------------------------------------------------------
+PathStatus PathfindingManager::GetPathResult(PathRequestID id, PathPtr& outPath) const
+{
+    auto it = m_requests.find(id);
+    if (it == m_requests.end()) return PathStatus::Invalid;
+    outPath = it->second.path;
+    return it->second.status;
+}
+//-------------------------------------------------------------
+void PathfindingManager::ReleaseRequest(PathRequestID id)
+{
+    // waiters lists may still reference the id: Resolve() ignores released ids
+    m_requests.erase(id);
+}
+//-------------------------------------------------------------
+void PathfindingManager::Process()
+{
+    RefreshGrid();
+    PublishCompleted();
+    DispatchSearches();
+}
+//-------------------------------------------------------------
+void PathfindingManager::PublishCompleted()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_completedMutex);
+        for (auto& c : m_completed) m_publishing.push_back(std::move(c));
+        m_completed.clear();
+    }
+    if (m_publishing.empty()) return;
+
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+    const Uint64 startTicks = SDL_GetPerformanceCounter();
+    const Uint64 budgetTicks = static_cast<Uint64>(m_publishBudgetMs * 0.001 * static_cast<double>(freq));
+
+    while (!m_publishing.empty())
+    {
+        CompletedSearch c = std::move(m_publishing.front());
+        m_publishing.pop_front();
+        if (m_inFlight > 0) --m_inFlight;
+
+        if (m_grid && c.key.version != m_grid->version)
+        {
+            // map changed while searching: restart the search on the new grid for the same cells
+            auto it = m_searches.find(c.key);
+            if (it != m_searches.end())
+            {
+                Search stale = std::move(it->second);
+                m_searches.erase(it);
+                PathKey fresh = c.key;
+                fresh.version = m_grid->version;
+                if (fresh.start < static_cast<int32_t>(m_grid->blocked.size()) && fresh.goal < static_cast<int32_t>(m_grid->blocked.size())
+                    && m_grid->blocked[fresh.start] == 0 && m_grid->blocked[fresh.goal] == 0)
+                {
+                    Search& s = m_searches[fresh];
+                    if (s.waiters.empty() && !s.dispatched) m_queue.push_back(fresh);
+                    s.waiters.insert(s.waiters.end(), stale.waiters.begin(), stale.waiters.end());
+                }
+                else
+                {
+                    for (PathRequestID id : stale.waiters)
+                    {
+                        auto r = m_requests.find(id);
+                        if (r != m_requests.end()) r->second.status = PathStatus::NotFound;
+                    }
+                }
+            }
+        }
+        else
+        {
+            PathPtr path = c.found ? std::make_shared<const PathWaypoints>(std::move(c.waypoints)) : PathPtr();
+            StoreCache(c.key, path);
+            Resolve(c.key, path, c.found);
+        }
+
+        if (SDL_GetPerformanceCounter() - startTicks >= budgetTicks) break;
+    }
+}
+//-------------------------------------------------------------
+void PathfindingManager::Resolve(const PathKey& key, const PathPtr& path, bool found)
+{
+    auto it = m_searches.find(key);
+    if (it == m_searches.end()) return;
+    for (PathRequestID id : it->second.waiters)
+    {
+        auto r = m_requests.find(id);
+        if (r == m_requests.end()) continue; // released meanwhile
+        r->second.status = found ? PathStatus::Found : PathStatus::NotFound;
+        r->second.path = path;
+    }
+    m_searches.erase(it);
+}
+//-------------------------------------------------------------
+void PathfindingManager::DispatchSearches()
+{
+    if (m_queue.empty() || !m_grid) return;
+
+    // do not let the worker backlog grow without bound
+    const size_t maxInFlight = static_cast<size_t>(m_maxSearchesPerFrame) * 4;
+    if (m_inFlight >= maxInFlight) return;
+    size_t count = std::min(m_queue.size(), static_cast<size_t>(m_maxSearchesPerFrame));
+    count = std::min(count, maxInFlight - m_inFlight);
+
+    std::vector<PathKey> batch;
+    batch.reserve(count);
+    while (batch.size() < count && !m_queue.empty())
+    {
+        PathKey key = m_queue.front();
+        m_queue.pop_front();
+        auto it = m_searches.find(key);
+        if (it == m_searches.end()) continue;
+        it->second.dispatched = true;
+        batch.push_back(key);
+    }
+    if (batch.empty()) return;
+
+    m_inFlight += batch.size();
+    m_stats.searches += batch.size();
+
+    // split in one job per worker so a burst of requests uses every core
+    const size_t workers = std::max<size_t>(1, JobSystem::Get().GetWorkerCount());
+    const size_t perJob = (batch.size() + workers - 1) / workers;
+    std::shared_ptr<const NavGrid> grid = m_grid;
+    const bool useJPS = m_useJPS;
+
+    for (size_t begin = 0; begin < batch.size(); begin += perJob)
+    {
+        const size_t end = std::min(batch.size(), begin + perJob);
+        std::vector<PathKey> keys(batch.begin() + begin, batch.begin() + end);
+        JobSystem::Get().Submit([this, grid, useJPS, keys]()
+        {
+            std::vector<CompletedSearch> results(keys.size());
+            for (size_t i = 0; i < keys.size(); ++i)
+            {
+                const PathKey& k = keys[i];
+                results[i].key = k;
+                results[i].found = FindPath(*grid, k.start % grid->width, k.start / grid->width,
+                    k.goal % grid->width, k.goal / grid->width, useJPS, results[i].waypoints);
+            }
+            std::lock_guard<std::mutex> lock(m_completedMutex);
+            for (auto& r : results) m_completed.push_back(std::move(r));
+        }, JobPriority::Normal);
+    }
+}
+//-------------------------------------------------------------
+bool PathfindingManager::LookupCache(const PathKey& key, PathPtr& outPath, bool& outFound)
+{
+    auto it = m_cache.find(key);
+    if (it == m_cache.end()) return false;
+    m_lru.splice(m_lru.begin(), m_lru, it->second.lruIt);
+    outPath = it->second.path;
+    outFound = (outPath != nullptr);
+    return true;
+}
+//-------------------------------------------------------------
+void PathfindingManager::StoreCache(const PathKey& key, const PathPtr& path)
+{
+    auto it = m_cache.find(key);
+    if (it != m_cache.end())
+    {
+        it->second.path = path;
+        m_lru.splice(m_lru.begin(), m_lru, it->second.lruIt);
+        return;
+    }
+    while (m_cache.size() >= m_cacheCapacity && !m_lru.empty())
+    {
+        m_cache.erase(m_lru.back());
+        m_lru.pop_back();
+    }
+    m_lru.push_front(key);
+    CacheEntry& e = m_cache[key];
+    e.path = path;
+    e.lruIt = m_lru.begin();
+}
+//-------------------------------------------------------------
+bool PathfindingManager::FindPath(const NavGrid& grid, int sx, int sy, int gx, int gy, bool useJumpPointSearch, PathWaypoints& outWaypoints)
+{
+    outWaypoints.clear();
+    if (!grid.IsWalkable(sx, sy) || !grid.IsWalkable(gx, gy)) return false;
+
+    const int32_t start = grid.Index(sx, sy);
+    const int32_t goal = grid.Index(gx, gy);
+
+    SearchContext& ctx = t_context;
+    ctx.Prepare(static_cast<size_t>(grid.width) * static_cast<size_t>(grid.height));
+
+    ctx.stamp[start] = ctx.generation;
+    ctx.g[start] = 0.0f;
+    ctx.parent[start] = -1;
+    ctx.closed[start] = 0;
+    ctx.Push(start, Octile(sx, sy, gx, gy));
+
+    bool found = false;
+    while (!ctx.open.empty())
+    {
+        const OpenNode node = ctx.Pop();
+        const int32_t cur = node.index;
+        if (ctx.closed[cur]) continue; // stale heap entry
+        ctx.closed[cur] = 1;
+        if (cur == goal) { found = true; break; }
+
+        const int cx = cur % grid.width;
+        const int cy = cur / grid.width;
+        const float gCur = ctx.g[cur];
+
+        auto relax = [&](int32_t next, int nx, int ny, float stepCost)
+        {
+            const float gNext = gCur + stepCost;
+            if (ctx.Reached(next))
+            {
+                if (ctx.closed[next] || gNext >= ctx.g[next]) return;
+            }
+            else
+            {
+                ctx.stamp[next] = ctx.generation;
+                ctx.closed[next] = 0;
+            }
+            ctx.g[next] = gNext;
+            ctx.parent[next] = cur;
+            ctx.Push(next, gNext + Octile(nx, ny, gx, gy));
+        };
+
+        if (useJumpPointSearch)
+        {
+            int pdx = 0, pdy = 0;
+            const int32_t p = ctx.parent[cur];
+            if (p >= 0)
+            {
+                pdx = Sign(cx - p % grid.width);
+                pdy = Sign(cy - p / grid.width);
+            }
+            int dirs[8][2];
+            const int n = PrunedDirections(grid, cx, cy, pdx, pdy, dirs);
+            for (int i = 0; i < n; ++i)
+            {
+                const int32_t jp = Jump(grid, cx + dirs[i][0], cy + dirs[i][1], dirs[i][0], dirs[i][1], goal);
+                if (jp < 0) continue;
+                const int jx = jp % grid.width;
+                const int jy = jp / grid.width;
+                relax(jp, jx, jy, Octile(cx, cy, jx, jy));
+            }
+        }
+        else
+        {
+            for (int oy = -1; oy <= 1; ++oy)
+            {
+                for (int ox = -1; ox <= 1; ++ox)
+                {
+                    if (ox == 0 && oy == 0) continue;
+                    const int nx = cx + ox;
+                    const int ny = cy + oy;
+                    if (!grid.IsWalkable(nx, ny)) continue;
+                    const bool diagonal = (ox != 0 && oy != 0);
+                    if (diagonal && (!grid.IsWalkable(cx + ox, cy) || !grid.IsWalkable(cx, cy + oy))) continue;
+                    relax(grid.Index(nx, ny), nx, ny, diagonal ? k_SQRT2 : 1.0f);
+                }
+            }
+        }
+    }
+
+    if (!found) return false;
+
+    // walk back from the goal and keep only the turning points
+    std::vector<int32_t> cells;
+    for (int32_t c = goal; c >= 0; c = ctx.parent[c]) cells.push_back(c);
+    std::reverse(cells.begin(), cells.end());
+
+    outWaypoints.reserve(cells.size());
+    int lastDx = 0, lastDy = 0;
+    for (size_t i = 0; i < cells.size(); ++i)
+    {
+        const int x = cells[i] % grid.width;
+        const int y = cells[i] / grid.width;
+        if (i > 0 && i + 1 < cells.size())
+        {
+            const int nx = cells[i + 1] % grid.width;
+            const int ny = cells[i + 1] / grid.width;
+            const int px = cells[i - 1] % grid.width;
+            const int py = cells[i - 1] / grid.width;
+            lastDx = Sign(x - px); lastDy = Sign(y - py);
+            if (Sign(nx - x) == lastDx && Sign(ny - y) == lastDy) continue; // collinear
+        }
+        outWaypoints.push_back({ (x + 0.5f) * grid.cellSize, (y + 0.5f) * grid.cellSize });
+    }
+    return true;
+}
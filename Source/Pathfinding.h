@@ -0,0 +1,185 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- PathfindingManager is a singleton service computing paths on the active
+  sector CollisionMap for AI components (AI_Npc, ...).
+- Searches use A* with an octile heuristic on an 8-connected grid (no corner
+  cutting). Jump Point Search is used by default since the collision grid is
+  uniform cost; it can be disabled to fall back to plain A*.
+- Requests are asynchronous: RequestPath() returns an id immediately, the
+  search runs on JobSystem workers and the result is polled with
+  GetPathResult(). Identical requests (same start cell, goal cell and map
+  version) are merged and results are kept in an LRU cache.
+
+Notes:
+- RequestPath / GetPathResult / ReleaseRequest / Process must be called from
+  the main thread. Workers only read an immutable snapshot of the grid.
+- Process() (called once per frame by World) dispatches at most
+  'maxSearchesPerFrame' new searches and publishes completed results within
+  'publishBudgetMs', so hundreds of NPCs re-pathing at once are spread over
+  several frames instead of producing a spike.
+*/
+#pragma once
+
+#include "object.h"
+#include "vector.h"
+#include "CollisionMap.h"
+#include <SDL3/SDL_rect.h>
+#include <vector>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+
+// Immutable copy of a CollisionMap shared with the worker threads
+struct NavGrid
+{
+    int width = 0;
+    int height = 0;
+    float cellSize = 32.0f;
+    uint32_t version = 0;
+    std::vector<uint8_t> blocked; // 1 = blocked
+
+    inline bool IsWalkable(int x, int y) const
+    {
+        return x >= 0 && y >= 0 && x < width && y < height && blocked[static_cast<size_t>(y) * width + x] == 0;
+    }
+    inline int Index(int x, int y) const { return y * width + x; }
+};
+
+enum class PathStatus
+{
+    Invalid = 0, // unknown or released request id
+    Pending,
+    Found,
+    NotFound
+};
+
+using PathRequestID = uint32_t;
+const PathRequestID INVALID_PATH_REQUEST = 0;
+
+// Waypoints are cell centers in world coordinates, from start to goal
+using PathWaypoints = std::vector<SDL_FPoint>;
+using PathPtr = std::shared_ptr<const PathWaypoints>;
+
+class PathfindingManager : public Object
+{
+public:
+    PathfindingManager();
+    virtual ~PathfindingManager();
+
+    virtual ObjectType GetObjectType() const override { return ObjectType::Singleton; }
+
+    static PathfindingManager& GetInstance();
+    static PathfindingManager& Get() { return GetInstance(); }
+
+    // Collision map used for the searches (typically the active sector map). nullptr disables pathfinding.
+    void SetCollisionMap(const CollisionMap* map);
+    const CollisionMap* GetCollisionMap() const { return m_map; }
+
+    // Snapshot of the current map content (refreshed in Process() when the map version changes)
+    std::shared_ptr<const NavGrid> GetNavGrid() const { return m_grid; }
+
+    // Asynchronous requests
+    PathRequestID RequestPath(const Vector& start, const Vector& goal);
+    PathStatus GetPathResult(PathRequestID id, PathPtr& outPath) const;
+    void ReleaseRequest(PathRequestID id);
+
+    // Per-frame update: refresh grid snapshot, publish finished searches, dispatch new ones
+    void Process() override;
+
+    // Settings
+    void SetMaxSearchesPerFrame(int n) { m_maxSearchesPerFrame = (n > 0) ? n : 1; }
+    void SetPublishBudgetMs(float ms) { m_publishBudgetMs = ms; }
+    void SetUseJumpPointSearch(bool b) { m_useJPS = b; }
+    void SetCacheCapacity(size_t n);
+
+    struct Stats
+    {
+        uint64_t searches = 0;      // searches run on workers
+        uint64_t cacheHits = 0;     // requests served from the cache
+        uint64_t mergedRequests = 0;// requests merged with an identical queued search
+        size_t queued = 0;          // searches waiting for dispatch
+        size_t inFlight = 0;        // searches running on workers
+    };
+    Stats GetStats() const;
+
+    // Synchronous search on a grid snapshot (thread-safe, used by the workers).
+    // Returns false if no path exists.
+    static bool FindPath(const NavGrid& grid, int sx, int sy, int gx, int gy, bool useJumpPointSearch, PathWaypoints& outWaypoints);
+
+private:
+    struct PathKey
+    {
+        int32_t start = 0;
+        int32_t goal = 0;
+        uint32_t version = 0;
+        bool operator==(const PathKey& o) const { return start == o.start && goal == o.goal && version == o.version; }
+    };
+    struct PathKeyHash
+    {
+        size_t operator()(const PathKey& k) const
+        {
+            uint64_t h = (static_cast<uint64_t>(static_cast<uint32_t>(k.start)) << 32) ^ static_cast<uint32_t>(k.goal);
+            h ^= static_cast<uint64_t>(k.version) * 0x9E3779B97F4A7C15ull;
+            return static_cast<size_t>(h ^ (h >> 29));
+        }
+    };
+    struct Search
+    {
+        std::vector<PathRequestID> waiters;
+        bool dispatched = false;
+    };
+    struct CompletedSearch
+    {
+        PathKey key;
+        bool found = false;
+        PathWaypoints waypoints;
+    };
+    struct CacheEntry
+    {
+        PathPtr path; // nullptr for unreachable goals
+        std::list<PathKey>::iterator lruIt;
+    };
+    struct RequestSlot
+    {
+        PathStatus status = PathStatus::Pending;
+        PathPtr path;
+    };
+
+    void RefreshGrid();
+    void PublishCompleted();
+    void DispatchSearches();
+    void Resolve(const PathKey& key, const PathPtr& path, bool found);
+    bool LookupCache(const PathKey& key, PathPtr& outPath, bool& outFound);
+    void StoreCache(const PathKey& key, const PathPtr& path);
+
+    const CollisionMap* m_map = nullptr;
+    std::shared_ptr<const NavGrid> m_grid;
+
+    PathRequestID m_nextRequestID = 1;
+    std::unordered_map<PathRequestID, RequestSlot> m_requests;
+
+    std::unordered_map<PathKey, Search, PathKeyHash> m_searches; // queued + in flight
+    std::deque<PathKey> m_queue;                                 // not yet dispatched
+
+    std::mutex m_completedMutex;
+    std::vector<CompletedSearch> m_completed; // filled by workers
+    std::deque<CompletedSearch> m_publishing;  // main thread backlog being published
+
+    std::list<PathKey> m_lru;
+    std::unordered_map<PathKey, CacheEntry, PathKeyHash> m_cache;
+    size_t m_cacheCapacity = 1024;
+
+    int m_maxSearchesPerFrame = 64;
+    float m_publishBudgetMs = 1.0f;
+    bool m_useJPS = true;
+    size_t m_inFlight = 0;
+
+    Stats m_stats;
+};
@@ -0,0 +1,44 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- RenderList is the flat buffer of world-space draw items extracted once per
+  frame by World from the Visual components. Every viewport then replays the
+  same items with its own camera transform and view clipping, so the scene
+  traversal cost does not depend on the number of viewports.
+
+Notes:
+- Items only hold plain data (no component pointers), so a list could be
+  filled on a worker and replayed while the next one is being built.
+- Components that cannot describe themselves as items keep using the
+  immediate ObjectComponent::Render() path.
+*/
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+struct RenderItem
+{
+    SDL_Texture* texture = nullptr;
+    SDL_FRect dst = { 0.0f, 0.0f, 0.0f, 0.0f };  // world coordinates
+    SDL_FRect src = { 0.0f, 0.0f, 0.0f, 0.0f };  // texture pixels, w <= 0 for the whole texture
+    SDL_FColor color = { 1.0f, 1.0f, 1.0f, 1.0f };
+    int layer = 0;
+    float z = 0.0f;
+};
+
+class RenderList
+{
+public:
+    void Clear() { m_items.clear(); }
+    void Add(const RenderItem& item) { m_items.push_back(item); }
+
+    size_t Size() const { return m_items.size(); }
+    const RenderItem& operator[](size_t i) const { return m_items[i]; }
+
+private:
+    std::vector<RenderItem> m_items; // capacity kept from frame to frame
+};
@@ -0,0 +1,30 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- ResourceHandle identifies a DataManager resource by slot index and
+  generation. It is obtained once from the resource id (PreloadTexture,
+  GetSpriteRegion, GetHandle) and then resolves without hashing or locking.
+
+Notes:
+- A released slot gets a new generation: stale handles resolve to nothing
+  instead of to the resource that reuses the slot.
+- Plain 8 bytes value, safe to store in components (e.g. Sprite).
+*/
+#pragma once
+
+#include <cstdint>
+
+struct ResourceHandle
+{
+    static const uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    uint32_t index = INVALID_INDEX;
+    uint32_t generation = 0;
+
+    bool IsValid() const { return index != INVALID_INDEX; }
+    bool operator==(const ResourceHandle& o) const { return index == o.index && generation == o.generation; }
+    bool operator!=(const ResourceHandle& o) const { return !(*this == o); }
+};
@@ -98,15 +98,25 @@ inline void from_json(json const& j, QuestManager& m)
 inline void to_json(json& j, CollisionMap const& c)
 {
  j = json::object();
+ j["width"] = c.width;
+ j["height"] = c.height;
+ j["cellSize"] = c.cellSize;
  j["data"] = json::array();
- for (int v : c.data) j["data"].push_back(v);
+ for (int v : c.GetData()) j["data"].push_back(v);
 }
 inline void from_json(json const& j, CollisionMap& c)
 {
+ int w = j.contains("width") ? j["width"].get<int>() : 0;
+ int h = j.contains("height") ? j["height"].get<int>() : 0;
+ float cellSize = j.contains("cellSize") ? j["cellSize"].get<float>() : 32.0f;
+ std::vector<int> data;
  if (j.contains("data") && j["data"].is_array()) {
- c.data.clear();
- for (size_t i=0;i< j["data"].size();++i) c.data.push_back(j["data"][i].get<int>());
+ for (size_t i=0;i< j["data"].size();++i) data.push_back(j["data"][i].get<int>());
  }
+ // older files without a layout: a single row
+ if (w <= 0 || h <= 0) { w = static_cast<int>(data.size()); h = data.empty() ? 0 : 1; }
+ c.Resize(w, h, cellSize);
+ c.SetData(std::move(data));
 }
 
 // GraphicMap
@@ -169,7 +179,7 @@ inline void from_json(json const& j, Level& l)
 inline void to_json(json& j, World const& w)
 {
  j = json::object();
- j["name"] = w.name;
+ j["name"] = w.name.str();
  j["levels"] = json::array();
  for (auto const& lp : w.GetLevels()) j["levels"].push_back(*lp);
 }
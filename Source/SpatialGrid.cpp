@@ -0,0 +1,70 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- Implementation of SpatialGrid (uniform hash grid for visibility queries).
+*/
+
+#include "SpatialGrid.h"
+#include <cmath>
+
+//-------------------------------------------------------------
+inline int SpatialGrid::CellCoord(float v) const
+{
+    return static_cast<int>(std::floor(v / m_cellSize));
+}
+//-------------------------------------------------------------
+void SpatialGrid::Clear()
+{
+    for (auto& kv : m_cells) kv.second.clear();
+    m_large.clear();
+    m_count = 0;
+}
+//-------------------------------------------------------------
+void SpatialGrid::Reset()
+{
+    m_cells.clear();
+    m_large.clear();
+    m_count = 0;
+}
+//-------------------------------------------------------------
+void SpatialGrid::Insert(uint32_t id, const SDL_FRect& bounds)
+{
+    ++m_count;
+    const int x0 = CellCoord(bounds.x);
+    const int y0 = CellCoord(bounds.y);
+    const int x1 = CellCoord(bounds.x + bounds.w);
+    const int y1 = CellCoord(bounds.y + bounds.h);
+    if ((x1 - x0 + 1) * (y1 - y0 + 1) > k_MAX_CELLS_PER_ENTRY)
+    {
+        m_large.push_back({ id, bounds });
+        return;
+    }
+    for (int y = y0; y <= y1; ++y)
+        for (int x = x0; x <= x1; ++x)
+            m_cells[CellKey(x, y)].push_back(id);
+}
+//-------------------------------------------------------------
+void SpatialGrid::Query(const SDL_FRect& area, std::vector<uint32_t>& out) const
+{
+    const int x0 = CellCoord(area.x);
+    const int y0 = CellCoord(area.y);
+    const int x1 = CellCoord(area.x + area.w);
+    const int y1 = CellCoord(area.y + area.h);
+    for (int y = y0; y <= y1; ++y)
+    {
+        for (int x = x0; x <= x1; ++x)
+        {
+            auto it = m_cells.find(CellKey(x, y));
+            if (it != m_cells.end()) out.insert(out.end(), it->second.begin(), it->second.end());
+        }
+    }
+    for (const Large& l : m_large)
+    {
+        if (l.bounds.x <= area.x + area.w && area.x <= l.bounds.x + l.bounds.w &&
+            l.bounds.y <= area.y + area.h && area.y <= l.bounds.y + l.bounds.h)
+            out.push_back(l.id);
+    }
+}
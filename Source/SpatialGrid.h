@@ -0,0 +1,58 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- SpatialGrid is a uniform hash grid indexing world-space rectangles by id.
+  World uses it to find the components overlapping a viewport's camera
+  rectangle without testing every component for every viewport.
+
+Notes:
+- Rebuilt every frame: Clear() keeps the bucket storage so that steady
+  scenes do not allocate.
+- Rectangles covering too many cells are kept in a separate list and tested
+  individually by Query().
+- Query() may return an id several times (one per overlapped cell) and in
+  any order: callers sort / deduplicate as they need.
+*/
+#pragma once
+
+#include <SDL3/SDL_rect.h>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+class SpatialGrid
+{
+public:
+    explicit SpatialGrid(float cellSize = 256.0f) : m_cellSize(cellSize) {}
+
+    void SetCellSize(float cellSize) { m_cellSize = (cellSize > 0.0f) ? cellSize : 256.0f; Reset(); }
+    float GetCellSize() const { return m_cellSize; }
+
+    void Clear();  // remove all entries, keep the memory
+    void Reset();  // remove all entries and release the memory
+
+    void Insert(uint32_t id, const SDL_FRect& bounds);
+    void Query(const SDL_FRect& area, std::vector<uint32_t>& out) const;
+
+    size_t GetEntryCount() const { return m_count; }
+
+private:
+    struct Large
+    {
+        uint32_t id;
+        SDL_FRect bounds;
+    };
+
+    static inline uint64_t CellKey(int x, int y) { return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y); }
+    inline int CellCoord(float v) const;
+
+    float m_cellSize;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_cells;
+    std::vector<Large> m_large;
+    size_t m_count = 0;
+
+    static const int k_MAX_CELLS_PER_ENTRY = 16;
+};
@@ -4,6 +4,8 @@
 #include "GameObject.h"
 #include <SDL3/SDL_render.h>
 #include "DataManager.h"
+#include "SpriteBatch.h"
+#include "RenderList.h"
 
 bool Sprite::FactoryRegistered = ObjectFactory::Get().Register("Sprite", Sprite::Create);
 ObjectComponent* Sprite::Create()
@@ -28,24 +30,105 @@ void Sprite::RenderDebug()
 	/**/
 }
 
+void Sprite::UpdatePendingTexture()
+{
+	// async load completed: switch from the placeholder to the real texture
+	if (m_pendingTexture.valid() && m_pendingTexture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+	{
+		SDL_Texture* tex = m_pendingTexture.get();
+		m_pendingTexture = std::shared_future<SDL_Texture*>();
+		if (tex)
+		{
+			// keep resolving through the handle (SetSprite(SDL_Texture*) clears it)
+			const ResourceHandle handle = m_handle;
+			SetSprite(tex);
+			m_handle = handle;
+		}
+	}
+}
+
+SDL_Texture* Sprite::ResolveTexture(SDL_FRect& outSrc, bool& outUseSrc) const
+{
+	if (m_handle.IsValid())
+	{
+		// lock-free slot read: the placeholder while loading, then the uploaded texture
+		SDL_Texture* tex = nullptr;
+		outUseSrc = DataManager::Get().GetSpriteRegion(m_handle, tex, outSrc);
+		return tex;
+	}
+	if (m_pendingTexture.valid())
+	{
+		outUseSrc = false;
+		return DataManager::Get().GetPlaceholderTexture();
+	}
+	outSrc = m_srcRect;
+	outUseSrc = m_useSrcRect;
+	return m_SpriteTexture;
+}
+
+bool Sprite::ExtractRenderItems(RenderList& list)
+{
+	if (!gao) return false;
+	UpdatePendingTexture();
+
+	SDL_FRect src;
+	bool useSrc = false;
+	SDL_Texture* tex = ResolveTexture(src, useSrc);
+	if (!tex) return true; // nothing to draw, but nothing to render per viewport either
+
+	Vector vPos = gao->GetPosition();
+	RenderItem item;
+	item.texture = tex;
+	gao->GetSize(item.dst.w, item.dst.h);
+	item.dst.x = vPos.x;
+	item.dst.y = vPos.y;
+	if (useSrc) item.src = src;
+	item.layer = m_layer;
+	item.z = vPos.z;
+	list.Add(item);
+	return true;
+}
+
 void Sprite::Render()
 {
-	Vector vRenderPos = gao->GetPosition() - CameraManager::Get().GetCameraPositionForActivePlayer();
+	UpdatePendingTexture();
+
+	Vector vPos = gao->GetPosition();
 	float _w, _h;
 	gao->GetSize(_w, _h);
-	gao->SetBoundingbox( {vRenderPos.x, vRenderPos.y, _w, _h} );
 
-	if (m_SpriteTexture)
+	SDL_FRect srcRect;
+	bool useSrc = false;
+	SDL_Texture* tex = ResolveTexture(srcRect, useSrc);
+	if (tex)
 	{
-		SDL_FRect box = gao->GetBoundingBox();
+		const SDL_FRect box = CameraManager::Get().WorldToRender(SDL_FRect{ vPos.x, vPos.y, _w, _h });
+		const SDL_FRect* src = useSrc ? &srcRect : nullptr;
 
-		SDL_RenderTexture(GameEngine::renderer, m_SpriteTexture, nullptr, &box);
+		// batched when World::Render opened a sprite pass, immediate otherwise
+		if (SpriteBatch::Get().IsActive())
+			SpriteBatch::Get().Draw(tex, box, src, { 1.0f, 1.0f, 1.0f, 1.0f }, m_layer, vPos.z);
+		else
+			SDL_RenderTexture(GameEngine::renderer, tex, src, &box);
 	}
 }
 
+bool Sprite::GetWorldBounds(SDL_FRect& outBounds) const
+{
+	if (!gao) return false;
+	Vector vPos = gao->GetPosition();
+	float _w, _h;
+	gao->GetSize(_w, _h);
+	outBounds = { vPos.x, vPos.y, _w, _h };
+	return true;
+}
+
 void Sprite::SetSprite(SDL_Texture* texture)
 {
 	m_SpriteTexture = texture;
+	m_useSrcRect = false;
+	m_handle = ResourceHandle();
+	if (!m_SpriteTexture) return;
 	gao->SetSize((float)m_SpriteTexture->w, (float)m_SpriteTexture->h);
 	//gao->width = gao->boundingBox.h = (float)m_SpriteTexture->h;
 	//gao->height = gao->boundingBox.w = (float)m_SpriteTexture->w;
@@ -53,7 +136,26 @@ void Sprite::SetSprite(SDL_Texture* texture)
 
 void Sprite::SetSprite(const std::string& resourceName,const std::string& filePath)
 {
-	SetSprite((SDL_Texture*)DataManager::Get().GetSprite(resourceName, filePath));
+	// small sprites come back as a region of a shared atlas page
+	SDL_Texture* texture = nullptr;
+	SDL_FRect src;
+	ResourceHandle handle;
+	if (!DataManager::Get().GetSpriteRegion(resourceName, filePath, texture, src, ResourceCategory::GameObject, &handle))
+	{
+		SetSprite((SDL_Texture*)nullptr);
+		return;
+	}
+	m_handle = handle;
+	m_SpriteTexture = texture;
+	m_srcRect = src;
+	m_useSrcRect = true;
+	gao->SetSize(src.w, src.h);
+}
+
+void Sprite::SetSpriteAsync(const std::string& resourceName, const std::string& filePath)
+{
+	m_pendingTexture = DataManager::Get().LoadTextureAsync(resourceName, filePath, JobPriority::Normal, ResourceCategory::GameObject);
+	m_handle = DataManager::Get().GetHandle(resourceName);
 }
 
 bool Sprite::Preload(const std::string& resourceName, const std::string& filePath)
@@ -1,6 +1,8 @@
 #pragma once
 #include "ObjectComponent.h"
+#include "ResourceHandle.h"
 #include <SDL3/SDL.h>
+#include <future>
 
 class Sprite : public VisualComponent
 {
@@ -16,13 +18,30 @@ class Sprite : public VisualComponent
 
 	virtual void RenderDebug() override;
 	virtual void Render() override;
+	virtual bool GetWorldBounds(SDL_FRect& outBounds) const override;
+	virtual bool ExtractRenderItems(RenderList& list) override;
 
 	void SetSprite(SDL_Texture* texture);
 	void SetSprite(const std::string& resourceName, const std::string& filePath);
+	// Load the texture in the background, a placeholder is drawn until it is uploaded
+	void SetSpriteAsync(const std::string& resourceName, const std::string& filePath);
 
 	bool Preload(const std::string& resourceName, const std::string& filePath);
 
+	// Draw order in the sprite batch (lower layers first)
+	void SetLayer(int layer) { m_layer = layer; }
+	int GetLayer() const { return m_layer; }
+
 protected:
+	void UpdatePendingTexture();
+	// Texture and source rect to draw this frame
+	SDL_Texture* ResolveTexture(SDL_FRect& outSrc, bool& outUseSrc) const;
+
 	SDL_Texture* m_SpriteTexture = nullptr;
+	SDL_FRect m_srcRect = { 0.0f, 0.0f, 0.0f, 0.0f }; // sprite area in m_SpriteTexture (atlas page)
+	bool m_useSrcRect = false;
+	int m_layer = 0;
+	std::shared_future<SDL_Texture*> m_pendingTexture; // valid while an async load is running
+	ResourceHandle m_handle; // set when the sprite comes from the DataManager (resolved each frame without locking)
 };
 
@@ -0,0 +1,186 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- Implementation of SpriteBatch (quad recording, radix sort, SDL_RenderGeometry submission).
+*/
+
+#include "SpriteBatch.h"
+#include "system/system_utils.h"
+#include <cstring>
+
+namespace
+{
+    // Map a float to an unsigned integer preserving the ordering
+    inline uint32_t SortableFloat(float f)
+    {
+        uint32_t u;
+        std::memcpy(&u, &f, sizeof(u));
+        return (u & 0x80000000u) ? ~u : (u | 0x80000000u);
+    }
+
+    // Quads per SDL_RenderGeometry call (keeps the index buffer small for backends using 16-bit indices)
+    const size_t k_MAX_QUADS_PER_CALL = 16384;
+}
+
+//-------------------------------------------------------------
+SpriteBatch::SpriteBatch()
+{
+    name = "SpriteBatch";
+    SYSTEM_LOG << "SpriteBatch created\n";
+}
+//-------------------------------------------------------------
+SpriteBatch::~SpriteBatch()
+{
+    SYSTEM_LOG << "SpriteBatch destroyed\n";
+}
+//-------------------------------------------------------------
+SpriteBatch& SpriteBatch::GetInstance()
+{
+    static SpriteBatch instance;
+    return instance;
+}
+//-------------------------------------------------------------
+void SpriteBatch::Begin(SDL_Renderer* renderer)
+{
+    m_renderer = renderer;
+    m_quads.clear();
+    m_keys.clear();
+    m_textureIds.clear();
+}
+//-------------------------------------------------------------
+void SpriteBatch::Draw(SDL_Texture* texture, const SDL_FRect& dst, const SDL_FRect* src, const SDL_FColor& color, int layer, float z)
+{
+    if (!m_renderer || !texture) return;
+
+    Quad q;
+    q.texture = texture;
+    q.dst = dst;
+    q.color = color;
+    if (src && texture->w > 0 && texture->h > 0)
+    {
+        const float iw = 1.0f / static_cast<float>(texture->w);
+        const float ih = 1.0f / static_cast<float>(texture->h);
+        q.src = { src->x * iw, src->y * ih, src->w * iw, src->h * ih };
+    }
+    else
+    {
+        q.src = { 0.0f, 0.0f, 1.0f, 1.0f };
+    }
+
+    // textures are numbered in order of first use so that equal textures share a key prefix
+    auto it = m_textureIds.find(texture);
+    uint16_t texId;
+    if (it == m_textureIds.end())
+    {
+        texId = static_cast<uint16_t>(m_textureIds.size());
+        m_textureIds.emplace(texture, texId);
+    }
+    else texId = it->second;
+
+    const uint64_t layerBits = static_cast<uint16_t>(layer + 32768);
+    m_keys.push_back((layerBits << 48) | (static_cast<uint64_t>(texId) << 32) | SortableFloat(z));
+    m_quads.push_back(q);
+}
+//-------------------------------------------------------------
+void SpriteBatch::SortKeys()
+{
+    const size_t n = m_keys.size();
+    m_order.resize(n);
+    for (size_t i = 0; i < n; ++i) m_order[i] = static_cast<uint32_t>(i);
+    m_keysTmp.resize(n);
+    m_orderTmp.resize(n);
+
+    // LSD radix sort, 8 bits per pass: each pass is stable, so the whole sort is
+    uint64_t* keysIn = m_keys.data();
+    uint64_t* keysOut = m_keysTmp.data();
+    uint32_t* orderIn = m_order.data();
+    uint32_t* orderOut = m_orderTmp.data();
+
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        size_t count[256] = {};
+        for (size_t i = 0; i < n; ++i) ++count[(keysIn[i] >> shift) & 0xFF];
+        // all keys share this byte: nothing to do for this pass
+        if (count[(keysIn[0] >> shift) & 0xFF] == n) continue;
+
+        size_t offset = 0;
+        for (int b = 0; b < 256; ++b)
+        {
+            const size_t c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < n; ++i)
+        {
+            const size_t dst = count[(keysIn[i] >> shift) & 0xFF]++;
+            keysOut[dst] = keysIn[i];
+            orderOut[dst] = orderIn[i];
+        }
+        std::swap(keysIn, keysOut);
+        std::swap(orderIn, orderOut);
+    }
+
+    if (orderIn != m_order.data()) m_order.swap(m_orderTmp);
+    if (keysIn != m_keys.data()) m_keys.swap(m_keysTmp);
+}
+//-------------------------------------------------------------
+void SpriteBatch::Flush()
+{
+    const size_t n = m_order.size();
+    size_t runStart = 0;
+    while (runStart < n)
+    {
+        // run of quads sharing the same texture
+        SDL_Texture* texture = m_quads[m_order[runStart]].texture;
+        size_t runEnd = runStart + 1;
+        while (runEnd < n && runEnd - runStart < k_MAX_QUADS_PER_CALL && m_quads[m_order[runEnd]].texture == texture) ++runEnd;
+
+        const size_t quadCount = runEnd - runStart;
+        m_vertices.resize(quadCount * 4);
+        if (m_indices.size() < quadCount * 6)
+        {
+            // index pattern is the same for every run: only extend it
+            size_t q = m_indices.size() / 6;
+            m_indices.resize(quadCount * 6);
+            for (; q < quadCount; ++q)
+            {
+                const int v = static_cast<int>(q * 4);
+                int* idx = &m_indices[q * 6];
+                idx[0] = v; idx[1] = v + 1; idx[2] = v + 2;
+                idx[3] = v; idx[4] = v + 2; idx[5] = v + 3;
+            }
+        }
+
+        SDL_Vertex* vtx = m_vertices.data();
+        for (size_t i = runStart; i < runEnd; ++i, vtx += 4)
+        {
+            const Quad& q = m_quads[m_order[i]];
+            const float x0 = q.dst.x, y0 = q.dst.y, x1 = q.dst.x + q.dst.w, y1 = q.dst.y + q.dst.h;
+            const float u0 = q.src.x, v0 = q.src.y, u1 = q.src.x + q.src.w, v1 = q.src.y + q.src.h;
+            vtx[0] = { { x0, y0 }, q.color, { u0, v0 } };
+            vtx[1] = { { x1, y0 }, q.color, { u1, v0 } };
+            vtx[2] = { { x1, y1 }, q.color, { u1, v1 } };
+            vtx[3] = { { x0, y1 }, q.color, { u0, v1 } };
+        }
+
+        SDL_RenderGeometry(m_renderer, texture, m_vertices.data(), static_cast<int>(quadCount * 4), m_indices.data(), static_cast<int>(quadCount * 6));
+        ++m_stats.drawCalls;
+        runStart = runEnd;
+    }
+}
+//-------------------------------------------------------------
+void SpriteBatch::End()
+{
+    if (!m_renderer) return;
+    m_stats.quads = m_quads.size();
+    m_stats.drawCalls = 0;
+    if (!m_quads.empty())
+    {
+        SortKeys();
+        Flush();
+    }
+    m_renderer = nullptr;
+}
@@ -0,0 +1,82 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- SpriteBatch collects textured quads during the render pass and submits
+  them with as few SDL_RenderGeometry calls as possible: one call per run of
+  consecutive quads sharing the same texture.
+- Quads are ordered by (layer, texture, z) with a stable LSD radix sort on a
+  64-bit key, so quads with equal keys keep their submission order.
+
+Notes:
+- Begin() / End() bracket a pass (World::Render calls them for each
+  viewport). Draw() between them only records the quad; nothing is drawn
+  before End().
+- Vertex, index and sort buffers are members reused from frame to frame: no
+  allocation once the peak sprite count has been reached.
+- Within a layer quads are grouped by texture first, z only orders quads
+  sharing a texture. Use layers when overlapping sprites from different
+  textures must be drawn in a given order.
+*/
+#pragma once
+
+#include "object.h"
+#include <SDL3/SDL.h>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+class SpriteBatch : public Object
+{
+public:
+    SpriteBatch();
+    virtual ~SpriteBatch();
+
+    virtual ObjectType GetObjectType() const override { return ObjectType::Singleton; }
+
+    static SpriteBatch& GetInstance();
+    static SpriteBatch& Get() { return GetInstance(); }
+
+    void Begin(SDL_Renderer* renderer);
+    // src in texture pixels (nullptr = whole texture), dst in render coordinates
+    void Draw(SDL_Texture* texture, const SDL_FRect& dst, const SDL_FRect* src = nullptr,
+        const SDL_FColor& color = { 1.0f, 1.0f, 1.0f, 1.0f }, int layer = 0, float z = 0.0f);
+    void End();
+
+    bool IsActive() const { return m_renderer != nullptr; }
+
+    struct Stats
+    {
+        size_t quads = 0;      // quads submitted in the last pass
+        size_t drawCalls = 0;  // SDL_RenderGeometry calls in the last pass
+    };
+    const Stats& GetStats() const { return m_stats; }
+
+private:
+    struct Quad
+    {
+        SDL_Texture* texture;
+        SDL_FRect dst;
+        SDL_FRect src; // normalized texture coordinates
+        SDL_FColor color;
+    };
+
+    void SortKeys();
+    void Flush();
+
+    SDL_Renderer* m_renderer = nullptr;
+
+    std::vector<Quad> m_quads;
+    std::vector<uint64_t> m_keys;
+    std::vector<uint32_t> m_order;      // quad indices sorted by key
+    std::vector<uint64_t> m_keysTmp;    // radix sort ping-pong buffers
+    std::vector<uint32_t> m_orderTmp;
+    std::unordered_map<SDL_Texture*, uint16_t> m_textureIds; // texture -> ordinal in this pass
+
+    std::vector<SDL_Vertex> m_vertices;
+    std::vector<int> m_indices;
+
+    Stats m_stats;
+};
@@ -0,0 +1,351 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- Implementation of TextureAtlas (skyline packing, edge extrusion, PNG/JSON bake).
+*/
+
+#include "TextureAtlas.h"
+#include "system/system_utils.h"
+#include "third_party/nlohmann/json.hpp"
+#include "sdl3_image/sdl_image.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+//-------------------------------------------------------------
+TextureAtlas::TextureAtlas()
+{
+}
+//-------------------------------------------------------------
+TextureAtlas::~TextureAtlas()
+{
+    Clear();
+}
+//-------------------------------------------------------------
+void TextureAtlas::Clear()
+{
+    for (auto& p : m_pages)
+    {
+        if (p.texture) SDL_DestroyTexture(p.texture);
+        if (p.pixels) SDL_DestroySurface(p.pixels);
+    }
+    m_pages.clear();
+    m_regions.clear();
+}
+//-------------------------------------------------------------
+bool TextureAtlas::Accepts(int w, int h) const
+{
+    return w > 0 && h > 0 && w <= m_maxImageSize && h <= m_maxImageSize
+        && w + 2 * m_padding <= m_pageSize && h + 2 * m_padding <= m_pageSize;
+}
+//-------------------------------------------------------------
+bool TextureAtlas::AllocatePage()
+{
+    Page page;
+    page.pixels = SDL_CreateSurface(m_pageSize, m_pageSize, SDL_PIXELFORMAT_RGBA32);
+    if (!page.pixels)
+    {
+        SYSTEM_LOG << "TextureAtlas: failed to allocate a " << m_pageSize << "x" << m_pageSize << " page : " << SDL_GetError() << "\n";
+        return false;
+    }
+    SDL_FillSurfaceRect(page.pixels, nullptr, 0);
+    page.skyline.push_back({ 0, 0, m_pageSize });
+    m_pages.push_back(page);
+    return true;
+}
+//-------------------------------------------------------------
+bool TextureAtlas::PackInPage(Page& page, int w, int h, int& outX, int& outY)
+{
+    // skyline bottom-left: lowest top edge, then narrowest node
+    int bestIndex = -1, bestY = INT_MAX, bestWidth = INT_MAX, bestX = 0;
+    for (size_t i = 0; i < page.skyline.size(); ++i)
+    {
+        const int x = page.skyline[i].x;
+        if (x + w > m_pageSize) break;
+
+        int y = 0;
+        int remaining = w;
+        for (size_t j = i; remaining > 0; ++j)
+        {
+            y = std::max(y, page.skyline[j].y);
+            remaining -= page.skyline[j].width;
+        }
+        if (y + h > m_pageSize) continue;
+        if (y < bestY || (y == bestY && page.skyline[i].width < bestWidth))
+        {
+            bestIndex = static_cast<int>(i);
+            bestY = y;
+            bestX = x;
+            bestWidth = page.skyline[i].width;
+        }
+    }
+    if (bestIndex < 0) return false;
+
+    // insert the new segment and trim the ones it covers
+    std::vector<SkylineNode>& sl = page.skyline;
+    sl.insert(sl.begin() + bestIndex, { bestX, bestY + h, w });
+    for (size_t i = bestIndex + 1; i < sl.size(); )
+    {
+        const int prevEnd = sl[i - 1].x + sl[i - 1].width;
+        if (sl[i].x >= prevEnd) break;
+        const int shrink = prevEnd - sl[i].x;
+        sl[i].x += shrink;
+        sl[i].width -= shrink;
+        if (sl[i].width <= 0) { sl.erase(sl.begin() + i); continue; }
+        break;
+    }
+    // merge neighbors at the same height
+    for (size_t i = 0; i + 1 < sl.size(); )
+    {
+        if (sl[i].y == sl[i + 1].y)
+        {
+            sl[i].width += sl[i + 1].width;
+            sl.erase(sl.begin() + i + 1);
+        }
+        else ++i;
+    }
+
+    outX = bestX;
+    outY = bestY;
+    return true;
+}
+//-------------------------------------------------------------
+void TextureAtlas::AddDirty(Page& page, const SDL_Rect& r)
+{
+    if (page.dirty.w <= 0 || page.dirty.h <= 0) { page.dirty = r; return; }
+    SDL_Rect u;
+    SDL_GetRectUnion(&page.dirty, &r, &u);
+    page.dirty = u;
+}
+//-------------------------------------------------------------
+void TextureAtlas::BlitWithExtrusion(Page& page, SDL_Surface* src, int x, int y)
+{
+    const int w = src->w;
+    const int h = src->h;
+    const int p = m_padding;
+    Uint8* base = static_cast<Uint8*>(page.pixels->pixels);
+    const int pitch = page.pixels->pitch;
+
+    // image rows
+    for (int row = 0; row < h; ++row)
+    {
+        std::memcpy(base + (y + p + row) * pitch + (x + p) * 4,
+            static_cast<const Uint8*>(src->pixels) + row * src->pitch, static_cast<size_t>(w) * 4);
+    }
+    // extrude left / right columns
+    for (int row = 0; row < h; ++row)
+    {
+        Uint32* line = reinterpret_cast<Uint32*>(base + (y + p + row) * pitch);
+        for (int i = 0; i < p; ++i)
+        {
+            line[x + i] = line[x + p];
+            line[x + p + w + i] = line[x + p + w - 1];
+        }
+    }
+    // extrude top / bottom rows (corners included)
+    const size_t fullWidth = static_cast<size_t>(w + 2 * p) * 4;
+    for (int i = 0; i < p; ++i)
+    {
+        std::memcpy(base + (y + i) * pitch + x * 4, base + (y + p) * pitch + x * 4, fullWidth);
+        std::memcpy(base + (y + p + h + i) * pitch + x * 4, base + (y + p + h - 1) * pitch + x * 4, fullWidth);
+    }
+
+    AddDirty(page, { x, y, w + 2 * p, h + 2 * p });
+}
+//-------------------------------------------------------------
+bool TextureAtlas::Insert(const std::string& id, SDL_Surface* surface, AtlasRegion& outRegion)
+{
+    if (!surface) return false;
+    if (Find(id, outRegion)) return true;
+    if (!Accepts(surface->w, surface->h)) return false;
+
+    SDL_Surface* rgba = (surface->format == SDL_PIXELFORMAT_RGBA32) ? surface : SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+    if (!rgba) return false;
+
+    const int w = surface->w + 2 * m_padding;
+    const int h = surface->h + 2 * m_padding;
+    int x = 0, y = 0, page = -1;
+    for (size_t i = 0; i < m_pages.size() && page < 0; ++i)
+    {
+        if (PackInPage(m_pages[i], w, h, x, y)) page = static_cast<int>(i);
+    }
+    if (page < 0)
+    {
+        if (!AllocatePage() || !PackInPage(m_pages.back(), w, h, x, y))
+        {
+            if (rgba != surface) SDL_DestroySurface(rgba);
+            return false;
+        }
+        page = static_cast<int>(m_pages.size()) - 1;
+    }
+
+    BlitWithExtrusion(m_pages[page], rgba, x, y);
+    if (rgba != surface) SDL_DestroySurface(rgba);
+
+    AtlasRegion region;
+    region.page = page;
+    region.srcRect = { static_cast<float>(x + m_padding), static_cast<float>(y + m_padding),
+        static_cast<float>(surface->w), static_cast<float>(surface->h) };
+    m_regions[id] = region;
+    outRegion = region;
+    return true;
+}
+//-------------------------------------------------------------
+bool TextureAtlas::Replace(const std::string& id, SDL_Surface* surface)
+{
+    auto it = m_regions.find(id);
+    if (!surface || it == m_regions.end()) return false;
+    const AtlasRegion& region = it->second;
+    if (surface->w != static_cast<int>(region.srcRect.w) || surface->h != static_cast<int>(region.srcRect.h)) return false;
+    if (region.page < 0 || region.page >= static_cast<int>(m_pages.size()) || !m_pages[region.page].pixels) return false;
+
+    SDL_Surface* rgba = (surface->format == SDL_PIXELFORMAT_RGBA32) ? surface : SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+    if (!rgba) return false;
+    // same place, the padding is extruded again; uploaded by the next Flush()
+    BlitWithExtrusion(m_pages[region.page], rgba, static_cast<int>(region.srcRect.x) - m_padding, static_cast<int>(region.srcRect.y) - m_padding);
+    if (rgba != surface) SDL_DestroySurface(rgba);
+    return true;
+}
+//-------------------------------------------------------------
+bool TextureAtlas::Find(const std::string& id, AtlasRegion& outRegion) const
+{
+    auto it = m_regions.find(id);
+    if (it == m_regions.end()) return false;
+    outRegion = it->second;
+    return true;
+}
+//-------------------------------------------------------------
+SDL_Texture* TextureAtlas::GetPageTexture(int page) const
+{
+    if (page < 0 || page >= static_cast<int>(m_pages.size())) return nullptr;
+    return m_pages[page].texture;
+}
+//-------------------------------------------------------------
+void TextureAtlas::Flush(SDL_Renderer* renderer)
+{
+    if (!renderer) return;
+    for (auto& p : m_pages)
+    {
+        if (p.dirty.w <= 0 || p.dirty.h <= 0) continue;
+        if (!p.texture)
+        {
+            p.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, m_pageSize, m_pageSize);
+            if (!p.texture)
+            {
+                SYSTEM_LOG << "TextureAtlas: failed to create page texture : " << SDL_GetError() << "\n";
+                continue;
+            }
+            SDL_SetTextureBlendMode(p.texture, SDL_BLENDMODE_BLEND);
+            p.dirty = { 0, 0, m_pageSize, m_pageSize };
+        }
+        const Uint8* src = static_cast<const Uint8*>(p.pixels->pixels) + p.dirty.y * p.pixels->pitch + p.dirty.x * 4;
+        SDL_UpdateTexture(p.texture, &p.dirty, src, p.pixels->pitch);
+        p.dirty = { 0, 0, 0, 0 };
+    }
+}
+//-------------------------------------------------------------
+bool TextureAtlas::Save(const std::string& basePath) const
+{
+    nlohmann::json root;
+    root["pageSize"] = m_pageSize;
+    root["padding"] = m_padding;
+    nlohmann::json pages = nlohmann::json::array();
+    for (size_t i = 0; i < m_pages.size(); ++i)
+    {
+        std::ostringstream file;
+        file << basePath << "_" << i << ".png";
+        if (!IMG_SavePNG(m_pages[i].pixels, file.str().c_str()))
+        {
+            SYSTEM_LOG << "TextureAtlas: failed to save '" << file.str() << "' : " << SDL_GetError() << "\n";
+            return false;
+        }
+        // pages are referenced relative to the json file
+        std::string name = file.str();
+        const size_t slash = name.find_last_of("/\\");
+        pages.push_back((slash == std::string::npos) ? name : name.substr(slash + 1));
+    }
+    root["pages"] = pages;
+
+    nlohmann::json sprites = nlohmann::json::array();
+    for (const auto& kv : m_regions)
+    {
+        const AtlasRegion& r = kv.second;
+        nlohmann::json item = nlohmann::json::object();
+        item["id"] = kv.first;
+        item["page"] = r.page;
+        item["x"] = static_cast<int>(r.srcRect.x);
+        item["y"] = static_cast<int>(r.srcRect.y);
+        item["w"] = static_cast<int>(r.srcRect.w);
+        item["h"] = static_cast<int>(r.srcRect.h);
+        sprites.push_back(item);
+    }
+    root["sprites"] = sprites;
+
+    std::ofstream ofs((basePath + ".json").c_str(), std::ios::binary | std::ios::trunc);
+    if (!ofs) return false;
+    ofs << root.dump(1);
+    return ofs.good();
+}
+//-------------------------------------------------------------
+bool TextureAtlas::Load(const std::string& jsonPath)
+{
+    std::ifstream ifs(jsonPath.c_str(), std::ios::binary);
+    if (!ifs) return false;
+    std::ostringstream content;
+    content << ifs.rdbuf();
+
+    try
+    {
+        nlohmann::json root = nlohmann::json::parse(content.str());
+        Clear();
+        m_pageSize = root.contains("pageSize") ? root["pageSize"].get<int>() : 2048;
+        m_padding = root.contains("padding") ? root["padding"].get<int>() : 2;
+
+        const size_t slash = jsonPath.find_last_of("/\\");
+        const std::string dir = (slash == std::string::npos) ? std::string() : jsonPath.substr(0, slash + 1);
+        const nlohmann::json& pages = root["pages"];
+        for (size_t i = 0; i < pages.size(); ++i)
+        {
+            const std::string file = pages[i].get<std::string>();
+            SDL_Surface* loaded = IMG_Load((dir + file).c_str());
+            SDL_Surface* rgba = loaded ? SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32) : nullptr;
+            if (loaded) SDL_DestroySurface(loaded);
+            if (!rgba || rgba->w != m_pageSize || rgba->h != m_pageSize)
+            {
+                SYSTEM_LOG << "TextureAtlas: invalid page '" << file << "' in '" << jsonPath << "'\n";
+                if (rgba) SDL_DestroySurface(rgba);
+                Clear();
+                return false;
+            }
+            Page page;
+            page.pixels = rgba;
+            page.skyline.push_back({ 0, m_pageSize, m_pageSize }); // baked pages are closed
+            page.dirty = { 0, 0, m_pageSize, m_pageSize };
+            m_pages.push_back(page);
+        }
+
+        const nlohmann::json& sprites = root["sprites"];
+        for (size_t i = 0; i < sprites.size(); ++i)
+        {
+            const nlohmann::json& item = sprites[i];
+            AtlasRegion r;
+            r.page = item["page"].get<int>();
+            r.srcRect = { static_cast<float>(item["x"].get<int>()), static_cast<float>(item["y"].get<int>()),
+                static_cast<float>(item["w"].get<int>()), static_cast<float>(item["h"].get<int>()) };
+            if (r.page < 0 || r.page >= static_cast<int>(m_pages.size())) continue;
+            m_regions[item["id"].get<std::string>()] = r;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        SYSTEM_LOG << "TextureAtlas: JSON parse error in '" << jsonPath << "' : " << e.what() << "\n";
+        Clear();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,93 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- TextureAtlas packs small sprite surfaces into large shared pages
+  (2048x2048 by default) so that many sprites can be drawn from the same
+  SDL_Texture. Each packed image is identified by its resource id and is
+  described by an AtlasRegion (page index + source rectangle).
+- Packing uses a skyline bottom-left heuristic. Every image is surrounded by
+  'padding' pixels filled with its own edge pixels (extrusion) so that linear
+  filtering never samples a neighbor image.
+- Pages can be saved to PNG + JSON (offline bake) and loaded back.
+
+Notes:
+- Owned by DataManager; not thread-safe, use from the main thread only.
+- Regions are never freed individually: releasing a sprite leaves a hole in
+  its page until the whole atlas is cleared.
+- CPU copies of the pages are kept so that the GPU textures can be updated
+  incrementally (only the dirty area is uploaded in Flush()).
+*/
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+struct AtlasRegion
+{
+    int page = -1;
+    SDL_FRect srcRect = { 0.0f, 0.0f, 0.0f, 0.0f }; // in page pixels, padding excluded
+};
+
+class TextureAtlas
+{
+public:
+    TextureAtlas();
+    ~TextureAtlas();
+
+    // Page size (2048 or 4096 recommended) must be set before the first insertion
+    void SetPageSize(int size) { if (m_pages.empty()) m_pageSize = size; }
+    int GetPageSize() const { return m_pageSize; }
+    void SetPadding(int padding) { m_padding = (padding >= 0) ? padding : 0; }
+    // Larger images are not packed (they would waste page space)
+    void SetMaxImageSize(int size) { m_maxImageSize = size; }
+    bool Accepts(int w, int h) const;
+
+    // Pack a copy of 'surface' (the caller keeps ownership). Returns false if the image is too big.
+    bool Insert(const std::string& id, SDL_Surface* surface, AtlasRegion& outRegion);
+    bool Find(const std::string& id, AtlasRegion& outRegion) const;
+    // Overwrite the pixels of an already packed image (hot reload). Fails if the size changed.
+    bool Replace(const std::string& id, SDL_Surface* surface);
+
+    SDL_Texture* GetPageTexture(int page) const;
+    size_t GetPageCount() const { return m_pages.size(); }
+
+    // Create / update the GPU textures of the modified pages (main thread)
+    void Flush(SDL_Renderer* renderer);
+
+    // Offline bake: writes "<basePath>_<n>.png" pages and "<basePath>.json" regions
+    bool Save(const std::string& basePath) const;
+    // Load a baked atlas (replaces the current content)
+    bool Load(const std::string& jsonPath);
+    const std::unordered_map<std::string, AtlasRegion>& GetRegions() const { return m_regions; }
+
+    void Clear();
+
+private:
+    struct SkylineNode
+    {
+        int x, y, width;
+    };
+    struct Page
+    {
+        SDL_Surface* pixels = nullptr;   // CPU copy (RGBA32)
+        SDL_Texture* texture = nullptr;
+        std::vector<SkylineNode> skyline;
+        SDL_Rect dirty = { 0, 0, 0, 0 }; // area not uploaded yet
+    };
+
+    bool AllocatePage();
+    bool PackInPage(Page& page, int w, int h, int& outX, int& outY);
+    void BlitWithExtrusion(Page& page, SDL_Surface* src, int x, int y);
+    static void AddDirty(Page& page, const SDL_Rect& r);
+
+    std::vector<Page> m_pages;
+    std::unordered_map<std::string, AtlasRegion> m_regions;
+    int m_pageSize = 2048;
+    int m_padding = 2;
+    int m_maxImageSize = 512;
+};
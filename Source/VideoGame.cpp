@@ -39,6 +39,9 @@ VideoGame::VideoGame()
 
 	// Ensure default state is running
 	GameStateManager::SetState(GameState::GameState_Running);
+
+	// no level files yet: an open level gives the navigation services (pathfinding, flow fields) a map
+	if (world.GetLevels().empty()) world.CreateDefaultLevel();
 	
 	testGao = (GameObject*)ObjectFactory::Get().CreateObject("GameObject");
 	testGao->name = "OlympeSystem";
@@ -303,7 +306,7 @@ void VideoGame::OnEvent(const Message& msg)
 // Optimized: pre-allocate string capacity to avoid reallocations
 bool VideoGame::SaveGame(int slot) const
 {
-    std::string vgName = name.empty() ? std::string("DefaultGame") : name;
+    std::string vgName = name.empty() ? std::string("DefaultGame") : name.str();
     std::ostringstream ss;
     
     // Estimate capacity: ~200 bytes overhead + ~300 bytes per object
@@ -346,7 +349,7 @@ bool VideoGame::SaveGame(int slot) const
 // Load game state from a slot file
 bool VideoGame::LoadGame(int slot)
 {
-    std::string vgName = name.empty() ? std::string("DefaultGame") : name;
+    std::string vgName = name.empty() ? std::string("DefaultGame") : name.str();
     std::string slotName = "SaveSlot_" + std::to_string(slot);
     std::string content;
     if (!DataManager::Get().LoadJSONForObject(vgName, slotName, content))
@@ -402,9 +405,7 @@ bool VideoGame::LoadGame(int slot)
     }
 
     // For simplicity: clear existing world objects (dangerous in real engine)
-    auto &list = World::Get().GetObjectList();
-    for (auto o : list) delete o;
-    list.clear();
+    World::Get().ClearObjects();
 
     for (auto &entry : entries)
     {
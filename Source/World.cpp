@@ -10,6 +10,31 @@ World purpose: Manage the lifecycle of Entities and their interaction with ECS S
 */
 #pragma once
 #include "World.h"
+#include "GameObject.h"
+#include "system/ViewportManager.h"
+
+//---------------------------------------------------------------------------------------------
+void World::StoreObject(Object* obj)
+{
+    // Implementation to add object to the game engine
+    m_objectlist.push_back(obj);
+    m_objectsByUID[obj->GetUID()] = obj;
+    // the entity type is a class property (Player overrides GetEntityType): known as soon as the object is created
+    GameObject* go = dynamic_cast<GameObject*>(obj);
+    if (go && go->GetEntityType() == EntityType::Player) m_players.push_back(go);
+	SYSTEM_LOG << "World: Added object " << obj->name << " to World\n";
+}
+//---------------------------------------------------------------------------------------------
+void World::ClearObjects()
+{
+    for (auto obj : m_objectlist)
+    {
+        delete obj;
+    }
+    m_objectlist.clear();
+    m_objectsByUID.clear();
+    m_players.clear();
+}
 
 //---------------------------------------------------------------------------------------------
 EntityID World::CreateEntity()
@@ -97,4 +122,116 @@ void World::Notify_ECS_Systems(EntityID entity, ComponentSignature signature)
             system->RemoveEntity(entity);
         }
     }
-}
\ No newline at end of file
+}
+//---------------------------------------------------------------------------------------------
+void World::BuildVisibilityIndex()
+{
+    m_visibilityGrid.Clear();
+    m_renderables.clear();
+    m_alwaysVisible.clear();
+    m_renderList.Clear();
+
+    auto add = [this](ObjectComponent* component, bool extract)
+    {
+        if (!component) return;
+        const uint32_t id = static_cast<uint32_t>(m_renderables.size());
+        Renderable r = { component, { 0.0f, 0.0f, 0.0f, 0.0f }, false, 0, 0 };
+        if (extract)
+        {
+            // world-space items recorded once, whatever the number of viewports
+            r.firstItem = static_cast<uint32_t>(m_renderList.Size());
+            r.extracted = component->ExtractRenderItems(m_renderList);
+            r.itemCount = static_cast<uint32_t>(m_renderList.Size()) - r.firstItem;
+        }
+        if (component->GetWorldBounds(r.bounds))
+            m_visibilityGrid.Insert(id, r.bounds);
+        else
+            m_alwaysVisible.push_back(id); // full screen effects, unknown extent...
+        m_renderables.push_back(r);
+    };
+
+    for (auto* prop : array_component_lists_bytypes[static_cast<size_t>(ComponentType::Visual)]) add(prop, true);
+    m_visualRenderableCount = m_renderables.size();
+    for (auto* prop : array_component_lists_bytypes[static_cast<size_t>(ComponentType::AI)]) add(prop, false);
+
+    m_visibilityDirty = false;
+}
+//---------------------------------------------------------------------------------------------
+void World::CollectVisibleComponents()
+{
+    if (m_visibilityDirty) BuildVisibilityIndex();
+
+    // camera area in world coordinates: camera position is the top-left corner of the viewport
+    const short playerId = CameraManager::Get().GetActivePlayerID();
+    SDL_FRect viewport;
+    if (!ViewportManager::Get().GetViewRectForPlayer(playerId, viewport))
+        viewport = { 0.0f, 0.0f, static_cast<float>(GameEngine::screenWidth), static_cast<float>(GameEngine::screenHeight) };
+    // same transform as CameraManager::WorldToRender(), used by the components rendering directly
+    const float zoom = CameraManager::Get().GetActiveCameraZoom();
+    const Vector camPos = CameraManager::Get().GetCameraPositionForActivePlayer();
+    const SDL_FRect view = { camPos.x, camPos.y, viewport.w / zoom, viewport.h / zoom };
+    m_viewRect = view;
+    m_viewZoom = zoom;
+
+    // grid candidates, then exact rectangle test (edges included so zero sized bounds are kept)
+    m_visibleIds.clear();
+    m_visibilityGrid.Query(view, m_visibleIds);
+    std::sort(m_visibleIds.begin(), m_visibleIds.end());
+    m_visibleIds.erase(std::unique(m_visibleIds.begin(), m_visibleIds.end()), m_visibleIds.end());
+    m_visibleIds.erase(std::remove_if(m_visibleIds.begin(), m_visibleIds.end(), [this, &view](uint32_t id)
+    {
+        const SDL_FRect& b = m_renderables[id].bounds;
+        return b.x > view.x + view.w || b.x + b.w < view.x || b.y > view.y + view.h || b.y + b.h < view.y;
+    }), m_visibleIds.end());
+
+    // keep the registration order for drawing
+    const size_t culledCount = m_renderables.size() - m_alwaysVisible.size() - m_visibleIds.size();
+    m_visibleIds.insert(m_visibleIds.end(), m_alwaysVisible.begin(), m_alwaysVisible.end());
+    std::sort(m_visibleIds.begin(), m_visibleIds.end());
+
+    m_visibleVisual.clear();
+    m_visibleAI.clear();
+    for (uint32_t id : m_visibleIds)
+    {
+        if (id < m_visualRenderableCount) m_visibleVisual.push_back(m_renderables[id].component);
+        else m_visibleAI.push_back(m_renderables[id].component);
+    }
+
+    CullingStats stats;
+    stats.playerId = playerId;
+    stats.view = view;
+    stats.tested = m_renderables.size();
+    stats.visible = m_visibleIds.size();
+    stats.culled = culledCount;
+    m_cullingStats.push_back(stats);
+}
+//---------------------------------------------------------------------------------------------
+void World::RenderVisibleItems()
+{
+    const SDL_FRect& view = m_viewRect;
+    SpriteBatch& batch = SpriteBatch::Get();
+
+    // Sprites are collected by the batch and submitted sorted by layer / texture / z in End()
+    batch.Begin(GameEngine::renderer);
+    for (uint32_t id : m_visibleIds)
+    {
+        if (id >= m_visualRenderableCount) break; // AI components come last
+        const Renderable& r = m_renderables[id];
+        if (!r.extracted)
+        {
+            r.component->Render();
+            continue;
+        }
+        for (uint32_t i = r.firstItem; i < r.firstItem + r.itemCount; ++i)
+        {
+            const RenderItem& item = m_renderList[i];
+            // clip against the camera area, then world -> viewport transform
+            if (item.dst.x > view.x + view.w || item.dst.x + item.dst.w < view.x ||
+                item.dst.y > view.y + view.h || item.dst.y + item.dst.h < view.y) continue;
+            const SDL_FRect dst = { (item.dst.x - view.x) * m_viewZoom, (item.dst.y - view.y) * m_viewZoom,
+                item.dst.w * m_viewZoom, item.dst.h * m_viewZoom };
+            batch.Draw(item.texture, dst, (item.src.w > 0.0f) ? &item.src : nullptr, item.color, item.layer, item.z);
+        }
+    }
+    batch.End();
+}
@@ -24,6 +24,13 @@ World purpose: Manage the overall game world, including object management, level
 #include "GameState.h"
 #include "OptionsManager.h"
 #include "system/CameraManager.h"
+#include "Pathfinding.h"
+#include "FlowField.h"
+#include "SpriteBatch.h"
+#include "SpatialGrid.h"
+#include "RenderList.h"
+#include "DebugDraw.h"
+#include "ParticleSystem.h"
 
 // Include ECS related headers
 #include "Ecs_Entity.h"
@@ -31,24 +38,29 @@ World purpose: Manage the overall game world, including object management, level
 #include "ECS_Systems.h"
 #include "ECS_Register.h" // Include the implementation of ComponentPool
 
+class GameObject;
+
 class World : public Object
 {
 public:
+    static const int k_DEFAULT_LEVEL_CELLS = 256; // default level: 256 x 256 cells of 32 pixels
+
     World()
     {
+        // navigation services created first so that they are destroyed after the World (see ~World)
+        PathfindingManager::Get();
+        FlowFieldManager::Get();
         SYSTEM_LOG << "World Initialized\n";
     }
     virtual ~World()
     {
+        // the navigation services must not keep a pointer into the levels freed with this World
+        if (m_activeSector && PathfindingManager::Get().GetCollisionMap() == m_activeSector->collision.get())
+            PathfindingManager::Get().SetCollisionMap(nullptr);
+        m_activeSector = nullptr;
+
         // Clean up all objects
-        /*DEPRECATED OBJECT MANAGEMENT*/
-        {
-            for (auto obj : m_objectlist)
-            {
-                delete obj;
-            }
-            m_objectlist.clear();
-        }
+        /*DEPRECATED OBJECT MANAGEMENT*/ClearObjects();
 		SYSTEM_LOG << "World Destroyed\n";
     }
 
@@ -113,8 +125,19 @@ public:
             }
         }
 
+        // Dispatch / publish path requests issued by the AI stage (async, budgeted per frame)
+        PathfindingManager::Get().Process();
+        FlowFieldManager::Get().Process();
+
+        // Particle emitters: integrate, kill, spawn
+        ParticleSystem::Get().Process();
+
 		// Update Camera positions if needed after all objects have been processed
         CameraManager::Get().Process();
+
+        // positions are final for this frame: the visibility index is rebuilt before the first viewport render
+        m_visibilityDirty = true;
+        m_cullingStats.clear();
     }
     //---------------------------------------------------------------------------------------------
     void Render()
@@ -124,55 +147,65 @@ public:
         /*DEPRECATED OBJECT MANAGEMENT*/
         {
 
+            // Only the components overlapping the active camera view are rendered (see CollectVisibleComponents)
+            CollectVisibleComponents();
+
             // Render stage (note: actual drawing may require renderer context)
-            for (auto* prop : array_component_lists_bytypes[static_cast<size_t>(ComponentType::Visual)])
-            {
-                if (prop) prop->Render();
-            }
+            // Items extracted once per frame are replayed with this viewport's camera, other components render directly
+            RenderVisibleItems();
             if (OptionsManager::Get().IsSet(OptionFlags::ShowDebugInfo))
             {
+                // Debug primitives are recorded by DebugDraw and submitted in a few calls by End()
+                DebugDraw::Get().Begin(GameEngine::renderer);
                 // Render debug for Visual components
-                for (auto* prop : array_component_lists_bytypes[static_cast<size_t>(ComponentType::Visual)])
+                for (auto* prop : m_visibleVisual)
                 {
-                    if (prop) prop->RenderDebug();
+                    prop->RenderDebug();
                 }
-                for (auto* prop : array_component_lists_bytypes[static_cast<size_t>(ComponentType::AI)])
+                for (auto* prop : m_visibleAI)
                 {
-                    if (prop) prop->RenderDebug();
+                    prop->RenderDebug();
                 }
+                DebugDraw::Get().End();
             }
         }
 	}
 
 	//---------------------------------------------------------------------------------------------
 	// Objects & Entities management
-    /*DEPRECATED OBJECT MANAGEMENT*/void StoreObject(Object* obj)
-    {
-        // Implementation to add object to the game engine
-        m_objectlist.push_back(obj);
-		SYSTEM_LOG << "World: Added object " + obj->name + " to World\n";
-    }
+    /*DEPRECATED OBJECT MANAGEMENT*/void StoreObject(Object* obj);
+    // deletes every object (objects are removed through this function only: it keeps the UID map and the player list in sync)
+    /*DEPRECATED OBJECT MANAGEMENT*/void ClearObjects();
 	//---------------------------------------------------------------------------------------------
+    // O(1) lookup in the UID map
     Object*& GetObjectByUID(uint64_t uid)
     {
         static Object* ObjPtr = nullptr;
-        for (auto* obj : m_objectlist)
-        {
-            if (obj && obj->GetUID() == uid)
-            {
-				ObjPtr = obj;
-                return ObjPtr;
-            }
-        }
-        ObjPtr = nullptr;
+        auto it = m_objectsByUID.find(uid);
+        ObjPtr = (it != m_objectsByUID.end()) ? it->second : nullptr;
 		return ObjPtr;
    	}
+    // objects whose EntityType is Player, for the AI scans (no walk over the whole object list)
+    const std::vector<GameObject*>& GetPlayers() const { return m_players; }
     // provide access to object list for other systems (Factory)
     /*DEPRECATED OBJECT MANAGEMENT*/std::vector<Object*>& GetObjectList() { return m_objectlist; }
     /*DEPRECATED OBJECT MANAGEMENT*/const std::vector<Object*>& GetObjectList() const { return m_objectlist; }
 
     //---------------------------------------------------------------------------------------------
     // Objects' Components management
+    //---------------------------------------------------------------------------------------------
+    // Viewport culling statistics of the current frame, one entry per Render() call (i.e. per viewport)
+    struct CullingStats
+    {
+        short playerId = 0;
+        SDL_FRect view = { 0.0f, 0.0f, 0.0f, 0.0f }; // camera area in world coordinates
+        size_t tested = 0;   // components with a render or debug pass
+        size_t visible = 0;  // rendered in this viewport
+        size_t culled = 0;   // skipped in this viewport
+    };
+    const std::vector<CullingStats>& GetCullingStats() const { return m_cullingStats; }
+
+    //---------------------------------------------------------------------------------------------
     /*DEPRECATED OBJECT MANAGEMENT*/void StoreComponent(ObjectComponent* objectComponent)
     {
         if (!objectComponent)
@@ -185,7 +218,8 @@ public:
         {
             //add Component to the right type list in the array
             array_component_lists_bytypes[static_cast<size_t>(objectComponent->GetComponentType())].push_back(objectComponent);
-            SYSTEM_LOG << "World: Added component " + objectComponent->name + " of type " << static_cast<int>(objectComponent->GetComponentType()) << " to World\n";
+            m_visibilityDirty = true;
+            SYSTEM_LOG << "World: Added component " << objectComponent->name << " of type " << static_cast<int>(objectComponent->GetComponentType()) << " to World\n";
         }
         catch (const std::exception&)
         {
@@ -197,11 +231,34 @@ public:
     // Level management
     void AddLevel(std::unique_ptr<Level> level)
     {
-        if (level) m_levels.push_back(std::move(level));
+        if (!level) return;
+        m_levels.push_back(std::move(level));
+        // first level loaded: its first sector becomes the active one
+        if (!m_activeSector && !m_levels.back()->sectors.empty()) SetActiveSector(m_levels.back()->sectors.front().get());
     }
 
     const std::vector<std::unique_ptr<Level>>& GetLevels() const { return m_levels; }
 
+    // Level used until levels are loaded from files: one sector whose collision map covers
+    // widthCells x heightCells cells from the world origin, every cell walkable
+    void CreateDefaultLevel(int widthCells = k_DEFAULT_LEVEL_CELLS, int heightCells = k_DEFAULT_LEVEL_CELLS, float cellSize = 32.0f)
+    {
+        std::unique_ptr<Sector> sector = std::make_unique<Sector>("Default");
+        sector->collision->Resize(widthCells, heightCells, cellSize);
+        std::unique_ptr<Level> level = std::make_unique<Level>("Default");
+        level->AddSector(std::move(sector));
+        AddLevel(std::move(level));
+    }
+
+    // Sector the navigation services (PathfindingManager, FlowFieldManager) search on
+    void SetActiveSector(Sector* sector)
+    {
+        m_activeSector = sector;
+        PathfindingManager::Get().SetCollisionMap(sector ? sector->collision.get() : nullptr);
+        if (sector) SYSTEM_LOG << "World: active sector '" << sector->name << "'\n";
+    }
+    Sector* GetActiveSector() const { return m_activeSector; }
+
     // -------------------------------------------------------------
     // ECS Entity Management
     EntityID CreateEntity();
@@ -308,8 +365,38 @@ private:
 private:
 
     /*DEPRECATED OBJECT MANAGEMENT*/std::vector<Object*> m_objectlist;
+    std::unordered_map<uint64_t, Object*> m_objectsByUID;
+    std::vector<GameObject*> m_players;
     /*DEPRECATED OBJECT MANAGEMENT*/std::array<std::vector<ObjectComponent*>, static_cast<size_t>(ComponentType::Count)> array_component_lists_bytypes;
 
+    // Viewport culling: Visual and AI components indexed by world bounds once per frame
+    struct Renderable
+    {
+        ObjectComponent* component;
+        SDL_FRect bounds;
+        bool extracted;      // drawn from m_renderList instead of Render()
+        uint32_t firstItem;
+        uint32_t itemCount;
+    };
+    void BuildVisibilityIndex();     // once per frame: spatial index + render list extraction
+    void CollectVisibleComponents(); // fills m_visibleVisual / m_visibleAI for the active camera
+    void RenderVisibleItems();       // replays the render list for the active camera
+
+    RenderList m_renderList;         // world-space draw items of the frame
+    SDL_FRect m_viewRect = { 0.0f, 0.0f, 0.0f, 0.0f }; // active camera area (world)
+    float m_viewZoom = 1.0f;
+
+    SpatialGrid m_visibilityGrid;
+    std::vector<Renderable> m_renderables;      // Visual components first, then AI components
+    size_t m_visualRenderableCount = 0;
+    std::vector<uint32_t> m_alwaysVisible;       // components without world bounds
+    std::vector<uint32_t> m_visibleIds;
+    std::vector<ObjectComponent*> m_visibleVisual;
+    std::vector<ObjectComponent*> m_visibleAI;
+    std::vector<CullingStats> m_cullingStats;
+    bool m_visibilityDirty = true;
+
 
     std::vector<std::unique_ptr<Level>> m_levels;
+    Sector* m_activeSector = nullptr;
 };
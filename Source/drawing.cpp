@@ -2,6 +2,7 @@
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_render.h>
 #include <cmath>
+#include <vector>
 #include "vector.h"
 
 // Portable pi definition for C++14 (avoids M_PI reliance)
@@ -54,22 +55,27 @@ static inline SDL_Color ToColor(const SDL_FColor& f)
 }
 //----------------------------------------------------------
 // Draws a circle using the Midpoint Circle Algorithm
+// Points are collected first and submitted with a single SDL_RenderPoints call
 void Draw_Circle(SDL_Renderer* renderer, int cx, int cy, int radius)
 {
+    static std::vector<SDL_FPoint> points;
+    points.clear();
+
     int x = radius;
     int y = 0;
     int err = 0;
 
     while (x >= y)
     {
-        SDL_RenderPoint(renderer, (float)cx + x, (float)cy + y);
-        SDL_RenderPoint(renderer, (float)cx + y, (float)cy + x);
-        SDL_RenderPoint(renderer, (float)cx - y, (float)cy + x);
-        SDL_RenderPoint(renderer, (float)cx - x, (float)cy + y);
-        SDL_RenderPoint(renderer, (float)cx - x, (float)cy - y);
-        SDL_RenderPoint(renderer, (float)cx - y, (float)cy - x);
-        SDL_RenderPoint(renderer, (float)cx + y, (float)cy - x);
-        SDL_RenderPoint(renderer, (float)cx + x, (float)cy - y);
+        const float fx = (float)x, fy = (float)y;
+        points.push_back({ cx + fx, cy + fy });
+        points.push_back({ cx + fy, cy + fx });
+        points.push_back({ cx - fy, cy + fx });
+        points.push_back({ cx - fx, cy + fy });
+        points.push_back({ cx - fx, cy - fy });
+        points.push_back({ cx - fy, cy - fx });
+        points.push_back({ cx + fy, cy - fx });
+        points.push_back({ cx + fx, cy - fy });
 
         if (err <= 0)
         {
@@ -82,12 +88,17 @@ void Draw_Circle(SDL_Renderer* renderer, int cx, int cy, int radius)
             err -= 2 * x + 1;
         }
     }
+    SDL_RenderPoints(renderer, points.data(), static_cast<int>(points.size()));
 }
 //----------------------------------------------------------
 // Draws a filled circle using horizontal scanlines
-// Optimized: use integer arithmetic to avoid sqrt in loop
+// Optimized: use integer arithmetic to avoid sqrt in loop, scanlines submitted as 1 pixel high
+// rectangles in a single SDL_RenderFillRects call
 void Draw_FilledCircle(SDL_Renderer* renderer, int cx, int cy, int radius)
 {
+    static std::vector<SDL_FRect> spans;
+    spans.clear();
+
     int r2 = radius * radius;
     for (int dy = -radius; dy <= radius; ++dy)
     {
@@ -96,10 +107,9 @@ void Draw_FilledCircle(SDL_Renderer* renderer, int cx, int cy, int radius)
         int dx2 = r2 - dy2;
         // Only compute sqrt once per scanline
         int dx = static_cast<int>(std::sqrt(static_cast<float>(dx2)));
-        int x1 = cx - dx;
-        int x2 = cx + dx;
-        SDL_RenderLine(renderer, (float)x1, (float)cy + dy, (float)x2, (float)cy + dy);
+        spans.push_back({ (float)(cx - dx), (float)(cy + dy), (float)(2 * dx + 1), 1.0f });
     }
+    SDL_RenderFillRects(renderer, spans.data(), static_cast<int>(spans.size()));
 }
 //----------------------------------------------------------
 // Draws the outline of a triangle
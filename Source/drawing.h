@@ -3,6 +3,8 @@ purpose: This file contains functions related to drawing shapes and images on th
 
 Performance Notes:
 - Draw_FilledCircle: Optimized to use integer arithmetic and minimize sqrt calls
+- Draw_Circle/Draw_FilledCircle: one SDL call per shape (points / scanlines are collected first)
+- Debug overlays should use DebugDraw (DebugDraw.h) which batches all primitives of a viewport
 - Draw_Hexagon/Draw_FilledHexagon: Use pre-calculated trigonometric values for better performance
 */
 #pragma once
@@ -14,20 +14,29 @@ void CameraManager::Initialize()
     // Create default camera for player 0
   //  CreateCameraForPlayer(0);
 
-    // Register to camera-related events
-    EM::Get().Register(this, EventType::Olympe_EventType_Camera_Shake);
-    EM::Get().Register(this, EventType::Olympe_EventType_Camera_Teleport);
-    EM::Get().Register(this, EventType::Olympe_EventType_Camera_MoveToPosition);
-    EM::Get().Register(this, EventType::Olympe_EventType_Camera_ZoomTo);
-    EM::Get().Register(this, EventType::Olympe_EventType_Camera_Reset);
-    EM::Get().Register(this, EventType::Olympe_EventType_Camera_Mode_2D);
-    EM::Get().Register(this, EventType::Olympe_EventType_Camera_Mode_2_5D);
-    EM::Get().Register(this, EventType::Olympe_EventType_Camera_Mode_Isometric);
-    EM::Get().Register(this, EventType::Olympe_EventType_Camera_Target_Follow);
-    EM::Get().Register(this, EventType::Olympe_EventType_Camera_Target_Unfollow);
-    EM::Get().Register(this, EventType::Olympe_EventType_Camera_Viewport_Add);
-    EM::Get().Register(this, EventType::Olympe_EventType_Camera_Viewport_Remove);
-    EM::Get().Register(this, EventType::Olympe_EventType_Camera_Viewport_Clear);
+    // Register to camera-related events. Per message, not RegisterBatch: the types act on the
+    // same camera state (Teleport/Reset, Follow/Unfollow, Viewport_Add/Clear) and their
+    // relative order must be kept
+    static const EventType cameraEvents[] =
+    {
+        EventType::Olympe_EventType_Camera_Shake,
+        EventType::Olympe_EventType_Camera_Teleport,
+        EventType::Olympe_EventType_Camera_MoveToPosition,
+        EventType::Olympe_EventType_Camera_ZoomTo,
+        EventType::Olympe_EventType_Camera_Reset,
+        EventType::Olympe_EventType_Camera_Mode_2D,
+        EventType::Olympe_EventType_Camera_Mode_2_5D,
+        EventType::Olympe_EventType_Camera_Mode_Isometric,
+        EventType::Olympe_EventType_Camera_Target_Follow,
+        EventType::Olympe_EventType_Camera_Target_Unfollow,
+        EventType::Olympe_EventType_Camera_Viewport_Add,
+        EventType::Olympe_EventType_Camera_Viewport_Remove,
+        EventType::Olympe_EventType_Camera_Viewport_Clear
+    };
+    for (EventType type : cameraEvents)
+    {
+        EM::Get().Register(this, type);
+    }
 
 	SYSTEM_LOG << "CameraManager Initialized\n";
 }
@@ -101,6 +110,28 @@ Vector CameraManager::GetCameraPositionForActivePlayer(short playerID) const
     return Vector();
 }
 
+float CameraManager::GetActiveCameraZoom() const
+{
+	auto it = m_cameraInstances.find(GetActivePlayerID());
+	if (it == m_cameraInstances.end()) it = m_cameraInstances.find(0); // same fallback as the position
+	if (it == m_cameraInstances.end() || it->second.zoom <= 0.0f) return 1.0f;
+	return it->second.zoom;
+}
+
+Vector CameraManager::WorldToRender(const Vector& worldPos) const
+{
+	const Vector camPos = GetCameraPositionForActivePlayer();
+	const float zoom = GetActiveCameraZoom();
+	return Vector((worldPos.x - camPos.x) * zoom, (worldPos.y - camPos.y) * zoom, worldPos.z);
+}
+
+SDL_FRect CameraManager::WorldToRender(const SDL_FRect& worldRect) const
+{
+	const Vector camPos = GetCameraPositionForActivePlayer();
+	const float zoom = GetActiveCameraZoom();
+	return { (worldRect.x - camPos.x) * zoom, (worldRect.y - camPos.y) * zoom, worldRect.w * zoom, worldRect.h * zoom };
+}
+
 void CameraManager::Process()
 {
 	//process only if there are camera instances
@@ -154,17 +185,8 @@ void CameraManager::Apply(SDL_Renderer* renderer, short playerID)
     }
 }
 
-void CameraManager::OnEvent(const Message& msg)
+CameraManager::CameraInstance& CameraManager::GetOrCreateCamera(short playerID)
 {
-    if (msg.struct_type != EventStructType::EventStructType_Olympe)
-		return;
-
-    // Generic event handler that updates camera instances based on message payload.
-    // Messages can target specific player via msg.deviceId (player index) or default to 0.
-    short playerID = 0;
-    if (msg.param1 >= 0) 
-        playerID = static_cast<short>(msg.param1);
-
     auto it = m_cameraInstances.find(playerID);
     if (it == m_cameraInstances.end())
     {
@@ -172,8 +194,26 @@ void CameraManager::OnEvent(const Message& msg)
         CreateCameraForPlayer(playerID);
         it = m_cameraInstances.find(playerID);
     }
-    CameraInstance& cam = it->second;
+    return it->second;
+}
+
+// Messages can target specific player via msg.deviceId (player index) or default to 0.
+static short GetMessagePlayerID(const Message& msg)
+{
+    return (msg.param1 >= 0) ? static_cast<short>(msg.param1) : 0;
+}
 
+void CameraManager::OnEvent(const Message& msg)
+{
+    if (msg.struct_type != EventStructType::EventStructType_Olympe)
+		return;
+
+    // Generic event handler that updates camera instances based on message payload.
+    ApplyEvent(GetOrCreateCamera(GetMessagePlayerID(msg)), msg);
+}
+
+void CameraManager::ApplyEvent(CameraInstance& cam, const Message& msg)
+{
     switch (msg.msg_type)
     {
         case EventType::Olympe_EventType_Camera_Teleport:
@@ -82,6 +82,12 @@ public:
 
 	Vector GetCameraPositionForActivePlayer(short playerID = 0) const;
 
+    // World -> render coordinates with the active camera: (world - camera position) * zoom.
+    // Every world-space draw goes through it so that sprites and debug overlays stay aligned.
+    float GetActiveCameraZoom() const;
+    Vector WorldToRender(const Vector& worldPos) const;
+    SDL_FRect WorldToRender(const SDL_FRect& worldRect) const;
+
 	void Process(); // per-frame processing (if needed)
 
     // Handle incoming engine messages for camera control
@@ -108,6 +114,9 @@ public:
     }
 
 private:
+    CameraInstance& GetOrCreateCamera(short playerID);
+    void ApplyEvent(CameraInstance& cam, const Message& msg);
+
     std::unordered_map<short, CameraInstance> m_cameraInstances;
 	short m_activePlayerID = 0; // currently active player for camera and viewport rendering
 };
\ No newline at end of file
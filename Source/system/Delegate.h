@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Delegate: fixed size callable, never allocates (replaces std::function on hot paths).
+// Inline (header-only) implementation placed in Source/system.
+//
+// Stores a stub function pointer and a small buffer (two pointers):
+//  - Bind<C, &C::Method>(object): member function known at compile time, the stub
+//    calls it directly (no virtual call, no pointer to member at run time)
+//  - Bind<&Function>(): free / static function
+//  - FromFunctor(f): small trivially copyable functor, e.g. a lambda capturing a
+//    pointer or two (checked at compile time)
+// Trivially copyable itself: delegates are copied in arrays without any cost.
+
+template<typename Signature>
+class Delegate;
+
+template<typename R, typename... Args>
+class Delegate<R(Args...)>
+{
+public:
+    static const size_t k_STORAGE_SIZE = 2 * sizeof(void*);
+
+    Delegate() = default;
+
+    template<typename C, R (C::*Method)(Args...)>
+    static Delegate Bind(C* object)
+    {
+        Delegate d;
+        d.m_object = object;
+        d.m_stub = &MethodStub<C, Method>;
+        return d;
+    }
+
+    template<R (*Function)(Args...)>
+    static Delegate Bind()
+    {
+        Delegate d;
+        d.m_stub = &FunctionStub<Function>;
+        return d;
+    }
+
+    template<typename F>
+    static Delegate FromFunctor(const F& functor)
+    {
+        static_assert(sizeof(F) <= k_STORAGE_SIZE, "Delegate: functor too large, capture less or bind a member function");
+        static_assert(alignof(F) <= alignof(Storage), "Delegate: functor alignment not supported");
+        static_assert(std::is_trivially_copyable<F>::value && std::is_trivially_destructible<F>::value,
+            "Delegate: the functor must be trivially copyable (capture pointers / values, not std::string or std::function)");
+        Delegate d;
+        new (&d.m_storage) F(functor);
+        d.m_stub = &FunctorStub<F>;
+        return d;
+    }
+
+    R operator()(Args... args) const { return m_stub(this, std::forward<Args>(args)...); }
+
+    explicit operator bool() const { return m_stub != nullptr; }
+
+    // Same target (member functions: same object and method)
+    bool operator==(const Delegate& other) const
+    {
+        return m_stub == other.m_stub && std::memcmp(&m_storage, &other.m_storage, sizeof(Storage)) == 0;
+    }
+    bool operator!=(const Delegate& other) const { return !(*this == other); }
+
+private:
+    using Stub = R (*)(const Delegate*, Args...);
+    union Storage
+    {
+        void* pointers[2];
+        double alignment;
+        unsigned char bytes[k_STORAGE_SIZE];
+    };
+
+    template<typename C, R (C::*Method)(Args...)>
+    static R MethodStub(const Delegate* d, Args... args)
+    {
+        return (static_cast<C*>(d->m_object)->*Method)(std::forward<Args>(args)...);
+    }
+
+    template<R (*Function)(Args...)>
+    static R FunctionStub(const Delegate*, Args... args)
+    {
+        return Function(std::forward<Args>(args)...);
+    }
+
+    template<typename F>
+    static R FunctorStub(const Delegate* d, Args... args)
+    {
+        return (*reinterpret_cast<const F*>(&d->m_storage))(std::forward<Args>(args)...);
+    }
+
+    union
+    {
+        void* m_object;
+        Storage m_storage = {};
+    };
+    Stub m_stub = nullptr;
+};
@@ -0,0 +1,276 @@
+#pragma once
+
+#include "Delegate.h"
+#include "MPSCQueue.h"
+#include "EventRouting.h"
+#include "system_utils.h"
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <typeinfo>
+#include <utility>
+#include <cstdint>
+
+// EventChannel<T>: statically typed event bus, one channel per event struct.
+// Inline (header-only) implementation placed in Source/system.
+//
+// EventChannel<T>::Get() is the channel lookup, resolved at compile time (no map, no
+// EventType switch). Handlers are Delegate<void(const T&)>: bound member functions are
+// called directly, no std::function and no allocation when publishing.
+//  - Publish(): immediate dispatch on the calling thread
+//  - Post(): any thread, lock-free (MPSC ring, locked overflow list when full like the
+//    EventManager); the posted events are dispatched by EventManager::Process()
+//
+// Subscribers are immutable snapshots, as in the EventManager: Subscribe/Unsubscribe
+// publish a new list under a mutex, a dispatch in progress skips the handlers
+// unsubscribed meanwhile and an owner is never called once Unsubscribe() has returned.
+// SubscribeRouted(owner, route, key, handler): the handler only receives the events whose
+// route(ev) == key (see EventRouting.h), e.g. the inputs of one device.
+// SetCoalescing(key, merge): the events posted with the same key within a frame are
+// merged into one (latest stick value, summed mouse motion), dispatched after the others.
+// The Message API stays the compatibility layer: EventManager::UnregisterAll() also
+// unsubscribes the owner from every channel.
+
+class EventChannelBase
+{
+public:
+    static const int k_MAX_EVENT_CHANNELS = 64;
+
+    virtual ~EventChannelBase() {}
+    virtual void Flush() = 0;                  // dispatches the posted events (main thread)
+    virtual void Unsubscribe(void* owner) = 0;
+
+    // Every channel used so far
+    static void FlushAll()
+    {
+        const int count = Registry().count.load(std::memory_order_acquire);
+        for (int i = 0; i < count; ++i) Registry().channels[i]->Flush();
+    }
+    static void UnsubscribeAll(void* owner)
+    {
+        const int count = Registry().count.load(std::memory_order_acquire);
+        for (int i = 0; i < count; ++i) Registry().channels[i]->Unsubscribe(owner);
+    }
+
+protected:
+    void RegisterChannel(const char* typeName)
+    {
+        ChannelRegistry& r = Registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        const int index = r.count.load(std::memory_order_relaxed);
+        if (index >= k_MAX_EVENT_CHANNELS)
+        {
+            SYSTEM_LOG << "EventChannel: too many channels (" << k_MAX_EVENT_CHANNELS << "), " << typeName << " events are not flushed\n";
+            return;
+        }
+        r.channels[index] = this;
+        r.count.store(index + 1, std::memory_order_release); // readers see the pointer before the count
+    }
+
+private:
+    struct ChannelRegistry
+    {
+        EventChannelBase* channels[k_MAX_EVENT_CHANNELS] = {};
+        std::atomic<int> count{ 0 };
+        std::mutex mutex;
+    };
+    static ChannelRegistry& Registry()
+    {
+        static ChannelRegistry registry;
+        return registry;
+    }
+};
+
+template<typename T>
+class EventChannel : public EventChannelBase
+{
+public:
+    using Handler = Delegate<void(const T&)>;
+    struct Subscriber
+    {
+        void* owner;
+        Handler handler;
+        std::shared_ptr<std::atomic<bool>> active; // cleared by Unsubscribe, checked by the dispatch
+    };
+    using SubscriberList = std::vector<Subscriber>;
+    using SubscriberSnapshot = std::shared_ptr<const SubscriberList>;
+    using RouteKeyFunction = uint64_t (*)(const T& ev);
+    using RoutedSubscribers = RouteTable<T, Subscriber>;
+    using CoalesceKey = uint64_t (*)(const T& ev);            // events with the same key are merged
+    using CoalesceMerge = void (*)(T& pending, const T& ev);  // merges 'ev' (newer) into 'pending'
+
+    static const size_t k_CHANNEL_QUEUE_CAPACITY = 1024;
+
+    static EventChannel& Get()
+    {
+        static EventChannel instance;
+        return instance;
+    }
+
+    void Subscribe(void* owner, Handler handler)
+    {
+        if (!handler) return;
+        std::lock_guard<std::mutex> lock(m_subscribersMutex);
+        const SubscriberSnapshot current = std::atomic_load(&m_subscribers);
+        SubscriberList list = current ? *current : SubscriberList();
+        list.push_back({ owner, handler, std::make_shared<std::atomic<bool>>(true) });
+        std::atomic_store(&m_subscribers, SubscriberSnapshot(std::make_shared<const SubscriberList>(std::move(list))));
+    }
+
+    // Convenience: Subscribe<AI_Player, &AI_Player::OnKeyboardEvent>(this), the object is the owner
+    template<typename C, void (C::*Method)(const T&)>
+    void Subscribe(C* object)
+    {
+        Subscribe(static_cast<void*>(object), Handler::template Bind<C, Method>(object));
+    }
+
+    void SubscribeRouted(void* owner, RouteKeyFunction route, uint64_t key, Handler handler)
+    {
+        if (!handler || !route) return;
+        std::lock_guard<std::mutex> lock(m_subscribersMutex);
+        const std::shared_ptr<const RoutedSubscribers> current = std::atomic_load(&m_routedSubscribers);
+        auto table = current ? std::make_shared<RoutedSubscribers>(*current) : std::make_shared<RoutedSubscribers>();
+        table->Add(route, key, { owner, handler, std::make_shared<std::atomic<bool>>(true) });
+        std::atomic_store(&m_routedSubscribers, std::shared_ptr<const RoutedSubscribers>(std::move(table)));
+    }
+
+    // Convenience: SubscribeRouted<AI_Player, &AI_Player::OnKeyboardEvent>(this, &KeyboardEvent::RouteByDevice, key)
+    template<typename C, void (C::*Method)(const T&)>
+    void SubscribeRouted(C* object, RouteKeyFunction route, uint64_t key)
+    {
+        SubscribeRouted(static_cast<void*>(object), route, key, Handler::template Bind<C, Method>(object));
+    }
+
+    virtual void Unsubscribe(void* owner) override
+    {
+        std::lock_guard<std::mutex> lock(m_subscribersMutex);
+        const std::shared_ptr<const RoutedSubscribers> routed = std::atomic_load(&m_routedSubscribers);
+        if (routed)
+        {
+            auto table = std::make_shared<RoutedSubscribers>(*routed);
+            if (table->Remove(owner) > 0)
+                std::atomic_store(&m_routedSubscribers, table->IsEmpty() ? std::shared_ptr<const RoutedSubscribers>() : std::shared_ptr<const RoutedSubscribers>(std::move(table)));
+        }
+
+        const SubscriberSnapshot current = std::atomic_load(&m_subscribers);
+        if (!current) return;
+        SubscriberList list;
+        for (const auto& s : *current)
+        {
+            if (s.owner == owner) s.active->store(false, std::memory_order_release); // skipped by dispatches in progress
+            else list.push_back(s);
+        }
+        if (list.size() == current->size()) return;
+        std::atomic_store(&m_subscribers, list.empty() ? SubscriberSnapshot() : SubscriberSnapshot(std::make_shared<const SubscriberList>(std::move(list))));
+    }
+
+    // Immediate dispatch on the calling thread
+    void Publish(const T& ev) const
+    {
+        const SubscriberSnapshot subscribers = std::atomic_load(&m_subscribers); // keeps the list alive while dispatching
+        if (subscribers)
+        {
+            for (const auto& s : *subscribers)
+            {
+                if (s.active->load(std::memory_order_acquire))
+                    s.handler(ev);
+            }
+        }
+        const std::shared_ptr<const RoutedSubscribers> routed = std::atomic_load(&m_routedSubscribers);
+        if (routed) routed->ForEach(ev, [&ev](const Subscriber& s) { s.handler(ev); });
+    }
+
+    // Any thread. nullptr: no coalescing (default)
+    void SetCoalescing(CoalesceKey key, CoalesceMerge merge)
+    {
+        std::lock_guard<std::mutex> lock(m_coalesceMutex);
+        m_coalesceMerge = merge;
+        m_coalesceKey.store((key && merge) ? key : nullptr, std::memory_order_release);
+    }
+
+    // Queued until the next EventManager::Process() (any thread)
+    void Post(const T& ev)
+    {
+        if (m_coalesceKey.load(std::memory_order_acquire) && Coalesce(ev)) return;
+        if (m_queue.TryPush(ev)) return;
+        std::lock_guard<std::mutex> lock(m_overflowMutex);
+        if (!m_overflowWarned)
+        {
+            m_overflowWarned = true;
+            SYSTEM_LOG << "EventChannel<" << typeid(T).name() << ">: queue full (" << m_queue.GetCapacity() << " events), using the overflow list\n";
+        }
+        m_overflow.push_back(ev);
+        m_hasOverflow.store(true, std::memory_order_release);
+    }
+
+    // Main thread only. Events posted while dispatching wait for the next Flush().
+    virtual void Flush() override
+    {
+        std::vector<T>& toDispatch = m_frameBuffers[m_backBuffer];
+        T ev;
+        while (m_queue.TryPop(ev)) toDispatch.push_back(ev);
+        if (m_hasOverflow.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(m_overflowMutex);
+            toDispatch.insert(toDispatch.end(), m_overflow.begin(), m_overflow.end());
+            m_overflow.clear();
+            m_hasOverflow.store(false, std::memory_order_relaxed);
+        }
+        if (m_hasCoalesced.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(m_coalesceMutex);
+            for (const auto& c : m_coalesced) toDispatch.push_back(c.second);
+            m_coalesced.clear();
+            m_hasCoalesced.store(false, std::memory_order_relaxed);
+        }
+        if (toDispatch.empty()) return;
+
+        m_backBuffer ^= 1; // a Flush() called by a handler fills the other buffer
+        for (const T& e : toDispatch) Publish(e);
+        toDispatch.clear(); // keeps the capacity
+    }
+
+private:
+    EventChannel() : m_queue(k_CHANNEL_QUEUE_CAPACITY)
+    {
+        RegisterChannel(typeid(T).name());
+    }
+
+    // False if coalescing was disabled meanwhile. Linear search, a few keys per frame.
+    bool Coalesce(const T& ev)
+    {
+        std::lock_guard<std::mutex> lock(m_coalesceMutex);
+        const CoalesceKey keyFunction = m_coalesceKey.load(std::memory_order_relaxed);
+        if (!keyFunction) return false;
+        const uint64_t key = keyFunction(ev);
+        for (auto& c : m_coalesced)
+        {
+            if (c.first != key) continue;
+            m_coalesceMerge(c.second, ev);
+            return true;
+        }
+        m_coalesced.emplace_back(key, ev);
+        m_hasCoalesced.store(true, std::memory_order_release);
+        return true;
+    }
+
+    SubscriberSnapshot m_subscribers; // null when empty
+    std::shared_ptr<const RoutedSubscribers> m_routedSubscribers; // null when empty
+    std::mutex m_subscribersMutex;    // serializes the writers
+
+    MPSCQueue<T> m_queue;
+    std::vector<T> m_frameBuffers[2];
+    int m_backBuffer = 0;
+
+    std::vector<T> m_overflow;
+    std::mutex m_overflowMutex;
+    std::atomic<bool> m_hasOverflow{ false };
+    bool m_overflowWarned = false;
+
+    std::atomic<CoalesceKey> m_coalesceKey{ nullptr };
+    CoalesceMerge m_coalesceMerge = nullptr;
+    std::vector<std::pair<uint64_t, T>> m_coalesced; // this frame, dispatched after the posted events
+    std::mutex m_coalesceMutex;
+    std::atomic<bool> m_hasCoalesced{ false };
+};
@@ -4,26 +4,146 @@
 #include "message.h"
 #include <unordered_map>
 #include <vector>
+#include <array>
+#include <memory>
 #include <functional>
 #include <mutex>
-#include <queue>
+#include <atomic>
 #include <algorithm>
 #include "system_utils.h"
+#include "MPSCQueue.h"
+#include "MessageArena.h"
+#include "EventChannel.h"
+#include "EventRouting.h"
+#include "system_events.h"
+#include <string>
+#include <thread>
+#include <chrono>
 
 // EventManager: central dispatcher for engine messages.
 // Inline (header-only) implementation placed in Source/system.
+//
+// AddMessage() is lock-free from any thread (workers: asset loading, pathfinding...):
+// messages go into the bounded MPSC ring of their priority (SetPriority). Process() (main
+// thread, the only consumer) drains the rings into per-priority pending lists that keep
+// their capacity, so draining doesn't allocate. When a ring is full messages go to a
+// locked overflow list, drained after the ring content.
+//
+// Priorities are dispatched in order. Critical messages (inputs, gameplay) are all
+// dispatched every frame; the lower priorities are dispatched under a per-frame time
+// budget and the rest is carried over to the next frame (deferrable work spreads over
+// frames), except the messages older than the priority deadline. Latency (post ->
+// dispatch), backlog and starvation (frames in a row ending with a backlog) are measured
+// per priority: GetPriorityStats(), LogPriorityStats().
+//
+// Messages are small trivially copyable headers; strings and other variable size data
+// are posted with AddMessage(msg, payload) and stored in a per-frame MessageArena,
+// read with GetPayload() / GetPayloadString() by the listeners. Payloads are valid
+// until the end of the Process() dispatching them: listeners keep a copy if needed.
+//
+// Listeners are immutable snapshots (shared_ptr to a const list) in an array indexed
+// by EventType; ids outside the enum (Win32 messages, menu commands) use a snapshot
+// map. Register/Unregister copy the list and publish a new snapshot under a mutex,
+// dispatch loads the snapshot atomically without locking or copying the callbacks.
+// A snapshot being dispatched stays valid after an Unregister, and the unregistered
+// entries are skipped (their 'active' flag is cleared): an owner is never called once
+// Unregister() has returned.
+//
+// Hot events (inputs, collisions) also have typed channels, EventChannel<T> with T in
+// system_events.h: no switch on the message type, no std::function. Process() flushes
+// the events posted on the channels before the messages.
+//
+// Batch listeners (RegisterBatch) get the messages of a frame grouped by EventType: one
+// call with a contiguous MessageSpan per type, in arrival order within the type, the
+// types in the order of their first message. They run after the per-message listeners.
+// The order between messages of different types is lost: only batch the types whose effect
+// does not depend on the messages of the other types of the frame (accumulating, counting,
+// one independent state per type). State machines driven by several types
+// (Teleport/Reset, Follow/Unfollow, Viewport_Add/Clear...) stay on the per-message path.
+//
+// Routed listeners (RegisterRouted, RegisterForTarget, RegisterForDevice) only receive the
+// messages whose routing key matches theirs: Message::targetUid, the device id or any key
+// function. The lookup is O(1) per route, instead of every listener receiving and
+// filtering every message. They run right after the broadcast listeners.
+//
+// High frequency inputs (1000 Hz mouse, noisy sticks) are coalesced at post time when
+// their type has a CoalesceMode: the message updates a small table keyed on (type,
+// device, control) instead of entering the ring, so the queue and the dispatch stay
+// bounded by the number of devices, not by their poll rate. A coalesced message is
+// dispatched at the position of the first message it merges (post sequence), so it stays
+// before a Disconnected posted later by the same device; button edges are never
+// coalesced (no mode).
+
+// Dispatch order and budget of the queued messages (EventManager::SetPriority)
+enum class EventPriority : uint8_t
+{
+    Critical = 0, // inputs and gameplay critical: all dispatched every frame
+    Normal,       // dispatched under a per-frame budget, the rest carried over
+    Low,          // deferrable (sector activation, reloads): smaller budget
+    Count
+};
+
+// Per priority metrics, since the last ResetPriorityStats()
+struct EventPriorityStats
+{
+    uint64_t dispatched = 0;
+    double totalLatencyMs = 0.0; // post -> dispatch, summed over the dispatched messages
+    double maxLatencyMs = 0.0;
+    double lastFrameMs = 0.0;    // dispatch time in the last Process()
+    size_t backlog = 0;          // messages carried over to the next frame
+    size_t maxBacklog = 0;
+    int starvedFrames = 0;       // Process() calls in a row ending with a backlog
+    int maxStarvedFrames = 0;
+
+    double GetAverageLatencyMs() const { return dispatched ? totalLatencyMs / static_cast<double>(dispatched) : 0.0; }
+};
+
+// How the messages of a type posted within a frame are merged (EventManager::SetCoalescing).
+// Messages are merged per (msg_type, deviceId, controlId).
+enum class CoalesceMode : uint8_t
+{
+    None = 0,  // every message is dispatched
+    Latest,    // only the last message is dispatched (positions, axis values)
+    Accumulate // the last message with param1 / param2 summed (relative motions, wheel)
+};
 
 class EventManager : public Object
 {
 public:
     using Message = ::Message;
     using Listener = std::function<void(const Message&)>;
-    using ListenerEntry = std::pair<void*, Listener>; // owner pointer + callback
+    struct ListenerEntry
+    {
+        void* owner;
+        Listener callback;
+        std::shared_ptr<std::atomic<bool>> active; // cleared by Unregister, checked by the dispatch
+    };
+    using ListenerList = std::vector<ListenerEntry>;
+    using ListenerSnapshot = std::shared_ptr<const ListenerList>;
+
+    using BatchListener = std::function<void(const MessageSpan&)>;
+    struct BatchListenerEntry
+    {
+        void* owner;
+        BatchListener callback;
+        std::shared_ptr<std::atomic<bool>> active;
+    };
+    using BatchListenerList = std::vector<BatchListenerEntry>;
+    using BatchListenerSnapshot = std::shared_ptr<const BatchListenerList>;
+
+    using RouteKeyFunction = uint64_t (*)(const Message& msg);
+    using RoutedListeners = RouteTable<Message, ListenerEntry>;
 
 public:
-    EventManager()
+    static const size_t k_EVENT_QUEUE_CAPACITY = 4096; // per priority
+    static const int k_EVENT_PRIORITY_COUNT = static_cast<int>(EventPriority::Count);
+    static const int k_STARVATION_WARNING_FRAMES = 120; // a backlog for that many frames is logged
+
+    EventManager() : m_sparseListeners(std::make_shared<const SparseListeners>())
     {
 		name = "EventManager";
+        for (auto& mode : m_coalesceModes) mode.store(static_cast<uint8_t>(CoalesceMode::None), std::memory_order_relaxed);
+        SetDefaultPriorities();
         SYSTEM_LOG << "EventManager created and Initialized\n";
     }
 
@@ -42,47 +162,162 @@ public:
     }
     static EventManager& Get() { return GetInstance(); }
 
-    // Post a message to be dispatched during the next Process() call.
+    // Post a message to be dispatched during the next Process() call (any thread).
     void AddMessage(const Message& msg)
     {
-        std::lock_guard<std::mutex> lock(m_queueMutex);
-        m_queue.push(msg);
+        if (GetCoalescing(msg.msg_type) != CoalesceMode::None)
+        {
+            Coalesce(msg);
+            return;
+        }
+        QueuedMessage qm;
+        qm.msg = msg;
+        qm.postTime = Clock::now();
+        qm.sequence = m_postSequence.fetch_add(1, std::memory_order_relaxed);
+        PriorityQueue& q = m_queues[static_cast<size_t>(GetPriority(msg.msg_type))];
+        if (!q.ring.TryPush(qm)) AddOverflow(q, qm);
     }
 
-    // Immediately dispatch a message to registered listeners (no queue)
-    void DispatchImmediate(const Message& msg)
+    // Priority of a message type (EventType values of the enum only, the others are Normal), any thread
+    void SetPriority(EventType type, EventPriority priority)
+    {
+        if (!IsDense(type) || priority >= EventPriority::Count) return;
+        m_priorities[static_cast<size_t>(type)].store(static_cast<uint8_t>(priority), std::memory_order_release);
+    }
+    EventPriority GetPriority(EventType type) const
+    {
+        if (!IsDense(type)) return EventPriority::Normal;
+        return static_cast<EventPriority>(m_priorities[static_cast<size_t>(type)].load(std::memory_order_acquire));
+    }
+
+    // Per-frame dispatch budget of a priority (0: no budget, everything is dispatched) and
+    // deadline: messages waiting for longer are dispatched regardless of the budget (0: none).
+    // Main thread.
+    void SetPriorityBudget(EventPriority priority, double budgetMs, double deadlineMs)
+    {
+        if (priority >= EventPriority::Count) return;
+        PriorityQueue& q = m_queues[static_cast<size_t>(priority)];
+        q.budgetMs = budgetMs;
+        q.deadlineMs = deadlineMs;
+    }
+
+    // Metrics (main thread)
+    const EventPriorityStats& GetPriorityStats(EventPriority priority) const
+    {
+        return m_queues[static_cast<size_t>(priority < EventPriority::Count ? priority : EventPriority::Normal)].stats;
+    }
+    void ResetPriorityStats()
     {
-        std::vector<ListenerEntry> listenersCopy;
+        for (auto& q : m_queues)
         {
-            std::lock_guard<std::mutex> lock(m_listenersMutex);
-            auto it = m_listeners.find(msg.msg_type);
-            if (it != m_listeners.end())
-                listenersCopy = it->second; // copy under lock
+            const size_t backlog = q.stats.backlog;
+            const int starvedFrames = q.stats.starvedFrames;
+            q.stats = EventPriorityStats();
+            q.stats.backlog = backlog;
+            q.stats.starvedFrames = starvedFrames;
         }
-        for (auto& entry : listenersCopy)
+    }
+    void LogPriorityStats() const
+    {
+        for (int p = 0; p < k_EVENT_PRIORITY_COUNT; ++p)
         {
-            if (entry.second)
-                entry.second(msg);
+            const EventPriorityStats& st = m_queues[p].stats;
+            SYSTEM_LOG << "EventManager: " << GetPriorityName(static_cast<EventPriority>(p)) << " priority: "
+                << st.dispatched << " messages, latency avg " << st.GetAverageLatencyMs() << " ms max " << st.maxLatencyMs
+                << " ms, backlog " << st.backlog << " (max " << st.maxBacklog << "), starved frames max " << st.maxStarvedFrames << "\n";
         }
     }
-
-    // Process the queued messages and dispatch them to relevant listeners.
-    void Process()
+    static const char* GetPriorityName(EventPriority priority)
     {
-        std::vector<Message> toDispatch;
+        switch (priority)
         {
-            std::lock_guard<std::mutex> lock(m_queueMutex);
-            while (!m_queue.empty())
-            {
-                toDispatch.push_back(m_queue.front());
-                m_queue.pop();
-            }
+        case EventPriority::Critical: return "Critical";
+        case EventPriority::Normal: return "Normal";
+        case EventPriority::Low: return "Low";
+        default: return "?";
         }
+    }
 
-        for (const auto& msg : toDispatch)
+    // Coalescing rule of a message type (EventType values of the enum only), any thread.
+    // Set by the input managers for their motion events.
+    void SetCoalescing(EventType type, CoalesceMode mode)
+    {
+        if (!IsDense(type)) return;
+        m_coalesceModes[static_cast<size_t>(type)].store(static_cast<uint8_t>(mode), std::memory_order_release);
+    }
+    CoalesceMode GetCoalescing(EventType type) const
+    {
+        if (!IsDense(type)) return CoalesceMode::None;
+        return static_cast<CoalesceMode>(m_coalesceModes[static_cast<size_t>(type)].load(std::memory_order_acquire));
+    }
+    // Same with a payload copied into the payload arena (any thread)
+    void AddMessage(const Message& msg, const void* payload, size_t size)
+    {
+        const uint32_t buffer = m_payloads.BeginWrite();
+        Message m = msg;
+        m.payload = m_payloads.Allocate(buffer, payload, size);
+        if (!m.payload.IsValid() && !m_payloadWarned.exchange(true))
         {
-            DispatchImmediate(msg);
+            SYSTEM_LOG << "EventManager: payload arena full (" << MessageArena::k_BUFFER_SIZE << " bytes per frame), payload of " << size << " bytes dropped\n";
         }
+        AddMessage(m);
+        m_payloads.EndWrite(buffer); // the message is queued: Process() can swap the arena
+    }
+    void AddMessage(const Message& msg, const std::string& payload)
+    {
+        AddMessage(msg, payload.data(), payload.size());
+    }
+
+    // Payload of a message being dispatched by Process(). nullptr if none; '\0' terminated.
+    const char* GetPayload(const Message& msg, size_t& outSize) const
+    {
+        return m_payloads.GetData(msg.payload, outSize);
+    }
+    std::string GetPayloadString(const Message& msg) const
+    {
+        size_t size;
+        const char* data = GetPayload(msg, size);
+        return data ? std::string(data, size) : std::string();
+    }
+
+    // Typed channel of an event struct (same as EventChannel<T>::Get())
+    template<typename T>
+    static EventChannel<T>& Channel() { return EventChannel<T>::Get(); }
+
+    // Immediately dispatch a message to registered listeners (no queue).
+    // Batch listeners get a span of one message.
+    void DispatchImmediate(const Message& msg)
+    {
+        DispatchListeners(msg);
+        if (!IsDense(msg.msg_type)) return;
+        const BatchListenerSnapshot batchListeners = std::atomic_load(&m_batchListeners[static_cast<size_t>(msg.msg_type)]);
+        if (batchListeners) DispatchBatch(*batchListeners, MessageSpan(&msg, 1));
+    }
+
+    // Process the queued messages and dispatch them to relevant listeners (main thread only).
+    // Messages posted while dispatching wait for the next Process(); a Process() called by a
+    // listener returns without dispatching.
+    void Process()
+    {
+        if (m_processing) return;
+        m_processing = true;
+        EventChannelBase::FlushAll();
+
+        // Payload arena: new payloads go to the other buffer, the messages referencing this
+        // one are all claimed in the rings before their current push count (Drain() waits for
+        // the producers still writing them). Reset after the dispatch, the payloads of the
+        // carried over messages are copied first.
+        const uint32_t payloadBuffer = m_payloads.Swap();
+        for (auto& q : m_queues) Drain(q);
+        DrainCoalesced();
+
+        for (auto& q : m_queues) DispatchPending(q);
+        if (m_batchListenerCount.load(std::memory_order_acquire) > 0) DispatchBatches(m_dispatched, m_batchScratch);
+        m_dispatched.clear(); // keeps the capacity
+
+        for (int p = 0; p < k_EVENT_PRIORITY_COUNT; ++p) CarryOver(static_cast<EventPriority>(p), payloadBuffer);
+        m_payloads.Reset(payloadBuffer);
+        m_processing = false;
     }
 
     // Register a generic callback for a specific event type. Owner is used to allow unregistering later.
@@ -90,8 +325,72 @@ public:
     {
         if (!callback) return;
         std::lock_guard<std::mutex> lock(m_listenersMutex);
-        auto& vec = m_listeners[type];
-        vec.emplace_back(owner, std::move(callback));
+        const ListenerSnapshot current = GetListeners(type);
+        ListenerList list = current ? *current : ListenerList();
+        list.push_back({ owner, std::move(callback), std::make_shared<std::atomic<bool>>(true) });
+        PublishListeners(type, std::move(list));
+    }
+
+    // Register a callback receiving all the messages of a type queued in a frame at once
+    // (EventType values of the enum only: queued engine messages)
+    void RegisterBatch(void* owner, EventType type, BatchListener callback)
+    {
+        if (!callback) return;
+        if (!IsDense(type))
+        {
+            SYSTEM_LOG << "EventManager: RegisterBatch: event type " << static_cast<int>(type) << " cannot be batched\n";
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_listenersMutex);
+        BatchListenerSnapshot& slot = m_batchListeners[static_cast<size_t>(type)];
+        const BatchListenerSnapshot current = std::atomic_load(&slot);
+        BatchListenerList list = current ? *current : BatchListenerList();
+        list.push_back({ owner, std::move(callback), std::make_shared<std::atomic<bool>>(true) });
+        std::atomic_store(&slot, BatchListenerSnapshot(std::make_shared<const BatchListenerList>(std::move(list))));
+        m_batchListenerCount.fetch_add(1, std::memory_order_release);
+    }
+
+    // Register a callback for the messages of a type whose route(msg) == key
+    // (EventType values of the enum only)
+    void RegisterRouted(void* owner, EventType type, RouteKeyFunction route, uint64_t key, Listener callback)
+    {
+        if (!callback || !route) return;
+        if (!IsDense(type))
+        {
+            SYSTEM_LOG << "EventManager: RegisterRouted: event type " << static_cast<int>(type) << " cannot be routed\n";
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_listenersMutex);
+        std::shared_ptr<const RoutedListeners>& slot = m_routedListeners[static_cast<size_t>(type)];
+        const std::shared_ptr<const RoutedListeners> current = std::atomic_load(&slot);
+        auto table = current ? std::make_shared<RoutedListeners>(*current) : std::make_shared<RoutedListeners>();
+        table->Add(route, key, { owner, std::move(callback), std::make_shared<std::atomic<bool>>(true) });
+        std::atomic_store(&slot, std::shared_ptr<const RoutedListeners>(std::move(table)));
+        m_routedListenerCount.fetch_add(1, std::memory_order_release);
+    }
+
+    // Routing keys: messages targeting an object (Message::targetUid), from a device (Message::deviceId)
+    static uint64_t RouteByTargetUid(const Message& msg) { return msg.targetUid; }
+    static uint64_t RouteByDevice(const Message& msg) { return GetDeviceRouteKey(msg.deviceId); }
+
+    void RegisterForTarget(void* owner, EventType type, uint64_t targetUid, Listener callback)
+    {
+        RegisterRouted(owner, type, &RouteByTargetUid, targetUid, std::move(callback));
+    }
+    void RegisterForDevice(void* owner, EventType type, int deviceId, Listener callback)
+    {
+        RegisterRouted(owner, type, &RouteByDevice, GetDeviceRouteKey(deviceId), std::move(callback));
+    }
+    // Convenience overloads using the virtual OnEvent method
+    void RegisterForTarget(Object* obj, EventType type, uint64_t targetUid)
+    {
+        if (!obj) return;
+        RegisterForTarget(static_cast<void*>(obj), type, targetUid, [obj](const Message& msg) { obj->OnEvent(msg); });
+    }
+    void RegisterForDevice(Object* obj, EventType type, int deviceId)
+    {
+        if (!obj) return;
+        RegisterForDevice(static_cast<void*>(obj), type, deviceId, [obj](const Message& msg) { obj->OnEvent(msg); });
     }
 
     // Convenience overload: register an Object* using its virtual OnEvent method
@@ -108,28 +407,30 @@ public:
     //    Register(static_cast<void*>(singleton), type, [singleton](const Message& msg) { singleton->OnEvent(msg); });
     //}
 
-    // Unregister a specific owner from a specific event type
+    // Unregister a specific owner from a specific event type (listeners, batch and routed listeners)
     void Unregister(void* owner, EventType type)
     {
         std::lock_guard<std::mutex> lock(m_listenersMutex);
-        auto it = m_listeners.find(type);
-        if (it == m_listeners.end()) return;
-        auto& vec = it->second;
-        vec.erase(std::remove_if(vec.begin(), vec.end(), [owner](const ListenerEntry& e) { return e.first == owner; }), vec.end());
-        if (vec.empty()) m_listeners.erase(it);
+        RemoveListeners(owner, type);
+        RemoveBatchListeners(owner, type);
+        RemoveRoutedListeners(owner, type);
     }
 
-    // Unregister owner from all event types
+    // Unregister owner from all event types (and typed channels)
     void UnregisterAll(void* owner)
     {
+        EventChannelBase::UnsubscribeAll(owner);
         std::lock_guard<std::mutex> lock(m_listenersMutex);
-        for (auto it = m_listeners.begin(); it != m_listeners.end(); )
+        for (int t = 0; t < k_DENSE_EVENT_TYPES; ++t)
         {
-            auto& vec = it->second;
-            vec.erase(std::remove_if(vec.begin(), vec.end(), [owner](const ListenerEntry& e) { return e.first == owner; }), vec.end());
-            if (vec.empty()) it = m_listeners.erase(it);
-            else ++it;
+            RemoveListeners(owner, static_cast<EventType>(t));
+            RemoveBatchListeners(owner, static_cast<EventType>(t));
+            RemoveRoutedListeners(owner, static_cast<EventType>(t));
         }
+        const std::shared_ptr<const SparseListeners> sparse = std::atomic_load(&m_sparseListeners);
+        std::vector<int> types;
+        for (const auto& kv : *sparse) types.push_back(kv.first);
+        for (int t : types) RemoveListeners(owner, static_cast<EventType>(t));
     }
 
     // Send a message to a single target directly (convenience forwarding to target's OnEvent)
@@ -140,9 +441,367 @@ public:
     }
 
 private:
-    std::unordered_map<EventType, std::vector<ListenerEntry>> m_listeners;
-    std::mutex m_listenersMutex;
+    static const int k_DENSE_EVENT_TYPES = static_cast<int>(EventType::Olympe_EventType_MAX);
+    using SparseListeners = std::unordered_map<int, ListenerSnapshot>;
+
+    static bool IsDense(EventType type)
+    {
+        return static_cast<int>(type) >= 0 && static_cast<int>(type) < k_DENSE_EVENT_TYPES;
+    }
+
+    // Lock-free (atomic shared_ptr loads)
+    ListenerSnapshot GetListeners(EventType type) const
+    {
+        if (IsDense(type)) return std::atomic_load(&m_listeners[static_cast<size_t>(type)]);
+        const std::shared_ptr<const SparseListeners> sparse = std::atomic_load(&m_sparseListeners);
+        auto it = sparse->find(static_cast<int>(type));
+        return (it != sparse->end()) ? it->second : ListenerSnapshot();
+    }
+
+    // Writers, expect m_listenersMutex locked
+    void PublishListeners(EventType type, ListenerList&& list)
+    {
+        ListenerSnapshot snapshot = list.empty() ? ListenerSnapshot() : std::make_shared<const ListenerList>(std::move(list));
+        if (IsDense(type))
+        {
+            std::atomic_store(&m_listeners[static_cast<size_t>(type)], std::move(snapshot));
+            return;
+        }
+        auto sparse = std::make_shared<SparseListeners>(*std::atomic_load(&m_sparseListeners));
+        if (snapshot) (*sparse)[static_cast<int>(type)] = std::move(snapshot);
+        else sparse->erase(static_cast<int>(type));
+        std::atomic_store(&m_sparseListeners, std::shared_ptr<const SparseListeners>(std::move(sparse)));
+    }
+
+    void RemoveListeners(void* owner, EventType type)
+    {
+        const ListenerSnapshot current = GetListeners(type);
+        if (!current) return;
+        ListenerList list;
+        for (const auto& e : *current)
+        {
+            if (e.owner == owner) e.active->store(false, std::memory_order_release); // skipped by dispatches in progress
+            else list.push_back(e);
+        }
+        if (list.size() != current->size()) PublishListeners(type, std::move(list));
+    }
+
+    void RemoveBatchListeners(void* owner, EventType type)
+    {
+        if (!IsDense(type)) return;
+        BatchListenerSnapshot& slot = m_batchListeners[static_cast<size_t>(type)];
+        const BatchListenerSnapshot current = std::atomic_load(&slot);
+        if (!current) return;
+        BatchListenerList list;
+        for (const auto& e : *current)
+        {
+            if (e.owner == owner) e.active->store(false, std::memory_order_release);
+            else list.push_back(e);
+        }
+        if (list.size() == current->size()) return;
+        m_batchListenerCount.fetch_sub(static_cast<int>(current->size() - list.size()), std::memory_order_release);
+        std::atomic_store(&slot, list.empty() ? BatchListenerSnapshot() : BatchListenerSnapshot(std::make_shared<const BatchListenerList>(std::move(list))));
+    }
+
+    void RemoveRoutedListeners(void* owner, EventType type)
+    {
+        if (!IsDense(type)) return;
+        std::shared_ptr<const RoutedListeners>& slot = m_routedListeners[static_cast<size_t>(type)];
+        const std::shared_ptr<const RoutedListeners> current = std::atomic_load(&slot);
+        if (!current) return;
+        auto table = std::make_shared<RoutedListeners>(*current);
+        const size_t removed = table->Remove(owner);
+        if (removed == 0) return;
+        m_routedListenerCount.fetch_sub(static_cast<int>(removed), std::memory_order_release);
+        std::atomic_store(&slot, table->IsEmpty() ? std::shared_ptr<const RoutedListeners>() : std::shared_ptr<const RoutedListeners>(std::move(table)));
+    }
+
+    void DispatchListeners(const Message& msg)
+    {
+        const ListenerSnapshot listeners = GetListeners(msg.msg_type); // keeps the list alive while dispatching
+        if (listeners)
+        {
+            for (const auto& entry : *listeners)
+            {
+                if (entry.active->load(std::memory_order_acquire))
+                    entry.callback(msg);
+            }
+        }
+        if (m_routedListenerCount.load(std::memory_order_acquire) == 0 || !IsDense(msg.msg_type)) return;
+        const std::shared_ptr<const RoutedListeners> routed = std::atomic_load(&m_routedListeners[static_cast<size_t>(msg.msg_type)]);
+        if (routed) routed->ForEach(msg, [&msg](const ListenerEntry& entry) { entry.callback(msg); });
+    }
+
+    static void DispatchBatch(const BatchListenerList& listeners, const MessageSpan& messages)
+    {
+        for (const auto& entry : listeners)
+        {
+            if (entry.active->load(std::memory_order_acquire))
+                entry.callback(messages);
+        }
+    }
+
+    // Scratch of DispatchBatches(), keeps its capacity from frame to frame
+    struct BatchScratch
+    {
+        std::array<uint32_t, k_DENSE_EVENT_TYPES> counts{};            // then start offsets
+        std::array<int8_t, k_DENSE_EVENT_TYPES> batched{};             // 0 not seen yet, 1 yes, -1 no
+        std::array<BatchListenerSnapshot, k_DENSE_EVENT_TYPES> listeners; // of the types in 'order'
+        std::vector<int> order;                                        // batched types, by first message
+        std::vector<int> skipped;                                      // seen types without batch listener
+        std::vector<Message> sorted;                                   // messages grouped by type
+    };
+
+    // Stable counting sort of the batched messages by type, then one call per type
+    void DispatchBatches(const std::vector<Message>& messages, BatchScratch& scratch)
+    {
+        for (const auto& m : messages)
+        {
+            if (!IsDense(m.msg_type)) continue;
+            const int t = static_cast<int>(m.msg_type);
+            if (scratch.batched[t] == 0)
+            {
+                scratch.listeners[t] = std::atomic_load(&m_batchListeners[t]);
+                scratch.batched[t] = scratch.listeners[t] ? 1 : -1;
+                (scratch.listeners[t] ? scratch.order : scratch.skipped).push_back(t);
+            }
+            if (scratch.batched[t] > 0) ++scratch.counts[t];
+        }
+        for (int t : scratch.skipped) scratch.batched[t] = 0;
+        scratch.skipped.clear();
+        if (scratch.order.empty()) return;
+
+        uint32_t total = 0;
+        for (int t : scratch.order)
+        {
+            const uint32_t count = scratch.counts[t];
+            scratch.counts[t] = total;
+            total += count;
+        }
+        scratch.sorted.resize(total);
+        for (const auto& m : messages)
+        {
+            if (!IsDense(m.msg_type)) continue;
+            const int t = static_cast<int>(m.msg_type);
+            if (scratch.batched[t] > 0) scratch.sorted[scratch.counts[t]++] = m;
+        }
+
+        uint32_t begin = 0;
+        for (int t : scratch.order)
+        {
+            const uint32_t end = scratch.counts[t]; // start offset + count after the scatter
+            DispatchBatch(*scratch.listeners[t], MessageSpan(scratch.sorted.data() + begin, end - begin));
+            begin = end;
+            scratch.counts[t] = 0;
+            scratch.batched[t] = 0;
+            scratch.listeners[t].reset();
+        }
+        scratch.order.clear();
+        scratch.sorted.clear();
+    }
+
+    std::array<ListenerSnapshot, k_DENSE_EVENT_TYPES> m_listeners;
+    std::shared_ptr<const SparseListeners> m_sparseListeners; // never null
+    std::array<BatchListenerSnapshot, k_DENSE_EVENT_TYPES> m_batchListeners;
+    std::atomic<int> m_batchListenerCount{ 0 }; // Process() skips the grouping when 0
+    std::array<std::shared_ptr<const RoutedListeners>, k_DENSE_EVENT_TYPES> m_routedListeners;
+    std::atomic<int> m_routedListenerCount{ 0 };
+    std::mutex m_listenersMutex; // serializes the writers
+    BatchScratch m_batchScratch;
+
+    using Clock = std::chrono::steady_clock;
+    static double ToMs(Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); }
+
+    struct QueuedMessage
+    {
+        Message msg;
+        Clock::time_point postTime;
+        uint64_t sequence; // post order, positions the coalesced messages among the queued ones
+    };
+
+    struct PriorityQueue
+    {
+        PriorityQueue() : ring(k_EVENT_QUEUE_CAPACITY) {}
+
+        MPSCQueue<QueuedMessage> ring;
+        std::vector<QueuedMessage> overflow;
+        std::mutex overflowMutex;
+        std::atomic<bool> hasOverflow{ false };
+        bool overflowWarned = false;
+
+        // main thread: drained messages, [head, end) not dispatched yet
+        std::vector<QueuedMessage> pending;
+        size_t head = 0;
+        double budgetMs = 0.0;
+        double deadlineMs = 0.0;
+        EventPriorityStats stats;
+    };
+
+    void SetDefaultPriorities()
+    {
+        for (auto& p : m_priorities) p.store(static_cast<uint8_t>(EventPriority::Normal), std::memory_order_relaxed);
+        for (int t = static_cast<int>(EventType::Olympe_EventType_Joystick_AxisMotion); t <= static_cast<int>(EventType::Olympe_EventType_Mouse_Disconnected); ++t)
+            SetPriority(static_cast<EventType>(t), EventPriority::Critical); // inputs
+        for (int t = static_cast<int>(EventType::Olympe_EventType_Object_CollideEvent); t <= static_cast<int>(EventType::Olympe_EventType_Object_CollideDeathZone); ++t)
+            SetPriority(static_cast<EventType>(t), EventPriority::Critical); // collisions
+        SetPriority(EventType::EventType_Hit, EventPriority::Critical);
+        SetPriority(EventType::Olympe_EventType_Game_Pause, EventPriority::Critical);
+        SetPriority(EventType::Olympe_EventType_Game_Resume, EventPriority::Critical);
+        SetPriority(EventType::Olympe_EventType_Game_Quit, EventPriority::Critical);
+        SetPriority(EventType::Olympe_EventType_SectorToActivate, EventPriority::Low);
+        SetPriority(EventType::Olympe_EventType_SectorToDeactivate, EventPriority::Low);
+        SetPriority(EventType::Olympe_EventType_Resource_Reloaded, EventPriority::Low);
+
+        SetPriorityBudget(EventPriority::Critical, 0.0, 0.0);
+        SetPriorityBudget(EventPriority::Normal, 4.0, 100.0);
+        SetPriorityBudget(EventPriority::Low, 1.0, 1000.0);
+    }
+
+    void AddOverflow(PriorityQueue& q, const QueuedMessage& qm)
+    {
+        std::lock_guard<std::mutex> lock(q.overflowMutex);
+        if (!q.overflowWarned)
+        {
+            q.overflowWarned = true;
+            SYSTEM_LOG << "EventManager: message queue full (" << q.ring.GetCapacity() << " messages), using the overflow list\n";
+        }
+        q.overflow.push_back(qm);
+        q.hasOverflow.store(true, std::memory_order_release);
+    }
+
+    void Drain(PriorityQueue& q)
+    {
+        QueuedMessage qm;
+        const size_t end = q.ring.GetPushCount();
+        while (q.ring.GetPopCount() < end)
+        {
+            if (q.ring.TryPop(qm)) q.pending.push_back(qm);
+            else std::this_thread::yield();
+        }
+        if (q.hasOverflow.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(q.overflowMutex);
+            q.pending.insert(q.pending.end(), q.overflow.begin(), q.overflow.end());
+            q.overflow.clear();
+            q.hasOverflow.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    void DispatchPending(PriorityQueue& q)
+    {
+        const Clock::time_point start = Clock::now();
+        Clock::time_point now = start;
+        size_t count = 0;
+        while (q.head < q.pending.size())
+        {
+            const QueuedMessage qm = q.pending[q.head];
+            if (q.budgetMs > 0.0 && count > 0) // at least one message per frame
+            {
+                now = Clock::now();
+                const bool overBudget = ToMs(now - start) >= q.budgetMs;
+                const bool pastDeadline = q.deadlineMs > 0.0 && ToMs(now - qm.postTime) >= q.deadlineMs;
+                if (overBudget && !pastDeadline) break;
+            }
+            ++q.head;
+            ++count;
+
+            const double latencyMs = ToMs(now - qm.postTime);
+            q.stats.totalLatencyMs += latencyMs;
+            q.stats.maxLatencyMs = (std::max)(q.stats.maxLatencyMs, latencyMs);
+            m_dispatched.push_back(qm.msg);
+            DispatchListeners(qm.msg);
+        }
+        q.stats.dispatched += count;
+        q.stats.lastFrameMs = ToMs(Clock::now() - start);
+    }
+
+    // The messages left wait for the next frame; their payloads move to the current arena buffer
+    void CarryOver(EventPriority priority, uint32_t payloadBuffer)
+    {
+        PriorityQueue& q = m_queues[static_cast<size_t>(priority)];
+        q.pending.erase(q.pending.begin(), q.pending.begin() + q.head);
+        q.head = 0;
+        for (QueuedMessage& qm : q.pending)
+        {
+            if (!qm.msg.payload.IsValid() || MessageArena::GetBuffer(qm.msg.payload) != payloadBuffer) continue;
+            size_t size;
+            const char* data = m_payloads.GetData(qm.msg.payload, size);
+            const uint32_t buffer = m_payloads.BeginWrite();
+            qm.msg.payload = m_payloads.Allocate(buffer, data, size);
+            m_payloads.EndWrite(buffer);
+        }
+
+        EventPriorityStats& st = q.stats;
+        st.backlog = q.pending.size();
+        st.maxBacklog = (std::max)(st.maxBacklog, st.backlog);
+        st.starvedFrames = st.backlog ? st.starvedFrames + 1 : 0;
+        st.maxStarvedFrames = (std::max)(st.maxStarvedFrames, st.starvedFrames);
+        if (st.starvedFrames == k_STARVATION_WARNING_FRAMES)
+        {
+            SYSTEM_LOG << "EventManager: " << GetPriorityName(priority) << " priority messages carried over for " << st.starvedFrames
+                << " frames (backlog " << st.backlog << "), raise its budget or lower the posting rate\n";
+        }
+    }
+
+    // by value: the rings have cache line aligned members, a plain new would not honor their
+    // alignment before C++17 (the singleton's static storage does)
+    std::array<PriorityQueue, k_EVENT_PRIORITY_COUNT> m_queues;
+    std::array<std::atomic<uint8_t>, k_DENSE_EVENT_TYPES> m_priorities; // EventPriority per type
+    std::vector<Message> m_dispatched; // this frame, for the batch listeners
+    bool m_processing = false;
+
+    // Linear search: one entry per (type, device, control) posted this frame, a handful.
+    // The merged entry keeps the post time (latency metrics) and the sequence (dispatch
+    // position) of the first message.
+    void Coalesce(const Message& msg)
+    {
+        std::lock_guard<std::mutex> lock(m_coalesceMutex);
+        for (QueuedMessage& entry : m_coalesced)
+        {
+            Message& pending = entry.msg;
+            if (pending.msg_type != msg.msg_type || pending.deviceId != msg.deviceId || pending.controlId != msg.controlId) continue;
+            if (GetCoalescing(msg.msg_type) == CoalesceMode::Accumulate)
+            {
+                const float param1 = pending.param1 + msg.param1;
+                const float param2 = pending.param2 + msg.param2;
+                pending = msg;
+                pending.param1 = param1;
+                pending.param2 = param2;
+            }
+            else pending = msg;
+            return;
+        }
+        QueuedMessage qm;
+        qm.msg = msg;
+        qm.postTime = Clock::now();
+        qm.sequence = m_postSequence.fetch_add(1, std::memory_order_relaxed);
+        m_coalesced.push_back(qm);
+        m_hasCoalesced.store(true, std::memory_order_release);
+    }
+
+    // Among the drained messages of their priority, before the first one posted after them
+    // (searched from the end: the coalesced messages are usually among the last posted)
+    void DrainCoalesced()
+    {
+        if (!m_hasCoalesced.load(std::memory_order_acquire)) return;
+        std::lock_guard<std::mutex> lock(m_coalesceMutex);
+        for (const QueuedMessage& qm : m_coalesced)
+        {
+            PriorityQueue& q = m_queues[static_cast<size_t>(GetPriority(qm.msg.msg_type))];
+            size_t pos = q.pending.size();
+            while (pos > q.head && q.pending[pos - 1].sequence > qm.sequence) --pos;
+            q.pending.insert(q.pending.begin() + pos, qm);
+        }
+        m_coalesced.clear();
+        m_hasCoalesced.store(false, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<uint8_t>, k_DENSE_EVENT_TYPES> m_coalesceModes; // CoalesceMode per type
+    std::vector<QueuedMessage> m_coalesced; // this frame, merged into the pending lists by DrainCoalesced()
+    std::atomic<uint64_t> m_postSequence{ 0 };
+    std::mutex m_coalesceMutex;
+    std::atomic<bool> m_hasCoalesced{ false };
 
-    std::queue<Message> m_queue;
-    std::mutex m_queueMutex;
+    MessageArena m_payloads;
+    std::atomic<bool> m_payloadWarned{ false };
 };
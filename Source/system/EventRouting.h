@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+
+// RouteTable: routed subscribers of an event type (EventManager, EventChannel<T>).
+// Inline (header-only) implementation placed in Source/system.
+//
+// A route is a key function of the event (target UID, device id, any user key) and a
+// map key -> subscribers: an event reaches the subscribers of its key in O(1) per route
+// instead of being broadcast to everyone and filtered by each of them. A type has a
+// route per key function used, usually one.
+// Immutable once published (same snapshot scheme as the listener lists): the writers
+// copy the table, modify the copy and publish it. Entry has 'owner' and 'active' fields.
+
+template<typename Event, typename Entry>
+class RouteTable
+{
+public:
+    using KeyFunction = uint64_t (*)(const Event& ev);
+
+    template<typename F>
+    void ForEach(const Event& ev, F&& f) const
+    {
+        for (const Route& r : m_routes)
+        {
+            auto it = r.entries.find(r.keyOf(ev));
+            if (it == r.entries.end()) continue;
+            for (const Entry& e : it->second)
+            {
+                if (e.active->load(std::memory_order_acquire)) f(e);
+            }
+        }
+    }
+
+    void Add(KeyFunction keyOf, uint64_t key, const Entry& entry)
+    {
+        for (Route& r : m_routes)
+        {
+            if (r.keyOf != keyOf) continue;
+            r.entries[key].push_back(entry);
+            return;
+        }
+        m_routes.push_back(Route());
+        m_routes.back().keyOf = keyOf;
+        m_routes.back().entries[key].push_back(entry);
+    }
+
+    // Returns the number of entries removed, their 'active' flag is cleared
+    size_t Remove(void* owner)
+    {
+        size_t removed = 0;
+        for (size_t i = 0; i < m_routes.size();)
+        {
+            auto& entries = m_routes[i].entries;
+            for (auto it = entries.begin(); it != entries.end();)
+            {
+                std::vector<Entry>& list = it->second;
+                for (size_t j = 0; j < list.size();)
+                {
+                    if (list[j].owner != owner) { ++j; continue; }
+                    list[j].active->store(false, std::memory_order_release);
+                    list.erase(list.begin() + j);
+                    ++removed;
+                }
+                it = list.empty() ? entries.erase(it) : std::next(it);
+            }
+            if (entries.empty()) m_routes.erase(m_routes.begin() + i);
+            else ++i;
+        }
+        return removed;
+    }
+
+    bool IsEmpty() const { return m_routes.empty(); }
+
+private:
+    struct Route
+    {
+        KeyFunction keyOf = nullptr;
+        std::unordered_map<uint64_t, std::vector<Entry>> entries;
+    };
+    std::vector<Route> m_routes;
+};
+
+// Key of a device id (keyboard is -1) for the routes by device
+inline uint64_t GetDeviceRouteKey(int deviceId) { return static_cast<uint32_t>(deviceId); }
@@ -0,0 +1,271 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- Implementation of FileWatcher (inotify on Linux, file stamp polling
+  elsewhere).
+*/
+
+#include "FileWatcher.h"
+#include "system_utils.h"
+#include <algorithm>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace
+{
+#if defined(__linux__)
+    const uint32_t k_NOTIFY_MASK = IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE;
+#endif
+
+    std::string DirectoryOf(const std::string& path)
+    {
+        const size_t pos = path.find_last_of('/');
+        if (pos == std::string::npos) return ".";
+        if (pos == 0) return "/";
+        return path.substr(0, pos);
+    }
+}
+
+//-------------------------------------------------------------
+FileWatcher::FileWatcher()
+{
+#if defined(__linux__)
+    m_notifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_notifyFd < 0) SYSTEM_LOG << "FileWatcher: inotify unavailable (errno=" << errno << "), polling modification times\n";
+#endif
+    m_lastPollRound = Clock::now();
+}
+//-------------------------------------------------------------
+FileWatcher::~FileWatcher()
+{
+#if defined(__linux__)
+    if (m_notifyFd >= 0) close(m_notifyFd);
+#endif
+}
+//-------------------------------------------------------------
+std::string FileWatcher::NormalizePath(const std::string& path)
+{
+    std::string p = path;
+    std::replace(p.begin(), p.end(), '\\', '/');
+    while (p.size() > 2 && p[0] == '.' && p[1] == '/') p.erase(0, 2);
+    return p;
+}
+//-------------------------------------------------------------
+int64_t FileWatcher::GetFileStamp(const std::string& path)
+{
+    // the size is mixed in: some file systems only store the modification time in seconds
+#ifdef _WIN32
+    struct _stat64 st;
+    if (_stat64(path.c_str(), &st) != 0) return 0;
+    const int64_t time = static_cast<int64_t>(st.st_mtime);
+#else
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) return 0;
+#if defined(__linux__)
+    const int64_t time = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#else
+    const int64_t time = static_cast<int64_t>(st.st_mtime);
+#endif
+#endif
+    return time * 1000003 + static_cast<int64_t>(st.st_size);
+}
+//-------------------------------------------------------------
+void FileWatcher::Watch(const std::string& path)
+{
+    if (path.empty()) return;
+    const std::string p = NormalizePath(path);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    WatchedFile& file = m_files[p];
+    if (file.refCount++ > 0) return;
+    file.stamp = GetFileStamp(p);
+    m_pollOrderDirty = true;
+
+#if defined(__linux__)
+    if (m_notifyFd < 0) return;
+    const std::string dir = DirectoryOf(p);
+    if (m_dirRefCount[dir]++ > 0) return;
+    const int wd = inotify_add_watch(m_notifyFd, dir.c_str(), k_NOTIFY_MASK);
+    if (wd < 0)
+    {
+        SYSTEM_LOG << "FileWatcher: cannot watch directory '" << dir << "' (errno=" << errno << ")\n";
+        return;
+    }
+    m_dirByWatch[wd] = dir;
+    m_watchByDir[dir] = wd;
+#endif
+}
+//-------------------------------------------------------------
+void FileWatcher::Unwatch(const std::string& path)
+{
+    const std::string p = NormalizePath(path);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_files.find(p);
+    if (it == m_files.end() || --it->second.refCount > 0) return;
+    m_files.erase(it);
+    m_pending.erase(p);
+    m_pollOrderDirty = true;
+
+#if defined(__linux__)
+    if (m_notifyFd < 0) return;
+    const std::string dir = DirectoryOf(p);
+    auto dirIt = m_dirRefCount.find(dir);
+    if (dirIt == m_dirRefCount.end() || --dirIt->second > 0) return;
+    m_dirRefCount.erase(dirIt);
+    auto wdIt = m_watchByDir.find(dir);
+    if (wdIt != m_watchByDir.end())
+    {
+        inotify_rm_watch(m_notifyFd, wdIt->second);
+        m_dirByWatch.erase(wdIt->second);
+        m_watchByDir.erase(wdIt);
+    }
+#endif
+}
+//-------------------------------------------------------------
+void FileWatcher::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+#if defined(__linux__)
+    for (const auto& kv : m_dirByWatch) inotify_rm_watch(m_notifyFd, kv.first);
+#endif
+    m_dirByWatch.clear();
+    m_watchByDir.clear();
+    m_dirRefCount.clear();
+    m_files.clear();
+    m_pending.clear();
+    m_pollOrder.clear();
+    m_pollCursor = 0;
+    m_pollOrderDirty = false;
+}
+//-------------------------------------------------------------
+bool FileWatcher::IsWatched(const std::string& path) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_files.find(NormalizePath(path)) != m_files.end();
+}
+//-------------------------------------------------------------
+size_t FileWatcher::GetWatchedCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_files.size();
+}
+//-------------------------------------------------------------
+void FileWatcher::MarkChanged(const std::string& path, Clock::time_point now)
+{
+    // restarts the debounce delay on every modification
+    m_pending[path] = now;
+}
+//-------------------------------------------------------------
+void FileWatcher::ReadNotifications(Clock::time_point now)
+{
+#if defined(__linux__)
+    alignas(struct inotify_event) char buffer[4096];
+    bool overflow = false;
+    while (true)
+    {
+        const ssize_t len = read(m_notifyFd, buffer, sizeof(buffer));
+        if (len <= 0) break; // EAGAIN: no more events
+
+        for (ssize_t offset = 0; offset < len; )
+        {
+            const struct inotify_event* ev = reinterpret_cast<const struct inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(struct inotify_event) + ev->len);
+
+            if (ev->mask & IN_Q_OVERFLOW) { overflow = true; continue; }
+            if (ev->mask & IN_IGNORED)
+            {
+                // directory removed: its files are reported again if it comes back and they are re-watched
+                auto it = m_dirByWatch.find(ev->wd);
+                if (it != m_dirByWatch.end()) { m_watchByDir.erase(it->second); m_dirByWatch.erase(it); }
+                continue;
+            }
+            if (ev->len == 0) continue;
+            auto dirIt = m_dirByWatch.find(ev->wd);
+            if (dirIt == m_dirByWatch.end()) continue;
+
+            const std::string file = (dirIt->second == ".") ? std::string(ev->name) : dirIt->second + "/" + ev->name;
+            if (m_files.find(file) != m_files.end()) MarkChanged(file, now);
+        }
+    }
+
+    if (overflow)
+    {
+        // events were lost: compare the stamps of every watched file
+        for (auto& kv : m_files)
+        {
+            const int64_t t = GetFileStamp(kv.first);
+            if (t != kv.second.stamp) { kv.second.stamp = t; MarkChanged(kv.first, now); }
+        }
+    }
+#else
+    (void)now;
+#endif
+}
+//-------------------------------------------------------------
+void FileWatcher::PollFileStamps(Clock::time_point now)
+{
+    if (m_pollOrderDirty)
+    {
+        m_pollOrder.clear();
+        m_pollOrder.reserve(m_files.size());
+        for (const auto& kv : m_files) m_pollOrder.push_back(kv.first);
+        m_pollCursor = 0;
+        m_pollOrderDirty = false;
+    }
+    if (m_pollOrder.empty()) return;
+
+    // a new round starts once the interval elapsed, then it goes on a slice per call
+    if (m_pollCursor == 0 && now - m_lastPollRound < std::chrono::milliseconds(m_pollIntervalMs)) return;
+
+    const size_t end = std::min(m_pollOrder.size(), m_pollCursor + m_pollBatchSize);
+    for (; m_pollCursor < end; ++m_pollCursor)
+    {
+        const std::string& path = m_pollOrder[m_pollCursor];
+        auto it = m_files.find(path);
+        if (it == m_files.end()) continue;
+        const int64_t t = GetFileStamp(path);
+        if (t != it->second.stamp)
+        {
+            it->second.stamp = t;
+            MarkChanged(path, now);
+        }
+    }
+    if (m_pollCursor >= m_pollOrder.size())
+    {
+        m_pollCursor = 0;
+        m_lastPollRound = now;
+    }
+}
+//-------------------------------------------------------------
+void FileWatcher::Poll(std::vector<std::string>& outChanged)
+{
+    const Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_notifyFd >= 0) ReadNotifications(now);
+    else PollFileStamps(now);
+
+    const auto debounce = std::chrono::milliseconds(m_debounceMs);
+    for (auto it = m_pending.begin(); it != m_pending.end(); )
+    {
+        if (now - it->second < debounce) { ++it; continue; }
+        auto file = m_files.find(it->first);
+        if (file != m_files.end())
+        {
+            // keeps the overflow / polling comparisons in sync with what was reported
+            file->second.stamp = GetFileStamp(it->first);
+            outChanged.push_back(it->first);
+        }
+        it = m_pending.erase(it);
+    }
+}
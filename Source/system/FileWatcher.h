@@ -0,0 +1,93 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- FileWatcher reports modifications of a set of files (hot reload of
+  assets and data files). DataManager watches the paths of its loaded
+  resources and reloads only the files that changed.
+
+Notes:
+- Linux: inotify on the parent directories of the watched files (one watch
+  per directory), events are read without blocking in Poll().
+- Other platforms (or if inotify is unavailable): polling of the file
+  modification times and sizes, a slice of the files per Poll() call so that
+  thousands of watched files cost a bounded time per frame.
+- Changes are debounced: a file is reported once, when no new modification
+  happened for the debounce delay (editors often write a file in several
+  steps, or save it twice).
+- Paths are normalized ('\' -> '/', leading "./" removed) so that the same
+  file watched with different spellings is reported once.
+- Thread-safe: Watch/Unwatch can be called from any thread, Poll() is
+  meant to be called once per frame from the main thread.
+*/
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+
+class FileWatcher
+{
+public:
+    FileWatcher();
+    ~FileWatcher();
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    void Watch(const std::string& path);
+    void Unwatch(const std::string& path);
+    void Clear();
+    bool IsWatched(const std::string& path) const;
+    size_t GetWatchedCount() const;
+
+    // Appends the files modified since the last call (normalized paths), once their debounce delay elapsed
+    void Poll(std::vector<std::string>& outChanged);
+
+    void SetDebounceMs(uint32_t ms) { m_debounceMs = ms; }
+    uint32_t GetDebounceMs() const { return m_debounceMs; }
+    // Polling fallback: delay between two checks of the same file, and files checked per Poll() at most
+    void SetPollIntervalMs(uint32_t ms) { m_pollIntervalMs = ms; }
+    void SetPollBatchSize(size_t n) { m_pollBatchSize = n ? n : 1; }
+    bool IsUsingNotifications() const { return m_notifyFd >= 0; }
+
+    static std::string NormalizePath(const std::string& path);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct WatchedFile
+    {
+        int64_t stamp = 0;        // last known modification time and size (polling, lost events)
+        uint32_t refCount = 0;    // Watch() calls
+    };
+
+    static int64_t GetFileStamp(const std::string& path);
+    void MarkChanged(const std::string& path, Clock::time_point now); // expects m_mutex locked
+    void ReadNotifications(Clock::time_point now);                   // expects m_mutex locked
+    void PollFileStamps(Clock::time_point now);                       // expects m_mutex locked
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, WatchedFile> m_files;
+    std::unordered_map<std::string, Clock::time_point> m_pending; // changed file -> last modification seen
+
+    // inotify (Linux)
+    int m_notifyFd = -1;
+    std::unordered_map<int, std::string> m_dirByWatch;        // watch descriptor -> directory
+    std::unordered_map<std::string, int> m_watchByDir;        // directory -> watch descriptor
+    std::unordered_map<std::string, uint32_t> m_dirRefCount;  // watched files per directory
+
+    // polling fallback
+    std::vector<std::string> m_pollOrder;
+    size_t m_pollCursor = 0;
+    bool m_pollOrderDirty = false;
+    Clock::time_point m_lastPollRound;
+
+    uint32_t m_debounceMs = 250;
+    uint32_t m_pollIntervalMs = 500;
+    size_t m_pollBatchSize = 256;
+};
@@ -0,0 +1,180 @@
+#include "JobSystem.h"
+#include "system_utils.h"
+#include <algorithm>
+#include <memory>
+
+namespace
+{
+    thread_local bool t_isJobWorker = false;
+}
+
+//-------------------------------------------------------------
+JobSystem::JobSystem()
+{
+    name = "JobSystem";
+    SYSTEM_LOG << "JobSystem created\n";
+}
+//-------------------------------------------------------------
+JobSystem::~JobSystem()
+{
+    Shutdown();
+    SYSTEM_LOG << "JobSystem destroyed\n";
+}
+//-------------------------------------------------------------
+JobSystem& JobSystem::GetInstance()
+{
+    static JobSystem instance;
+    return instance;
+}
+//-------------------------------------------------------------
+void JobSystem::Initialize(unsigned workerCount)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_running) return;
+
+    if (workerCount == 0)
+    {
+        unsigned hw = std::thread::hardware_concurrency();
+        workerCount = (hw > 1) ? hw - 1 : 1;
+    }
+
+    m_running = true;
+    m_workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i)
+    {
+        m_workers.emplace_back(&JobSystem::WorkerLoop, this);
+    }
+    SYSTEM_LOG << "JobSystem Initialized with " << workerCount << " worker threads\n";
+}
+//-------------------------------------------------------------
+void JobSystem::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) return;
+        m_running = false;
+        for (auto& q : m_queues) q.clear();
+    }
+    m_cv.notify_all();
+    for (auto& t : m_workers)
+    {
+        if (t.joinable()) t.join();
+    }
+    m_workers.clear();
+    SYSTEM_LOG << "JobSystem Shutdown\n";
+}
+//-------------------------------------------------------------
+void JobSystem::Submit(Job job, JobPriority priority)
+{
+    if (!job) return;
+    if (!m_running) Initialize();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queues[static_cast<size_t>(priority)].push_back(std::move(job));
+    }
+    m_cv.notify_one();
+}
+//-------------------------------------------------------------
+size_t JobSystem::GetPendingJobCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t n = 0;
+    for (const auto& q : m_queues) n += q.size();
+    return n;
+}
+//-------------------------------------------------------------
+bool JobSystem::IsWorkerThread()
+{
+    return t_isJobWorker;
+}
+//-------------------------------------------------------------
+bool JobSystem::PopJob(Job& outJob)
+{
+    for (auto& q : m_queues)
+    {
+        if (!q.empty())
+        {
+            outJob = std::move(q.front());
+            q.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+//-------------------------------------------------------------
+void JobSystem::WorkerLoop()
+{
+    t_isJobWorker = true;
+    while (true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() {
+                if (!m_running) return true;
+                for (const auto& q : m_queues) if (!q.empty()) return true;
+                return false;
+            });
+            if (!m_running) return;
+            if (!PopJob(job)) continue;
+        }
+
+        try
+        {
+            job();
+        }
+        catch (const std::exception& e)
+        {
+            SYSTEM_LOG << "JobSystem: job threw exception: " << e.what() << "\n";
+        }
+    }
+}
+//-------------------------------------------------------------
+void JobSystem::ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn)
+{
+    if (count == 0 || !fn) return;
+    if (grain == 0) grain = 1;
+    if (!m_running) Initialize();
+
+    const size_t chunks = (count + grain - 1) / grain;
+    if (chunks == 1 || m_workers.empty())
+    {
+        fn(0, count);
+        return;
+    }
+
+    // shared between the caller and helper jobs (helpers may outlive the call if they start late)
+    struct SharedState
+    {
+        std::atomic<size_t> next{ 0 };
+        std::atomic<size_t> done{ 0 };
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+    auto state = std::make_shared<SharedState>();
+    const std::function<void(size_t, size_t)>* body = &fn;
+
+    auto runChunks = [state, body, count, grain, chunks]()
+    {
+        size_t c;
+        while ((c = state->next.fetch_add(1)) < chunks)
+        {
+            const size_t begin = c * grain;
+            const size_t end = std::min(count, begin + grain);
+            (*body)(begin, end);
+            if (state->done.fetch_add(1) + 1 == chunks)
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->cv.notify_all();
+            }
+        }
+    };
+
+    const size_t helpers = std::min(chunks - 1, m_workers.size());
+    for (size_t i = 0; i < helpers; ++i) Submit(runChunks, JobPriority::High);
+
+    runChunks();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [&state, chunks]() { return state->done.load() == chunks; });
+}
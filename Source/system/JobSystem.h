@@ -0,0 +1,81 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- JobSystem is a singleton owning a small pool of worker threads used by
+  engine services that must not stall the frame loop (pathfinding, asset
+  decoding, etc.).
+- Jobs are plain std::function<void()> pushed into per-priority FIFO queues.
+  Workers always pick the highest priority job available.
+- ParallelFor splits a range in chunks processed by the workers AND the
+  calling thread, and returns once every chunk is done.
+
+Notes:
+- The pool is lazily started on first use (Initialize() may be called
+  explicitly to choose the worker count). Shutdown() drains nothing: pending
+  jobs are discarded and the workers joined.
+- Jobs must not touch SDL rendering objects (renderer/textures): those stay
+  on the main thread.
+*/
+#pragma once
+
+#include "../object.h"
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <array>
+
+enum class JobPriority : int
+{
+    High = 0,
+    Normal,
+    Low,
+    Count
+};
+
+class JobSystem : public Object
+{
+public:
+    using Job = std::function<void()>;
+
+    JobSystem();
+    virtual ~JobSystem();
+
+    virtual ObjectType GetObjectType() const override { return ObjectType::Singleton; }
+
+    static JobSystem& GetInstance();
+    static JobSystem& Get() { return GetInstance(); }
+
+    // Start the workers. workerCount == 0 uses (hardware threads - 1), at least 1.
+    void Initialize(unsigned workerCount = 0);
+    void Shutdown();
+
+    // Queue a job for asynchronous execution
+    void Submit(Job job, JobPriority priority = JobPriority::Normal);
+
+    // Run fn(begin, end) over [0, count) split in chunks of 'grain' items.
+    // Blocks until all chunks are done; the calling thread takes part in the work.
+    void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn);
+
+    unsigned GetWorkerCount() const { return static_cast<unsigned>(m_workers.size()); }
+    size_t GetPendingJobCount() const;
+
+    // True when called from one of the pool threads
+    static bool IsWorkerThread();
+
+private:
+    void WorkerLoop();
+    bool PopJob(Job& outJob); // expects m_mutex locked
+
+    std::vector<std::thread> m_workers;
+    std::array<std::deque<Job>, static_cast<size_t>(JobPriority::Count)> m_queues;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::atomic<bool> m_running{ false };
+};
@@ -22,6 +22,10 @@ void JoystickManager::Initialize()
     // Enable joystick events so SDL will post them to the event queue
     SDL_SetJoystickEventsEnabled(true);
 
+    // noisy sticks post axis motions continuously: only the latest value per axis and frame
+    EM::Get().SetCoalescing(EventType::Olympe_EventType_Joystick_AxisMotion, CoalesceMode::Latest);
+    EventChannel<JoystickAxisEvent>::Get().SetCoalescing(&JoystickAxisEvent::CoalesceKey, &JoystickAxisEvent::Coalesce);
+
     Scan_Joysticks();
 	SYSTEM_LOG << "JoystickManager created and Initialized with " << m_joysticks.size() << " joysticks connected\n";
 }
@@ -252,6 +256,12 @@ void JoystickManager::PostJoystickButtonEvent(SDL_JoystickID which, int button,
     msg.param1 = down ?1.0f :0.0f;
 
     EventManager::Get().AddMessage(msg);
+
+    JoystickButtonEvent ev;
+    ev.deviceId = msg.deviceId;
+    ev.button = button;
+    ev.down = down;
+    EventChannel<JoystickButtonEvent>::Get().Post(ev);
 }
 //---------------------------------------------------------------------------------------------
 void JoystickManager::PostJoystickAxisEvent(SDL_JoystickID which, int axis, Sint16 value)
@@ -270,6 +280,12 @@ void JoystickManager::PostJoystickAxisEvent(SDL_JoystickID which, int axis, Sint
     msg.param1 = normalized;
 
     EventManager::Get().AddMessage(msg);
+
+    JoystickAxisEvent ev;
+    ev.deviceId = msg.deviceId;
+    ev.axis = axis;
+    ev.value = normalized;
+    EventChannel<JoystickAxisEvent>::Get().Post(ev);
 }
 //---------------------------------------------------------------------------------------------
 void JoystickManager::PostJoystickConnectedEvent(SDL_JoystickID which, bool bconnected)
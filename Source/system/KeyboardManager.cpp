@@ -46,4 +46,10 @@ void KeyboardManager::PostKeyEvent(SDL_KeyboardEvent const& ke)
     msg.param1 = 0.0f;
 
     EventManager::Get().AddMessage(msg);
+
+    KeyboardEvent ev;
+    ev.deviceId = msg.deviceId;
+    ev.scancode = ke.scancode;
+    ev.down = ke.down;
+    EventChannel<KeyboardEvent>::Get().Post(ev);
 }
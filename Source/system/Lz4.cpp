@@ -0,0 +1,180 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- Implementation of the LZ4 block codec.
+
+Notes:
+- Block format: sequences of [token][literal length+][literals][offset16][match length+]
+  token = literal length (high nibble) | match length - 4 (low nibble), 15 meaning
+  "more bytes follow" (255 while the length continues). The last sequence only
+  has literals; the last 5 bytes are always literals and the last match starts
+  at least 12 bytes before the end (format rules).
+*/
+
+#include "Lz4.h"
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    const size_t k_MIN_MATCH = 4;
+    const size_t k_LAST_LITERALS = 5;
+    const size_t k_MF_LIMIT = 12;
+    const size_t k_MAX_OFFSET = 65535;
+    const int k_HASH_BITS = 16;
+
+    inline uint32_t Read32(const uint8_t* p)
+    {
+        uint32_t v;
+        std::memcpy(&v, p, 4);
+        return v;
+    }
+
+    inline uint32_t Hash4(uint32_t seq)
+    {
+        return (seq * 2654435761u) >> (32 - k_HASH_BITS);
+    }
+
+    // 15 in the token nibble, then 255 per full byte and the remainder
+    inline uint8_t* WriteLength(uint8_t* op, size_t len)
+    {
+        len -= 15;
+        while (len >= 255) { *op++ = 255; len -= 255; }
+        *op++ = static_cast<uint8_t>(len);
+        return op;
+    }
+
+    inline bool ReadLength(const uint8_t*& ip, const uint8_t* iend, size_t& len)
+    {
+        uint8_t b;
+        do
+        {
+            if (ip >= iend) return false;
+            b = *ip++;
+            len += b;
+        } while (b == 255);
+        return true;
+    }
+}
+
+namespace Lz4
+{
+    //-------------------------------------------------------------
+    size_t Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity)
+    {
+        uint8_t* op = dst;
+        uint8_t* const oend = dst + dstCapacity;
+        size_t anchor = 0;
+
+        if (srcSize > k_MF_LIMIT)
+        {
+            // positions + 1 (0 = empty)
+            std::vector<uint32_t> table(static_cast<size_t>(1) << k_HASH_BITS, 0);
+            const size_t matchLimit = srcSize - k_LAST_LITERALS;
+            const size_t ilimit = srcSize - k_MF_LIMIT;
+            size_t ip = 0;
+
+            while (ip <= ilimit)
+            {
+                const uint32_t seq = Read32(src + ip);
+                const uint32_t h = Hash4(seq);
+                const size_t ref = table[h];
+                table[h] = static_cast<uint32_t>(ip + 1);
+                if (ref == 0 || ip - (ref - 1) > k_MAX_OFFSET || Read32(src + ref - 1) != seq)
+                {
+                    ++ip;
+                    continue;
+                }
+
+                size_t match = ref - 1;
+                // extend backwards over the pending literals, then forwards
+                while (ip > anchor && match > 0 && src[ip - 1] == src[match - 1]) { --ip; --match; }
+                size_t len = k_MIN_MATCH;
+                while (ip + len < matchLimit && src[match + len] == src[ip + len]) ++len;
+
+                const size_t litLen = ip - anchor;
+                const size_t need = 1 + (litLen >= 15 ? 1 + (litLen - 15) / 255 : 0) + litLen + 2
+                    + (len - k_MIN_MATCH >= 15 ? 1 + (len - k_MIN_MATCH - 15) / 255 : 0);
+                if (static_cast<size_t>(oend - op) < need) return 0;
+
+                uint8_t* token = op++;
+                *token = static_cast<uint8_t>((litLen >= 15 ? 15 : litLen) << 4);
+                if (litLen >= 15) op = WriteLength(op, litLen);
+                std::memcpy(op, src + anchor, litLen);
+                op += litLen;
+
+                const size_t offset = ip - match;
+                *op++ = static_cast<uint8_t>(offset & 0xFF);
+                *op++ = static_cast<uint8_t>(offset >> 8);
+
+                const size_t ml = len - k_MIN_MATCH;
+                *token |= static_cast<uint8_t>(ml >= 15 ? 15 : ml);
+                if (ml >= 15) op = WriteLength(op, ml);
+
+                ip += len;
+                anchor = ip;
+                // keep the table warm inside the match (better ratio on repetitive data)
+                if (ip - 2 <= ilimit) table[Hash4(Read32(src + ip - 2))] = static_cast<uint32_t>(ip - 2 + 1);
+            }
+        }
+
+        // last literals
+        const size_t litLen = srcSize - anchor;
+        const size_t need = 1 + (litLen >= 15 ? 1 + (litLen - 15) / 255 : 0) + litLen;
+        if (static_cast<size_t>(oend - op) < need) return 0;
+        *op++ = static_cast<uint8_t>((litLen >= 15 ? 15 : litLen) << 4);
+        if (litLen >= 15) op = WriteLength(op, litLen);
+        std::memcpy(op, src + anchor, litLen);
+        op += litLen;
+
+        return static_cast<size_t>(op - dst);
+    }
+    //-------------------------------------------------------------
+    bool Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+    {
+        const uint8_t* ip = src;
+        const uint8_t* const iend = src + srcSize;
+        uint8_t* op = dst;
+        uint8_t* const oend = dst + dstSize;
+
+        while (ip < iend)
+        {
+            const uint8_t token = *ip++;
+
+            size_t litLen = token >> 4;
+            if (litLen == 15 && !ReadLength(ip, iend, litLen)) return false;
+            if (static_cast<size_t>(iend - ip) < litLen || static_cast<size_t>(oend - op) < litLen) return false;
+            std::memcpy(op, ip, litLen);
+            op += litLen;
+            ip += litLen;
+            if (ip == iend) break; // last sequence: literals only
+
+            if (iend - ip < 2) return false;
+            const size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+            ip += 2;
+            if (offset == 0 || offset > static_cast<size_t>(op - dst)) return false;
+
+            size_t len = token & 15;
+            if (len == 15 && !ReadLength(ip, iend, len)) return false;
+            len += k_MIN_MATCH;
+            if (static_cast<size_t>(oend - op) < len) return false;
+
+            const uint8_t* match = op - offset;
+            if (offset >= len)
+            {
+                std::memcpy(op, match, len);
+                op += len;
+            }
+            else
+            {
+                // overlapping copy repeats the last 'offset' bytes
+                for (size_t i = 0; i < len; ++i) op[i] = match[i];
+                op += len;
+            }
+        }
+        return op == oend;
+    }
+}
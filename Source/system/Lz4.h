@@ -0,0 +1,34 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- Minimal LZ4 block codec (raw block format, no frame header) used by the
+  asset archives: fast decompression at load time, compression done
+  offline by the asset tool.
+
+Notes:
+- Output is compatible with the reference LZ4 block format (LZ4_decompress_safe
+  reads it, and Decompress reads blocks produced by the reference compressor).
+- The compressor is a simple greedy matcher (one 4-byte hash table, no
+  chains): ratio is close to LZ4 default level, speed is not critical here.
+- Decompress validates every length and offset: a corrupted block fails
+  instead of reading or writing out of bounds.
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Lz4
+{
+    // Worst case compressed size (incompressible data)
+    inline size_t CompressBound(size_t srcSize) { return srcSize + srcSize / 255 + 16; }
+
+    // Returns the compressed size, 0 if the result doesn't fit in dstCapacity
+    size_t Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity);
+
+    // Decompress a block of exactly dstSize bytes. Returns false on malformed data.
+    bool Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+}
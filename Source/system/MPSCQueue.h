@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// MPSCQueue: bounded lock-free queue, many producer threads, one consumer thread.
+// Inline (header-only) implementation placed in Source/system.
+//
+// Ring of cells stamped with a sequence number (Dmitry Vyukov's bounded queue):
+// a producer claims a slot with one compare-exchange on the enqueue position,
+// writes the value and publishes it by advancing the cell sequence. The consumer
+// reads the cell once its sequence says it is published. No lock, no allocation
+// after construction; TryPush() fails when the queue is full (the caller decides
+// what to do: EventManager keeps a locked overflow list).
+
+template<typename T>
+class MPSCQueue
+{
+public:
+    // capacity is rounded up to a power of two
+    explicit MPSCQueue(size_t capacity)
+    {
+        size_t n = 2;
+        while (n < capacity) n <<= 1;
+        m_mask = n - 1;
+        m_cells.reset(new Cell[n]);
+        for (size_t i = 0; i < n; ++i) m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    size_t GetCapacity() const { return m_mask + 1; }
+
+    // Positions: pushes claimed so far (any thread) / values popped so far (consumer thread).
+    // The consumer can wait for the pushes claimed before a point in time with
+    // "while (GetPopCount() < claimed) if (!TryPop(v)) yield".
+    size_t GetPushCount() const { return m_enqueuePos.load(std::memory_order_acquire); }
+    size_t GetPopCount() const { return m_dequeuePos; }
+
+    // Any thread. False if the queue is full.
+    template<typename U>
+    bool TryPush(U&& value)
+    {
+        Cell* cell;
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell = &m_cells[pos & m_mask];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                // free cell for this lap: claim it
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if (diff < 0)
+            {
+                return false; // not consumed yet since the previous lap: full
+            }
+            else
+            {
+                pos = m_enqueuePos.load(std::memory_order_relaxed); // claimed by another producer
+            }
+        }
+        cell->value = std::forward<U>(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only. False if empty (or the next value is claimed but not written yet).
+    bool TryPop(T& out)
+    {
+        Cell& cell = m_cells[m_dequeuePos & m_mask];
+        const size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(m_dequeuePos + 1) < 0) return false;
+        out = std::move(cell.value);
+        cell.sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release); // free for the next lap
+        ++m_dequeuePos;
+        return true;
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask = 0;
+    // producers and consumer positions on separate cache lines
+    alignas(64) std::atomic<size_t> m_enqueuePos{ 0 };
+    alignas(64) size_t m_dequeuePos = 0;
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "message.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+
+// MessageArena: per-frame storage of the message payloads (see MessagePayload).
+// Inline (header-only) implementation placed in Source/system.
+//
+// Two bump buffers: producers (any thread) allocate in the current one with one
+// fetch_add, EventManager::Process() swaps them, waits for the writers still
+// allocating in the previous buffer, dispatches its messages and resets it. No lock,
+// no allocation after construction, no per-message free.
+//
+// Producers bracket the allocation and the push of the message between BeginWrite()
+// and EndWrite(): once Swap() has returned, every message referencing the previous
+// buffer is in the queue.
+// Entry layout: [uint32 size][bytes]['\0'], 4 bytes aligned.
+// Handle: bit 31 = buffer, bits 0-30 = entry offset + 1 (0 is "no payload").
+
+class MessageArena
+{
+public:
+    static const uint32_t k_BUFFER_SIZE = 64 * 1024; // bytes per buffer (one frame of payloads)
+
+    MessageArena()
+    {
+        for (Buffer& b : m_buffers) b.data.reset(new char[k_BUFFER_SIZE]);
+    }
+
+    MessageArena(const MessageArena&) = delete;
+    MessageArena& operator=(const MessageArena&) = delete;
+
+    // Any thread. Returns the buffer to allocate in, EndWrite() it once the message is queued.
+    uint32_t BeginWrite()
+    {
+        for (;;)
+        {
+            // seq_cst: pairs with the store of Swap() (store then load on both sides)
+            const uint32_t buffer = m_current.load();
+            m_buffers[buffer].writers.fetch_add(1);
+            if (m_current.load() == buffer) return buffer;
+            m_buffers[buffer].writers.fetch_sub(1, std::memory_order_release); // swapped meanwhile
+        }
+    }
+    void EndWrite(uint32_t buffer)
+    {
+        m_buffers[buffer].writers.fetch_sub(1, std::memory_order_release);
+    }
+
+    // Between BeginWrite() and EndWrite(). Invalid payload if the buffer is full.
+    MessagePayload Allocate(uint32_t buffer, const void* data, size_t size)
+    {
+        MessagePayload payload;
+        Buffer& b = m_buffers[buffer];
+        if (size > k_BUFFER_SIZE || b.used.load(std::memory_order_relaxed) >= k_BUFFER_SIZE) return payload;
+        const uint32_t needed = (static_cast<uint32_t>(sizeof(uint32_t) + size + 1) + 3u) & ~3u;
+        const uint32_t offset = b.used.fetch_add(needed, std::memory_order_relaxed);
+        if (offset + needed > k_BUFFER_SIZE) return payload; // 'used' stays past the end until Reset()
+
+        char* entry = b.data.get() + offset;
+        const uint32_t size32 = static_cast<uint32_t>(size);
+        std::memcpy(entry, &size32, sizeof(size32));
+        if (size) std::memcpy(entry + sizeof(uint32_t), data, size);
+        entry[sizeof(uint32_t) + size] = '\0';
+        payload.handle = (buffer << 31) | (offset + 1);
+        return payload;
+    }
+
+    // nullptr (and 0) for an invalid payload. The data is '\0' terminated.
+    const char* GetData(MessagePayload payload, size_t& outSize) const
+    {
+        outSize = 0;
+        if (!payload.IsValid()) return nullptr;
+        const char* entry = m_buffers[payload.handle >> 31].data.get() + ((payload.handle & 0x7FFFFFFFu) - 1);
+        uint32_t size32;
+        std::memcpy(&size32, entry, sizeof(size32));
+        outSize = size32;
+        return entry + sizeof(uint32_t);
+    }
+
+    // Buffer holding a valid payload
+    static uint32_t GetBuffer(MessagePayload payload) { return payload.handle >> 31; }
+
+    // Consumer thread. New allocations go to the other buffer; returns the previous one
+    // once no producer is writing in it anymore.
+    uint32_t Swap()
+    {
+        const uint32_t previous = m_current.load(std::memory_order_relaxed);
+        m_current.store(previous ^ 1u);
+        while (m_buffers[previous].writers.load() != 0) std::this_thread::yield();
+        return previous;
+    }
+
+    // Consumer thread, once the messages of the buffer are dispatched
+    void Reset(uint32_t buffer)
+    {
+        m_buffers[buffer].used.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    struct Buffer
+    {
+        std::unique_ptr<char[]> data;
+        alignas(64) std::atomic<uint32_t> used{ 0 };
+        std::atomic<uint32_t> writers{ 0 }; // between BeginWrite() and EndWrite()
+    };
+
+    Buffer m_buffers[2];
+    alignas(64) std::atomic<uint32_t> m_current{ 0 };
+};
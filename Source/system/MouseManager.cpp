@@ -11,6 +11,10 @@ MouseManager& MouseManager::GetInstance()
 void MouseManager::Initialize()
 {
 	name = "MouseManager";
+    // a 1000 Hz mouse posts many motions per frame: keep the latest position (the button
+    // events carry their own position), sum the relative motion of the typed events
+    EventManager::Get().SetCoalescing(EventType::Olympe_EventType_Mouse_Motion, CoalesceMode::Latest);
+    EventChannel<MouseMotionEvent>::Get().SetCoalescing(&MouseMotionEvent::CoalesceKey, &MouseMotionEvent::Coalesce);
     SYSTEM_LOG << "MouseManager Initialized\n";
 }
 
@@ -49,6 +53,14 @@ void MouseManager::PostButtonEvent(const SDL_MouseButtonEvent& be)
     msg.param2 = be.y;
 
     EventManager::Get().AddMessage(msg);
+
+    MouseButtonEvent ev;
+    ev.deviceId = msg.deviceId;
+    ev.button = msg.controlId;
+    ev.down = be.down;
+    ev.x = be.x;
+    ev.y = be.y;
+    EventChannel<MouseButtonEvent>::Get().Post(ev);
 }
 
 void MouseManager::PostMotionEvent(const SDL_MouseMotionEvent& me)
@@ -63,4 +75,12 @@ void MouseManager::PostMotionEvent(const SDL_MouseMotionEvent& me)
     msg.param2 = me.y;
 
     EventManager::Get().AddMessage(msg);
+
+    MouseMotionEvent ev;
+    ev.deviceId = msg.deviceId;
+    ev.x = me.x;
+    ev.y = me.y;
+    ev.dx = me.xrel;
+    ev.dy = me.yrel;
+    EventChannel<MouseMotionEvent>::Get().Post(ev);
 }
@@ -0,0 +1,252 @@
+#include "StartupOrchestrator.h"
+#include "JobSystem.h"
+#include "system_utils.h"
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include <fstream>
+
+//-------------------------------------------------------------
+StartupOrchestrator::StartupOrchestrator()
+    : m_start(std::chrono::steady_clock::now())
+{
+    name = "StartupOrchestrator";
+#if defined(_DEBUG)
+    m_tracePath = k_DEFAULT_TRACE_PATH;
+#endif
+    SYSTEM_LOG << "StartupOrchestrator created\n";
+}
+//-------------------------------------------------------------
+StartupOrchestrator::~StartupOrchestrator()
+{
+    SYSTEM_LOG << "StartupOrchestrator destroyed\n";
+}
+//-------------------------------------------------------------
+StartupOrchestrator& StartupOrchestrator::GetInstance()
+{
+    static StartupOrchestrator instance;
+    return instance;
+}
+//-------------------------------------------------------------
+double StartupOrchestrator::GetElapsedMs() const
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+}
+//-------------------------------------------------------------
+bool StartupOrchestrator::AddTask(const std::string& taskName, StartupThread thread, const std::vector<std::string>& dependencies, TaskFunction fn)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Task task;
+    task.name = taskName;
+    task.thread = thread;
+    task.fn = std::move(fn);
+    for (const std::string& dep : dependencies)
+    {
+        auto it = std::find_if(m_tasks.begin(), m_tasks.end(), [&dep](const Task& t) { return t.name == dep; });
+        if (it == m_tasks.end())
+        {
+            SYSTEM_LOG << "StartupOrchestrator: task '" << taskName << "' depends on unknown task '" << dep << "'\n";
+            return false;
+        }
+        task.dependencies.push_back(static_cast<size_t>(it - m_tasks.begin()));
+    }
+    task.remaining = task.dependencies.size();
+    const size_t index = m_tasks.size();
+    for (size_t dep : task.dependencies) m_tasks[dep].dependents.push_back(index);
+    m_tasks.push_back(std::move(task));
+    return true;
+}
+//-------------------------------------------------------------
+bool StartupOrchestrator::Run()
+{
+    if (m_tasks.empty()) return true;
+    JobSystem::Get().Initialize();
+    const double runStart = GetElapsedMs();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_mainThread = std::this_thread::get_id();
+    for (size_t i = 0; i < m_tasks.size(); ++i)
+    {
+        if (m_tasks[i].remaining == 0) Release(i);
+    }
+
+    // the calling thread runs the Main tasks and waits for the workers in between
+    while (m_finished < m_tasks.size())
+    {
+        if (m_mainQueue.empty())
+        {
+            m_cv.wait(lock);
+            continue;
+        }
+        const size_t index = m_mainQueue.front();
+        m_mainQueue.pop_front();
+        lock.unlock();
+        Execute(index);
+        lock.lock();
+    }
+    m_runMs = GetElapsedMs() - runStart;
+    const bool success = std::all_of(m_tasks.begin(), m_tasks.end(), [](const Task& t) { return t.state == TaskState::Done; });
+    lock.unlock();
+
+    LogTrace();
+    return success;
+}
+//-------------------------------------------------------------
+void StartupOrchestrator::Release(size_t index)
+{
+    if (m_tasks[index].thread == StartupThread::Worker)
+    {
+        JobSystem::Get().Submit([this, index]() { Execute(index); }, JobPriority::High);
+        return;
+    }
+    // declaration order among the ready Main tasks
+    m_mainQueue.insert(std::upper_bound(m_mainQueue.begin(), m_mainQueue.end(), index), index);
+}
+//-------------------------------------------------------------
+void StartupOrchestrator::Execute(size_t index)
+{
+    Task* task;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        task = &m_tasks[index]; // the vector doesn't change while running
+        task->state = TaskState::Running;
+        task->threadIndex = GetThreadIndex();
+        task->startMs = GetElapsedMs();
+    }
+
+    bool success = false;
+    try
+    {
+        success = task->fn ? task->fn() : true;
+    }
+    catch (const std::exception& e)
+    {
+        SYSTEM_LOG << "StartupOrchestrator: task '" << task->name << "' threw: " << e.what() << "\n";
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        task->endMs = GetElapsedMs();
+        Complete(index, success);
+    }
+    m_cv.notify_all();
+}
+//-------------------------------------------------------------
+void StartupOrchestrator::Complete(size_t index, bool success)
+{
+    Task& task = m_tasks[index];
+    if (task.state == TaskState::Running) task.state = success ? TaskState::Done : TaskState::Failed;
+    else task.state = TaskState::Skipped;
+    ++m_finished;
+
+    if (task.state == TaskState::Failed) SYSTEM_LOG << "StartupOrchestrator: task '" << task.name << "' failed\n";
+    if (task.state == TaskState::Skipped) SYSTEM_LOG << "StartupOrchestrator: task '" << task.name << "' skipped\n";
+
+    for (size_t dep : task.dependents)
+    {
+        Task& d = m_tasks[dep];
+        if (d.state != TaskState::Pending) continue; // already skipped by another failed dependency
+        if (task.state != TaskState::Done) Complete(dep, false); // skipped, and its own dependents
+        else if (--d.remaining == 0) Release(dep);
+    }
+}
+//-------------------------------------------------------------
+int StartupOrchestrator::GetThreadIndex()
+{
+    const std::thread::id id = std::this_thread::get_id();
+    if (id == m_mainThread) return 0;
+    auto it = std::find(m_threads.begin(), m_threads.end(), id);
+    if (it != m_threads.end()) return static_cast<int>(it - m_threads.begin()) + 1;
+    m_threads.push_back(id);
+    return static_cast<int>(m_threads.size());
+}
+//-------------------------------------------------------------
+std::vector<size_t> StartupOrchestrator::GetCriticalPath() const
+{
+    // from the last task to end, follow the dependency that finished last
+    std::vector<size_t> path;
+    size_t current = m_tasks.size();
+    for (size_t i = 0; i < m_tasks.size(); ++i)
+    {
+        if (m_tasks[i].state != TaskState::Done) continue;
+        if (current == m_tasks.size() || m_tasks[i].endMs > m_tasks[current].endMs) current = i;
+    }
+    while (current < m_tasks.size())
+    {
+        path.push_back(current);
+        size_t next = m_tasks.size();
+        for (size_t dep : m_tasks[current].dependencies)
+        {
+            if (next == m_tasks.size() || m_tasks[dep].endMs > m_tasks[next].endMs) next = dep;
+        }
+        current = next;
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+//-------------------------------------------------------------
+void StartupOrchestrator::LogTrace() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    oss << "Startup: " << m_tasks.size() << " tasks in " << m_runMs << " ms (" << m_threads.size() << " worker threads used)\n";
+    for (const Task& t : m_tasks)
+    {
+        oss << "  " << std::left << std::setw(20) << t.name;
+        if (t.state == TaskState::Skipped)
+        {
+            oss << "skipped\n";
+            continue;
+        }
+        const std::string thread = (t.threadIndex == 0) ? "main" : "worker " + std::to_string(t.threadIndex);
+        oss << std::setw(10) << thread << std::right << std::setw(8) << t.startMs << " -> " << std::setw(8) << t.endMs
+            << " ms  (" << (t.endMs - t.startMs) << " ms)" << (t.state == TaskState::Failed ? " FAILED" : "") << "\n";
+    }
+    const std::vector<size_t> path = GetCriticalPath();
+    oss << "Startup critical path:";
+    for (size_t i = 0; i < path.size(); ++i) oss << (i ? " > " : " ") << m_tasks[path[i]].name;
+    oss << "\n";
+    SYSTEM_LOG << oss.str();
+}
+//-------------------------------------------------------------
+bool StartupOrchestrator::WriteTrace(const std::string& path) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::ofstream out(path.c_str(), std::ios::trunc);
+    if (!out) return false;
+
+    // Chrome trace event format: complete events ("X") in microseconds
+    out << std::fixed << std::setprecision(0) << "{\"traceEvents\":[\n";
+    out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"main\"}}";
+    for (size_t i = 0; i < m_threads.size(); ++i)
+    {
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << (i + 1) << ",\"args\":{\"name\":\"worker " << (i + 1) << "\"}}";
+    }
+    for (const Task& t : m_tasks)
+    {
+        if (t.state == TaskState::Skipped) continue;
+        out << ",\n{\"name\":\"" << escape_json_string(t.name) << "\",\"cat\":\"startup\",\"ph\":\"X\",\"pid\":1,\"tid\":" << t.threadIndex
+            << ",\"ts\":" << t.startMs * 1000.0 << ",\"dur\":" << (t.endMs - t.startMs) * 1000.0 << "}";
+    }
+    if (m_firstFrameMs >= 0.0)
+    {
+        out << ",\n{\"name\":\"first_frame\",\"cat\":\"startup\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":" << m_firstFrameMs * 1000.0 << "}";
+    }
+    out << "\n]}\n";
+    return out.good();
+}
+//-------------------------------------------------------------
+void StartupOrchestrator::MarkFirstFrame()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_firstFrameMs >= 0.0) return;
+        m_firstFrameMs = GetElapsedMs();
+    }
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1) << "Startup: first frame presented after " << m_firstFrameMs << " ms";
+    if (m_firstFrameMs > k_FIRST_FRAME_TARGET_MS) oss << " (over the " << k_FIRST_FRAME_TARGET_MS << " ms target)";
+    SYSTEM_LOG << oss.str() << "\n";
+    if (!m_tracePath.empty() && WriteTrace(m_tracePath)) SYSTEM_LOG << "Startup: trace saved in '" << m_tracePath << "'\n";
+}
@@ -0,0 +1,112 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- StartupOrchestrator is a singleton running the engine initialization as a
+  graph of named tasks with dependencies (SDL_AppInit declares them). Tasks
+  whose dependencies are done run in parallel: Worker tasks on the
+  JobSystem threads, Main tasks on the thread calling Run() (SDL video,
+  window, Win32 panels and everything touching the renderer must stay on
+  the main thread).
+- Every task is timed: LogTrace() prints the per-task timings and the
+  critical path, WriteTrace() saves them in the Chrome trace format
+  (chrome://tracing, Perfetto). MarkFirstFrame() measures the time to first
+  frame, from the creation of the orchestrator (first line of SDL_AppInit).
+- The trace file is only written in debug builds, or when the engine is
+  started with "--startup-trace" (SetTracePath). LogTrace() always runs.
+
+Notes:
+- A task can only depend on tasks declared before it: the graph has no
+  cycle by construction. Dependencies are names, an unknown name is an
+  error reported by AddTask().
+- A task returning false fails the startup: the tasks depending on it are
+  skipped, the others still run, Run() returns false.
+- Main tasks run in declaration order among the ready ones: declare the
+  long main thread tasks early so that the workers get their work first.
+*/
+#pragma once
+
+#include "../object.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <thread>
+
+enum class StartupThread
+{
+    Main = 0, // thread calling Run()
+    Worker    // JobSystem worker
+};
+
+class StartupOrchestrator : public Object
+{
+public:
+    using TaskFunction = std::function<bool()>;
+
+    StartupOrchestrator();
+    virtual ~StartupOrchestrator();
+
+    virtual ObjectType GetObjectType() const override { return ObjectType::Singleton; }
+
+    static StartupOrchestrator& GetInstance();
+    static StartupOrchestrator& Get() { return GetInstance(); }
+
+    bool AddTask(const std::string& taskName, StartupThread thread, const std::vector<std::string>& dependencies, TaskFunction fn);
+    // Runs all the declared tasks and returns once they are done. False if a task failed.
+    bool Run();
+
+    // Once, after the first SDL_RenderPresent: logs the time to first frame and writes the trace
+    // to the trace path if there is one
+    void MarkFirstFrame();
+    // File written by MarkFirstFrame(), empty for none (default: "startup_trace.json" in debug builds only)
+    void SetTracePath(const std::string& path) { m_tracePath = path; }
+    double GetElapsedMs() const; // since the orchestrator creation
+
+    void LogTrace() const;
+    bool WriteTrace(const std::string& path) const;
+
+    static constexpr const char* k_DEFAULT_TRACE_PATH = "startup_trace.json";
+    // time to first frame above which MarkFirstFrame() warns
+    static const int k_FIRST_FRAME_TARGET_MS = 1000;
+
+private:
+    enum class TaskState { Pending, Running, Done, Failed, Skipped };
+
+    struct Task
+    {
+        std::string name;
+        StartupThread thread = StartupThread::Main;
+        TaskFunction fn;
+        std::vector<size_t> dependencies;
+        std::vector<size_t> dependents;
+        size_t remaining = 0; // dependencies not done yet
+        TaskState state = TaskState::Pending;
+        double startMs = 0.0;
+        double endMs = 0.0;
+        int threadIndex = 0; // 0 = main, workers numbered from 1 in order of appearance
+    };
+
+    void Execute(size_t index);                      // runs the task and completes it
+    void Release(size_t index);                      // dependencies done: queue it (expects m_mutex locked)
+    void Complete(size_t index, bool success);       // expects m_mutex locked
+    int GetThreadIndex();                            // expects m_mutex locked
+    std::vector<size_t> GetCriticalPath() const;
+
+    std::vector<Task> m_tasks;
+    std::deque<size_t> m_mainQueue; // ready Main tasks
+    size_t m_finished = 0;          // done, failed or skipped
+    std::thread::id m_mainThread;
+    std::vector<std::thread::id> m_threads; // workers seen, index + 1 = threadIndex
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::chrono::steady_clock::time_point m_start;
+    double m_runMs = 0.0;
+    double m_firstFrameMs = -1.0;
+    std::string m_tracePath;
+};
@@ -0,0 +1,111 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- Implementation of StringInterner (chunked entry storage, open addressing
+  lookup table).
+*/
+
+#include "Symbol.h"
+#include "system_utils.h"
+#include <cstring>
+
+//-------------------------------------------------------------
+StringInterner::StringInterner()
+{
+    for (auto& c : m_chunks) c.store(nullptr, std::memory_order_relaxed);
+
+    // id 0: empty string
+    Entry* first = new Entry[k_CHUNK_SIZE];
+    first[0].hash = OlympeHashFNV1a("", 0);
+    m_chunks[0].store(first, std::memory_order_release);
+    m_count.store(1, std::memory_order_release);
+    m_table.assign(1024, 0);
+}
+//-------------------------------------------------------------
+StringInterner::~StringInterner()
+{
+    for (auto& c : m_chunks) delete[] c.load(std::memory_order_relaxed);
+}
+//-------------------------------------------------------------
+StringInterner& StringInterner::GetInstance()
+{
+    // intentionally leaked: see notes in Symbol.h
+    static StringInterner* instance = new StringInterner();
+    return *instance;
+}
+//-------------------------------------------------------------
+void StringInterner::GrowTable()
+{
+    std::vector<uint32_t> table(m_table.size() * 2, 0);
+    const size_t mask = table.size() - 1;
+    for (uint32_t id : m_table)
+    {
+        if (id == 0) continue;
+        size_t i = Lookup(id).hash & mask;
+        while (table[i] != 0) i = (i + 1) & mask;
+        table[i] = id;
+    }
+    m_table.swap(table);
+}
+//-------------------------------------------------------------
+size_t StringInterner::FindSlot(const char* s, size_t len, uint32_t hash) const
+{
+    const size_t mask = m_table.size() - 1;
+    size_t i = hash & mask;
+    while (m_table[i] != 0)
+    {
+        const Entry& e = Lookup(m_table[i]);
+        if (e.hash == hash && e.text.size() == len && std::memcmp(e.text.data(), s, len) == 0) return i;
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+//-------------------------------------------------------------
+uint32_t StringInterner::Find(const char* s, size_t len, uint32_t hash) const
+{
+    if (len == 0) return 0;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const uint32_t id = m_table[FindSlot(s, len, hash)];
+    return (id != 0) ? id : Symbol::k_INVALID_ID;
+}
+//-------------------------------------------------------------
+uint32_t StringInterner::Intern(const char* s, size_t len, uint32_t hash)
+{
+    if (len == 0) return 0;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const size_t i = FindSlot(s, len, hash);
+    if (m_table[i] != 0) return m_table[i];
+
+    // new symbol: fill the entry before publishing the count
+    const uint32_t id = m_count.load(std::memory_order_relaxed);
+    const uint32_t chunk = id >> k_CHUNK_BITS;
+    if (chunk >= k_MAX_CHUNKS)
+    {
+        // table full: the invalid symbol never matches, unlike the empty one all the failures would share
+        const bool log = !m_fullLogged;
+        m_fullLogged = true;
+        lock.unlock();
+        if (log) SYSTEM_LOG << "StringInterner: table full (" << id << " symbols), '" << std::string(s, len) << "' and the next new names are invalid symbols\n";
+        return Symbol::k_INVALID_ID;
+    }
+    Entry* entries = m_chunks[chunk].load(std::memory_order_relaxed);
+    if (!entries)
+    {
+        entries = new Entry[k_CHUNK_SIZE];
+        m_chunks[chunk].store(entries, std::memory_order_release);
+    }
+    Entry& e = entries[id & (k_CHUNK_SIZE - 1)];
+    e.text.assign(s, len);
+    e.hash = hash;
+    m_count.store(id + 1, std::memory_order_release);
+
+    m_table[i] = id;
+    // keep the load factor under 1/2
+    if (static_cast<size_t>(id + 1) * 2 > m_table.size()) GrowTable();
+    return id;
+}
@@ -0,0 +1,192 @@
+/*
+Olympe Engine V2 2025
+Nicolas Chereau
+nchereau@gmail.com
+
+Purpose:
+- Symbol is an interned string: a 32-bit id into the global StringInterner.
+  Copying, comparing and hashing a Symbol are integer operations; the text
+  is stored once for the whole program and stays valid until exit.
+- Used for names and identifiers (Object::name, Message class / object /
+  component names, ObjectFactory keys, DataManager resource ids, ...).
+- HashedString computes the FNV-1a hash of a literal at compile time
+  ("Player"_hs) so that interning it skips the hashing, and OLYMPE_SYMBOL
+  interns a literal once per call site (function static).
+
+Notes:
+- Symbols convert implicitly from const char* / std::string, so existing
+  assignments (name = "World") keep working; the conversion interns the
+  text (hash + lookup under the interner mutex). Hot paths should keep the
+  Symbol instead of rebuilding it from a string every frame.
+- Interned texts are never removed: lookups by a string that may not be
+  interned (queries, misses) use Symbol::Find(), which doesn't add it.
+- When the interner is full, new texts get the invalid symbol: it compares
+  unequal to every symbol, itself included, so that unrelated names never
+  match (the failure is logged once).
+- StringInterner is not an Object: Object::name is a Symbol, the interner
+  must be usable before (and while) any Object is constructed.
+- Resolving a Symbol to its text (str(), c_str()) is lock-free.
+- The interner is never destroyed, so names stay readable from the
+  destructors of static objects.
+- Symbol ordering (operator<) follows ids, not alphabetical order.
+*/
+#pragma once
+
+#include <string>
+#include <ostream>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+// FNV-1a, usable at compile time (C++14 constexpr)
+constexpr uint32_t OlympeHashFNV1a(const char* s, size_t len)
+{
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; ++i)
+    {
+        h ^= static_cast<uint8_t>(s[i]);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// String literal with its hash computed at compile time
+struct HashedString
+{
+    const char* str;
+    size_t length;
+    uint32_t hash;
+
+    constexpr HashedString(const char* s, size_t len) : str(s), length(len), hash(OlympeHashFNV1a(s, len)) {}
+};
+
+constexpr HashedString operator"" _hs(const char* s, size_t len) { return HashedString(s, len); }
+
+class Symbol
+{
+public:
+    Symbol() = default; // empty string
+    Symbol(const char* s);
+    Symbol(const std::string& s);
+    Symbol(const HashedString& s);
+
+    static const uint32_t k_INVALID_ID = 0xFFFFFFFFu;
+
+    // Symbol of an already interned text, without interning it: invalid if the text is unknown
+    static Symbol Find(const char* s);
+    static Symbol Find(const std::string& s);
+
+    uint32_t GetId() const { return m_id; }
+    bool IsValid() const { return m_id != k_INVALID_ID; }
+    uint32_t GetHash() const;
+    const std::string& str() const;
+    const char* c_str() const { return str().c_str(); }
+    bool empty() const { return m_id == 0; }
+
+    bool operator==(const Symbol& o) const { return m_id == o.m_id && m_id != k_INVALID_ID; }
+    bool operator!=(const Symbol& o) const { return !(*this == o); }
+    bool operator<(const Symbol& o) const { return m_id < o.m_id; }
+
+private:
+    uint32_t m_id = 0;
+};
+
+inline std::ostream& operator<<(std::ostream& os, const Symbol& s) { return os << s.str(); }
+
+namespace std
+{
+    template <> struct hash<Symbol>
+    {
+        size_t operator()(const Symbol& s) const { return s.GetId(); } // ids are unique: perfect hash
+    };
+}
+
+// Interns a string literal once per call site
+#define OLYMPE_SYMBOL(literal) ([]() -> Symbol { static const Symbol s(HashedString(literal, sizeof(literal) - 1)); return s; }())
+
+class StringInterner
+{
+public:
+    static StringInterner& GetInstance();
+    static StringInterner& Get() { return GetInstance(); }
+
+    // Thread-safe: returns the id of the text, adding it on first use (id 0 is the empty string)
+    uint32_t Intern(const char* s, size_t len, uint32_t hash);
+    uint32_t Intern(const char* s, size_t len) { return Intern(s, len, OlympeHashFNV1a(s, len)); }
+    // Thread-safe: id of the text if it is interned, Symbol::k_INVALID_ID otherwise (never adds it)
+    uint32_t Find(const char* s, size_t len, uint32_t hash) const;
+
+    // Lock-free
+    const std::string& GetString(uint32_t id) const { return Lookup(id).text; }
+    uint32_t GetHash(uint32_t id) const { return Lookup(id).hash; }
+
+    size_t GetSymbolCount() const { return m_count.load(std::memory_order_acquire); }
+
+private:
+    StringInterner();
+    ~StringInterner();
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    struct Entry
+    {
+        std::string text;
+        uint32_t hash = 0;
+    };
+    // entries live in fixed size chunks that never move: ids resolve without locking
+    static const uint32_t k_CHUNK_BITS = 12;
+    static const uint32_t k_CHUNK_SIZE = 1u << k_CHUNK_BITS;
+    static const uint32_t k_MAX_CHUNKS = 1024; // 4M symbols
+
+    const Entry& Lookup(uint32_t id) const
+    {
+        if (id == Symbol::k_INVALID_ID) return m_invalid;
+        return m_chunks[id >> k_CHUNK_BITS].load(std::memory_order_acquire)[id & (k_CHUNK_SIZE - 1)];
+    }
+    void GrowTable(); // expects m_mutex locked
+    size_t FindSlot(const char* s, size_t len, uint32_t hash) const; // table slot of the text or of its insertion, expects m_mutex locked
+
+    std::atomic<Entry*> m_chunks[k_MAX_CHUNKS];
+    std::atomic<uint32_t> m_count{ 0 };
+    Entry m_invalid; // text of the invalid symbol (empty)
+    bool m_fullLogged = false;
+
+    // open addressing table of ids (0 = empty slot), protected by m_mutex
+    mutable std::mutex m_mutex;
+    std::vector<uint32_t> m_table;
+};
+
+//-------------------------------------------------------------
+inline Symbol::Symbol(const char* s)
+{
+    if (s && *s) m_id = StringInterner::Get().Intern(s, std::char_traits<char>::length(s));
+}
+inline Symbol::Symbol(const std::string& s)
+{
+    if (!s.empty()) m_id = StringInterner::Get().Intern(s.data(), s.size());
+}
+inline Symbol::Symbol(const HashedString& s)
+{
+    if (s.length) m_id = StringInterner::Get().Intern(s.str, s.length, s.hash);
+}
+inline Symbol Symbol::Find(const char* s)
+{
+    Symbol sym;
+    if (s && *s)
+    {
+        const size_t len = std::char_traits<char>::length(s);
+        sym.m_id = StringInterner::Get().Find(s, len, OlympeHashFNV1a(s, len));
+    }
+    return sym;
+}
+inline Symbol Symbol::Find(const std::string& s)
+{
+    Symbol sym;
+    if (!s.empty()) sym.m_id = StringInterner::Get().Find(s.data(), s.size(), OlympeHashFNV1a(s.data(), s.size()));
+    return sym;
+}
+inline uint32_t Symbol::GetHash() const { return StringInterner::Get().GetHash(m_id); }
+inline const std::string& Symbol::str() const { return StringInterner::Get().GetString(m_id); }
@@ -1,30 +1,50 @@
 #pragma once
 
 #include "system_consts.h"
+#include "Symbol.h"
 #include <string>
 #include <cstdint>
+#include <cstddef>
+#include <type_traits>
 #include "SDL_events.h"
 #include "windows.h"
 
+// Reference to data stored out of line in the EventManager payload arena (strings, blobs).
+// Set by EventManager::AddMessage(msg, payload), read with EventManager::GetPayload() while
+// the message is dispatched: the arena is reset after each EventManager::Process().
+struct MessagePayload
+{
+    uint32_t handle = 0; // 0 = no payload
+    bool IsValid() const { return handle != 0; }
+};
+
 // Message struct in the global namespace. It contains an EventStructType so
 // existing code that uses "msg.type" continues to work. Additional fields
 // are provided for input events (joystick/keyboard/mouse) so message payload
 // can be transported via the EventManager.
+// Trivially copyable and at most 64 bytes: queueing and dispatch copy it as raw memory,
+// variable size data goes to the payload arena.
 struct Message
 {
-	EventStructType struct_type = EventStructType::EventStructType_Olympe;
 	EventType msg_type = EventType::Olympe_EventType_Any; // optional message identifier (e.g. OlympeMessage)
-	MSG *msg = nullptr; // optional Win32 MSG structure
-	SDL_Event* sdlEvent = nullptr; // optional SDL_Event structure
+	EventStructType struct_type = EventStructType::EventStructType_Olympe;
+    int16_t state = 0; // button pressed (1) / released (0) or other integer state (see below)
+
+    // Pointer payload, one of (depending on the message):
+    union
+    {
+        MSG* msg = nullptr; // optional Win32 MSG structure (EventStructType_System_Windows, immediate dispatch only)
+        SDL_Event* sdlEvent; // optional SDL_Event structure (EventStructType_SDL, immediate dispatch only)
+        void* objectParamPtr; // target object pointer for operations (create/destroy/add property)
+    };
 
     // Additional convenience fields for engine-level messages
     void* sender = nullptr; // optional sender pointer
-	void* objectParamPtr = nullptr; // target object pointer for operations (create/destroy/add property)
     uint64_t targetUid = 0; // target object UID for operations (create/destroy/add property)
-    std::string className; // class to create (for object creation)
-    std::string objectName; // desired object name
-    std::string ComponentType; // property type identifier (for property add/remove)
-    std::string propertyParams; // optional params serialized as string
+    Symbol className; // class to create (for object creation)
+    Symbol objectName; // desired object name
+    Symbol ComponentType; // property type identifier (for property add/remove)
+    MessagePayload payload; // optional params serialized as string (EventManager::GetPayloadString)
 
     // Generic integer / float payload fields. For input events these are used as:
     //  - deviceId : joystick instance id, keyboard id, mouse id
@@ -34,7 +54,6 @@ struct Message
     //  - value2   : secondary float payload (e.g. mouse Y coordinate)
     int deviceId = -1;
     int controlId = -1;
-    int state = 0;
     float param1 = 0.0f;
     float param2 = 0.0f;
 
@@ -60,3 +79,26 @@ struct Message
 		return msg;
 	}
 };
+
+static_assert(std::is_trivially_copyable<Message>::value, "Message is copied as raw memory by the EventManager queues");
+static_assert(sizeof(Message) <= 64, "Message must fit in a cache line, store variable size data in the payload arena");
+
+// Read-only view of contiguous messages (std::span<const Message> once the engine moves to C++20).
+// Given to the batch listeners (EventManager::RegisterBatch), valid during the call only.
+class MessageSpan
+{
+public:
+    MessageSpan() = default;
+    MessageSpan(const Message* data, size_t size) : m_data(data), m_size(size) {}
+
+    const Message* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    const Message& operator[](size_t i) const { return m_data[i]; }
+    const Message* begin() const { return m_data; }
+    const Message* end() const { return m_data + m_size; }
+
+private:
+    const Message* m_data = nullptr;
+    size_t m_size = 0;
+};
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 constexpr double k_PI = 3.14159265358979323846;
 
 // Configuration: defaults
@@ -8,7 +10,7 @@ static const int DEFAULT_WINDOW_HEIGHT = 600;
 
 // Event structure types
 // Used to identify the source/type of event messages
-enum class EventStructType
+enum class EventStructType : int8_t
 {
 	EventStructType_Default = -1,
 	EventStructType_System_Windows = 0,
@@ -97,6 +99,9 @@ enum class EventType
 	Olympe_EventType_Game_SaveState, // save game state to slot (param: slot id)
 	Olympe_EventType_Game_LoadState, // load game state from slot (param: slot id)
 
+	// -------- RESOURCE EVENTS ----------
+	Olympe_EventType_Resource_Reloaded, // file changed on disk and reloaded (objectName: resource id, empty for data files; payload: file path)
+
 	// -------- SYSTEM EVENTS ----------
 	Olympe_EventType_System_Any, // Any system event registration
 	
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "system_consts.h"
+#include "EventRouting.h"
+#include <SDL3/SDL_scancode.h>
+#include <cstdint>
+
+// Typed events published on EventChannel<T> (see EventChannel.h).
+// Hot events get their own struct: the listeners receive exactly their data,
+// without switching on Message::msg_type / struct_type.
+// The input managers still post the equivalent Message for the generic listeners.
+// RouteBy...: routing keys for EventChannel<T>::SubscribeRouted() (GetDeviceRouteKey(id) for
+// the routes by device).
+// CoalesceKey / Coalesce: rules given to EventChannel<T>::SetCoalescing() by the managers.
+
+// Olympe_EventType_Keyboard_KeyDown / KeyUp
+struct KeyboardEvent
+{
+    int deviceId = -1; // -1 is keyboard (same id as the Message)
+    SDL_Scancode scancode = SDL_SCANCODE_UNKNOWN;
+    bool down = false;
+
+    static uint64_t RouteByDevice(const KeyboardEvent& ev) { return GetDeviceRouteKey(ev.deviceId); }
+};
+
+// Olympe_EventType_Joystick_ButtonDown / ButtonUp
+struct JoystickButtonEvent
+{
+    int deviceId = -1; // joystick instance id
+    int button = -1;
+    bool down = false;
+
+    static uint64_t RouteByDevice(const JoystickButtonEvent& ev) { return GetDeviceRouteKey(ev.deviceId); }
+};
+
+// Olympe_EventType_Joystick_AxisMotion
+struct JoystickAxisEvent
+{
+    int deviceId = -1; // joystick instance id
+    int axis = -1;
+    float value = 0.0f; // normalized to [-1,1]
+
+    static uint64_t RouteByDevice(const JoystickAxisEvent& ev) { return GetDeviceRouteKey(ev.deviceId); }
+
+    // one event per (stick, axis) and frame: the latest value
+    static uint64_t CoalesceKey(const JoystickAxisEvent& ev) { return (static_cast<uint64_t>(static_cast<uint32_t>(ev.deviceId)) << 32) | static_cast<uint32_t>(ev.axis); }
+    static void Coalesce(JoystickAxisEvent& pending, const JoystickAxisEvent& ev) { pending = ev; }
+};
+
+// Olympe_EventType_Mouse_ButtonDown / ButtonUp
+struct MouseButtonEvent
+{
+    int deviceId = -1;
+    int button = -1;
+    bool down = false;
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+// Olympe_EventType_Mouse_Motion
+struct MouseMotionEvent
+{
+    int deviceId = -1;
+    float x = 0.0f;  // position
+    float y = 0.0f;
+    float dx = 0.0f; // relative motion
+    float dy = 0.0f;
+
+    // one event per mouse and frame: the latest position, the motions summed
+    static uint64_t CoalesceKey(const MouseMotionEvent& ev) { return static_cast<uint32_t>(ev.deviceId); }
+    static void Coalesce(MouseMotionEvent& pending, const MouseMotionEvent& ev)
+    {
+        const float dx = pending.dx + ev.dx;
+        const float dy = pending.dy + ev.dy;
+        pending = ev;
+        pending.dx = dx;
+        pending.dy = dy;
+    }
+};
+
+// Olympe_EventType_Object_CollideEvent, UncollideEvent, CollideNav, UnCollideNav, CollideDeathZone
+struct CollisionEvent
+{
+    EventType type = EventType::Olympe_EventType_Object_CollideEvent;
+    uint64_t uid = 0;      // object colliding
+    uint64_t otherUid = 0; // other object, 0 for the map (navigation, death zone)
+
+    static uint64_t RouteByUid(const CollisionEvent& ev) { return ev.uid; }
+};